@@ -47,6 +47,39 @@ function convertToId(search)
   return result;
 }
 
+// Default data of a results page, replaced when the data file of the page is loaded
+var searchData     = [];
+var searchBaseName = '';
+var searchShards   = null;
+var searchDataName = '';
+
+// Returns the data file of a results page which holds the entries for a search term. The data of
+// large pages is split on the first two characters of the id, an empty string is returned when
+// none of the entries can match the search term.
+function searchDataFile(baseName, shards, search)
+{
+  search = search.replace(/^ +/, "").replace(/ +$/, "").toLowerCase();
+  var prefix = convertToId(search).substr(0, 2);
+  if (!shards || prefix.length < 2 || !prefix.match(/^[a-z0-9_]+$/))
+  {
+    return baseName;
+  }
+  var shard = shards[prefix];
+  return shard === undefined ? '' : baseName + '_' + shard;
+}
+
+// Loads the data file for the search term in the URL, called while the results page is parsed.
+function loadSearchData(baseName, shards)
+{
+  searchBaseName = baseName;
+  searchShards   = shards;
+  searchDataName = searchDataFile(baseName, shards, unescape(window.location.search.substring(1)));
+  if (searchDataName != '')
+  {
+    document.write('<script type="text/javascript" src="' + searchDataName + '.js"><\/script>');
+  }
+}
+
 function getXPos(item)
 {
   var x = 0;
@@ -361,7 +394,27 @@ function SearchBox(name, resultsPath, inFrame, label)
        hasResultsPage = false;
     }
 
-    window.frames.MSearchResults.location = resultsPageWithSearch;
+    // when the results page already holds the data for the new search term only filter the results
+    var resultsFrame = window.frames.MSearchResults;
+    var sameData     = false;
+    try
+    {
+      sameData = hasResultsPage && resultsPage == this.lastResultsPage && resultsFrame.searchResults &&
+                 resultsFrame.searchDataName == searchDataFile(resultsFrame.searchBaseName, resultsFrame.searchShards, searchValue);
+    }
+    catch (e) // the frame can not be accessed for local files in some browsers
+    {
+      sameData = false;
+    }
+
+    if (sameData)
+    {
+      resultsFrame.searchResults.Search(searchValue);
+    }
+    else
+    {
+      resultsFrame.location = resultsPageWithSearch;
+    }
     var domPopupSearchResultsWindow = this.DOMPopupSearchResultsWindow();
 
     if (domPopupSearchResultsWindow.style.display!='block')
@@ -0,0 +1,295 @@
+/************************************************************************
+*
+* Copyright (c) 2014-2025 Barbara Geller & Ansel Sermersheim
+*
+* Copyright (c) 1997-2014 Dimitri van Heesch
+*
+* DoxyPress is free software. You can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* version 2 as published by the Free Software Foundation.
+*
+* DoxyPress is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+*
+* Documents produced by DoxyPress are derivative works derived from the
+* input used in their production; they are not affected by this license.
+*
+* https://www.gnu.org/licenses/
+*
+*************************************************************************/
+
+#include <clangunitpool.h>
+
+#include <config.h>
+#include <util.h>
+
+#include <string.h>
+
+static void freeUnsavedFiles(ClangUnit &unit)
+{
+   for (uint i = 0; i < unit.numFiles; i++) {
+      free((void *)unit.ufs[i].Filename);
+   }
+
+   delete[] unit.ufs;
+   delete[] unit.sources;
+
+   unit.ufs      = nullptr;
+   unit.sources  = nullptr;
+   unit.numFiles = 0;
+}
+
+static void disposeUnit(ClangUnit *unit)
+{
+   if (unit->tu) {
+      delete[] unit->cursors;
+
+      clang_disposeTokens(unit->tu, unit->tokens, unit->numTokens);
+      clang_disposeTranslationUnit(unit->tu);
+   }
+
+   freeUnsavedFiles(*unit);
+   delete unit;
+}
+
+void parseClangUnit(CXIndex index, ClangUnit &unit)
+{
+   static const bool filterSourceFiles = Config::getBool("filter-source-files");
+
+   // provide the input and their dependencies as files in memory
+   unit.numFiles = unit.includeFiles.count() + 1;
+   unit.sources  = new QByteArray[unit.numFiles];
+   unit.ufs      = new CXUnsavedFile[unit.numFiles];
+
+   // load main file
+   if (unit.fileBuffer.isEmpty()) {
+      unit.sources[0] = detab(fileToString(unit.fileName, filterSourceFiles, true)).toUtf8();
+   } else  {
+      unit.sources[0] = unit.fileBuffer.toUtf8();
+   }
+
+   unit.ufs[0].Filename = strdup(unit.fileName.toUtf8().constData());
+   unit.ufs[0].Contents = unit.sources[0].constData();
+   unit.ufs[0].Length   = unit.sources[0].length();
+
+   uint i = 1;
+
+   for (const auto &item : unit.includeFiles) {
+      unit.fileMapping.insert(item, i);
+
+      // load include files
+      unit.sources[i]      = detab(fileToString(item, filterSourceFiles, true)).toUtf8();
+      unit.ufs[i].Filename = strdup(item.toUtf8().constData());
+      unit.ufs[i].Contents = unit.sources[i].constData();
+      unit.ufs[i].Length   = unit.sources[i].length();
+
+      i++;
+   }
+
+   // copy data to a usable vector for clang
+   std::vector<const char *> argv;
+
+   for (auto &item : unit.args) {
+      argv.push_back(item.constData());
+   }
+
+   int argc = unit.args.size();
+
+   // libClang - used to set up the tokens for comments
+   unit.errorCode = clang_parseTranslationUnit2(index, nullptr, &argv[0], argc, unit.ufs, unit.numFiles,
+                  CXTranslationUnit_DetailedPreprocessingRecord, &unit.tu);
+
+   if (unit.tu) {
+      // warnings the compiler found, displayed by the caller
+      uint diagCnt = clang_getNumDiagnostics(unit.tu);
+
+      for (uint k = 0; k != diagCnt; ++k) {
+         CXDiagnostic diag = clang_getDiagnostic(unit.tu, k);
+         CXString diagMsg  = clang_formatDiagnostic(diag, clang_defaultDiagnosticDisplayOptions());
+
+         unit.diagnostics.append(QString::fromUtf8(clang_getCString(diagMsg)));
+
+         clang_disposeDiagnostic(diag);
+         clang_disposeString(diagMsg);
+      }
+   }
+
+   if (unit.errorCode == CXError_Success) {
+      // create a source range for the file
+      CXFile f = clang_getFile(unit.tu, unit.fileName.toUtf8().constData());
+
+      CXSourceLocation fileBegin = clang_getLocationForOffset(unit.tu, f, 0);
+      CXSourceLocation fileEnd   = clang_getLocationForOffset(unit.tu, f, unit.ufs[0].Length);
+      CXSourceRange    fileRange = clang_getRange(fileBegin, fileEnd);
+
+      // generate tokens for the tu
+      clang_tokenize(unit.tu, fileRange, &unit.tokens, &unit.numTokens);
+
+      // generate cursors for each token
+      unit.cursors = new CXCursor[unit.numTokens];
+      clang_annotateTokens(unit.tu, unit.tokens, unit.numTokens, unit.cursors);
+   }
+}
+
+ClangUnitThread::ClangUnitThread(ClangUnitPool *pool, int id)
+   : m_pool(pool), m_id(id)
+{
+}
+
+void ClangUnitThread::run()
+{
+   // exclude PCH files, disable diagnostics
+   CXIndex index = clang_createIndex(false, false);
+
+   ClangUnit *unit;
+
+   while (m_pool->nextJob(m_id, unit)) {
+      if (unit != nullptr) {
+         parseClangUnit(index, *unit);
+         m_pool->finished(unit);
+      }
+   }
+
+   m_pool->disposeReleased(m_id, true);
+   clang_disposeIndex(index);
+}
+
+ClangUnitPool::ClangUnitPool(int numThreads)
+   : m_stop(false)
+{
+   for (int i = 0; i < numThreads; ++i) {
+      ClangUnitThread *thread = new ClangUnitThread(this, i);
+      thread->start();
+
+      if (thread->isRunning()) {
+         m_workers.append(thread);
+
+      } else {
+         // no more threads available
+         delete thread;
+         break;
+      }
+   }
+}
+
+ClangUnitPool::~ClangUnitPool()
+{
+   {
+      QMutexLocker locker(&m_mutex);
+
+      m_stop = true;
+      m_jobReady.wakeAll();
+   }
+
+   for (auto thread : m_workers) {
+      thread->wait();
+      delete thread;
+   }
+
+   // units which were never parsed
+   for (auto unit : m_jobs) {
+      m_units.remove(unit->fileName);
+      delete unit;
+   }
+}
+
+void ClangUnitPool::queue(ClangUnit *unit)
+{
+   QMutexLocker locker(&m_mutex);
+
+   m_jobs.append(unit);
+   m_units.insert(unit->fileName, unit);
+
+   m_jobReady.wakeOne();
+}
+
+ClangUnit *ClangUnitPool::take(const QString &fileName)
+{
+   QMutexLocker locker(&m_mutex);
+
+   ClangUnit *unit = m_units.value(fileName);
+
+   if (unit == nullptr) {
+      return nullptr;
+   }
+
+   while (! unit->parsed) {
+      m_unitReady.wait(&m_mutex);
+   }
+
+   m_units.remove(fileName);
+
+   return unit;
+}
+
+void ClangUnitPool::release(ClangUnit *unit)
+{
+   QMutexLocker locker(&m_mutex);
+
+   m_released[unit->worker].append(unit);
+   m_jobReady.wakeAll();
+}
+
+bool ClangUnitPool::nextJob(int worker, ClangUnit *&unit)
+{
+   unit = nullptr;
+
+   {
+      QMutexLocker locker(&m_mutex);
+
+      while (! m_stop && m_jobs.isEmpty() && m_released.value(worker).isEmpty()) {
+         m_jobReady.wait(&m_mutex);
+      }
+
+      if (m_stop) {
+         return false;
+      }
+
+      if (! m_jobs.isEmpty()) {
+         unit = m_jobs.takeFirst();
+         unit->worker = worker;
+      }
+   }
+
+   // translation units must be disposed on the thread which owns their index
+   disposeReleased(worker, false);
+
+   return true;
+}
+
+void ClangUnitPool::finished(ClangUnit *unit)
+{
+   QMutexLocker locker(&m_mutex);
+
+   unit->parsed = true;
+   m_unitReady.wakeAll();
+}
+
+void ClangUnitPool::disposeReleased(int worker, bool stopping)
+{
+   QList<ClangUnit *> list;
+
+   {
+      QMutexLocker locker(&m_mutex);
+
+      list = m_released.take(worker);
+
+      if (stopping) {
+         // parsed units which were never taken
+         for (auto iter = m_units.begin(); iter != m_units.end(); ) {
+            if (iter.value()->worker == worker && iter.value()->parsed) {
+               list.append(iter.value());
+               iter = m_units.erase(iter);
+
+            } else {
+               ++iter;
+            }
+         }
+      }
+   }
+
+   for (auto unit : list) {
+      disposeUnit(unit);
+   }
+}
@@ -0,0 +1,130 @@
+/************************************************************************
+*
+* Copyright (c) 2014-2025 Barbara Geller & Ansel Sermersheim
+*
+* Copyright (c) 1997-2014 Dimitri van Heesch
+*
+* DoxyPress is free software. You can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* version 2 as published by the Free Software Foundation.
+*
+* DoxyPress is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+*
+* Documents produced by DoxyPress are derivative works derived from the
+* input used in their production; they are not affected by this license.
+*
+* https://www.gnu.org/licenses/
+*
+*************************************************************************/
+
+#ifndef CLANGUNITPOOL_H
+#define CLANGUNITPOOL_H
+
+#include <QByteArray>
+#include <QHash>
+#include <QList>
+#include <QMutex>
+#include <QString>
+#include <QStringList>
+#include <QThread>
+#include <QWaitCondition>
+
+#include <clang-c/Index.h>
+
+#include <vector>
+
+/** Translation unit parsed by libclang, along with the files passed to clang from memory */
+struct ClangUnit {
+   QString     fileName;
+   QString     fileBuffer;
+   QStringList includeFiles;
+
+   std::vector<QString> args;
+
+   // main file first, followed by the include files
+   QByteArray    *sources  = nullptr;
+   CXUnsavedFile *ufs      = nullptr;
+   uint           numFiles = 0;
+
+   QHash<QString, uint> fileMapping;
+
+   CXTranslationUnit tu        = nullptr;
+   CXErrorCode       errorCode = CXError_Failure;
+
+   // tokens and cursors of the main file
+   CXToken  *tokens    = nullptr;
+   CXCursor *cursors   = nullptr;
+   uint      numTokens = 0;
+
+   QStringList diagnostics;
+
+   // worker thread which owns the index used for this unit
+   int  worker = -1;
+   bool parsed = false;
+};
+
+// loads the main file and its include files, parses them, and tokenizes the main file
+void parseClangUnit(CXIndex index, ClangUnit &unit);
+
+class ClangUnitPool;
+
+/** Worker thread which uses one CXIndex for all of its translation units */
+class ClangUnitThread : public QThread
+{
+ public:
+   ClangUnitThread(ClangUnitPool *pool, int id);
+   void run() override;
+
+ private:
+   ClangUnitPool *m_pool;
+   int m_id;
+};
+
+/** Parses translation units with libclang on worker threads ahead of the entry extraction
+ *
+ *  The entries are created on the calling thread in the order the units were queued, which keeps
+ *  the entry tree identical to a single threaded run. A translation unit is disposed by the
+ *  thread which owns its index.
+ */
+class ClangUnitPool
+{
+ public:
+   ClangUnitPool(int numThreads);
+   ~ClangUnitPool();
+
+   // takes ownership of the unit
+   void queue(ClangUnit *unit);
+
+   // returns the unit for the file, waits until it is parsed, returns nullptr when the file was not queued
+   ClangUnit *take(const QString &fileName);
+
+   // passes the translation unit back to the thread which created it
+   void release(ClangUnit *unit);
+
+   int threadCount() const {
+      return m_workers.count();
+   }
+
+ private:
+   bool nextJob(int worker, ClangUnit *&unit);
+   void finished(ClangUnit *unit);
+   void disposeReleased(int worker, bool stopping);
+
+   QList<ClangUnit *> m_jobs;
+   QHash<QString, ClangUnit *> m_units;
+   QHash<int, QList<ClangUnit *>> m_released;
+
+   bool m_stop;
+
+   QMutex         m_mutex;
+   QWaitCondition m_jobReady;
+   QWaitCondition m_unitReady;
+
+   QList<ClangUnitThread *> m_workers;
+
+   friend class ClangUnitThread;
+};
+
+#endif
@@ -19,6 +19,7 @@
 *
 *************************************************************************/
 
+#include <QCryptographicHash>
 #include <QDir>
 
 #include <config.h>
@@ -111,6 +112,70 @@ QString Config::getString(const QString &name)
    return retval;
 }
 
+// settings which change the entries produced for an input file, output only settings are not part of the hash
+static const QStringList s_parseKeys = {
+   "optimize-cplus", "optimize-java", "optimize-c", "optimize-fortran", "optimize-python",
+
+   "output-language", "aliases", "abbreviate-brief", "strip-from-path", "strip-from-inc-path",
+   "full-path-names", "brief-member-desc", "repeat-brief", "always-detailed-sec", "javadoc-auto-brief",
+   "qt-auto-brief", "multiline-cpp-brief", "tab-size",
+
+   "extract-all", "extract-private", "extract-private-virtual", "extract-package", "extract-static",
+   "extract-local-classes", "extract-local-methods", "extract-anon-namespaces", "internal-docs",
+   "hide-undoc-members", "hide-undoc-classes", "hide-friend-compounds", "hide-in-body-docs",
+   "hide-scope-names", "hide-compound-ref", "generate-todo-list", "generate-test-list",
+   "generate-bug-list", "generate-deprecate-list",
+
+   "short-names", "allow-unicode-names", "case-sensitive-fname", "markdown", "auto-link",
+   "python-docstring", "strict-sig-matching", "inherit-docs", "use-typedef-name", "force-local-includes",
+   "allow-sub-grouping", "duplicate-docs", "group-nested-compounds",
+
+   "enabled-sections", "main-page-name", "main-page-omit", "ns-alias", "max-init-lines",
+   "toc-include-headers", "bb-style",
+
+   "tcl-subst", "language-mapping", "built-in-stl-support", "cpp-cli-support", "sip-support", "idl-support",
+
+   "input-encoding", "mdfile-mainpage",
+
+   "filter-program", "filter-patterns", "filter-source-files", "filter-source-patterns",
+
+   "enable-preprocessing", "search-includes", "include-path", "include-patterns", "macro-expansion",
+   "expand-only-predefined", "skip-function-macros", "predefined-macros", "expand-as-defined",
+
+   "clang-parsing", "clang-compilation-path", "clang-dialect", "clang-use-headers",
+   "clang-include-input-source", "clang-flags", "clang-precompiled-header",
+
+   "source-code", "strip-code-comments",
+};
+
+QByteArray Config::getConfigHash()
+{
+   QCryptographicHash hash(QCryptographicHash::Md5);
+
+   for (const auto &key : s_parseKeys) {
+      hash.addData(key.toUtf8());
+
+      if (m_cfgBool.contains(key)) {
+         hash.addData(m_cfgBool.value(key).value ? QByteArray("1") : QByteArray("0"));
+
+      } else if (m_cfgInt.contains(key)) {
+         hash.addData(QString::number(m_cfgInt.value(key).value).toUtf8());
+
+      } else if (m_cfgEnum.contains(key)) {
+         hash.addData(m_cfgEnum.value(key).value.toUtf8());
+
+      } else if (m_cfgList.contains(key)) {
+         hash.addData(m_cfgList.value(key).value.join("\n").toUtf8());
+
+      } else if (m_cfgString.contains(key)) {
+         hash.addData(m_cfgString.value(key).value.toUtf8());
+
+      }
+   }
+
+   return hash.result().toHex();
+}
+
 // update project data
 void Config::setBool(const QString &name, bool data)
 {
@@ -659,6 +724,12 @@ bool Config::verify()
       iterInt.value().value = 1000;
    }
 
+   iterInt = m_cfgInt.find("dot-timeout");
+
+   if (iterInt.value().value < 0) {
+      iterInt.value().value = 0;
+   }
+
 
    // ** html
    iterString = m_cfgString.find("html-file-extension");
@@ -716,6 +787,13 @@ bool Config::verify()
 
    iterInt.value().value = gamma;
 
+   // **
+   iterInt = m_cfgInt.find("search-data-shard-size");
+
+   if (iterInt.value().value < 0) {
+      iterInt.value().value = 0;
+   }
+
    // **
    iterEnum = m_cfgEnum.find("formula-format");
    QString formulaFormat = iterEnum.value().value;
@@ -44,6 +44,9 @@ class Config
       static QStringList getList(const QString &name);
       static QString getString(const QString &name);
 
+      // hash of the configuration values which change the parsed entries, used to invalidate the entry cache
+      static QByteArray getConfigHash();
+
       static void setBool(const QString &name, bool data);
       static void setList(const QString &name, const QStringList &data);
 
@@ -144,6 +144,10 @@ void Config::load_Defaults()
 
    m_cfgInt.insert("tab-size",                   struc_CfgInt    { 4,              DEFAULT } );
    m_cfgInt.insert("lookup-cache-size",          struc_CfgInt    { 0,              DEFAULT } );
+   m_cfgInt.insert("read-num-threads",           struc_CfgInt    { 1,              DEFAULT } );
+   m_cfgInt.insert("scan-num-threads",           struc_CfgInt    { 1,              DEFAULT } );
+
+   m_cfgString.insert("entry-cache-dir",         struc_CfgString { QString(),      DEFAULT } );
 
    // tab 2 - build configuration A
    m_cfgBool.insert("extract-all",               struc_CfgBool   { false,          DEFAULT } );
@@ -269,6 +273,7 @@ void Config::load_Defaults()
    m_cfgList.insert("filter-patterns",           struc_CfgList   { QStringList(),   DEFAULT } );
    m_cfgBool.insert("filter-source-files",       struc_CfgBool   { false,           DEFAULT } );
    m_cfgList.insert("filter-source-patterns",    struc_CfgList   { QStringList(),   DEFAULT } );
+   m_cfgString.insert("filter-cache-dir",        struc_CfgString { QString(),       DEFAULT } );
 
    // tab 2 -index page
    m_cfgBool.insert("alpha-index",               struc_CfgBool   { true,            DEFAULT } );
@@ -296,6 +301,8 @@ void Config::load_Defaults()
    m_cfgBool.insert("clang-use-headers",          struc_CfgBool   { true,            DEFAULT } );
    m_cfgBool.insert("clang-include-input-source", struc_CfgBool   { true,            DEFAULT } );
    m_cfgList.insert("clang-flags",                struc_CfgList   { QStringList(),   DEFAULT } );
+   m_cfgInt.insert("clang-num-threads",           struc_CfgInt    { 1,               DEFAULT } );
+   m_cfgString.insert("clang-precompiled-header", struc_CfgString { QString(),       DEFAULT } );
 
    // tab 2 - source listing
    m_cfgBool.insert("source-code",               struc_CfgBool   { false,           DEFAULT } );
@@ -331,6 +338,7 @@ void Config::load_Defaults()
    m_cfgBool.insert("hide-undoc-relations",      struc_CfgBool   { true,            DEFAULT } );
    m_cfgBool.insert("have-dot",                  struc_CfgBool   { false,           DEFAULT } );
    m_cfgInt.insert("dot-num-threads",            struc_CfgInt    { 0,               DEFAULT } );
+   m_cfgInt.insert("dot-timeout",                struc_CfgInt    { 0,               DEFAULT } );
    m_cfgString.insert("dot-font-name",           struc_CfgString { "Helvetica",     DEFAULT } );
    m_cfgInt.insert("dot-font-size",              struc_CfgInt    { 10,              DEFAULT } );
    m_cfgString.insert("dot-font-path",           struc_CfgString { QString(),       DEFAULT } );
@@ -357,6 +365,8 @@ void Config::load_Defaults()
    m_cfgBool.insert("dot-multiple-targets",      struc_CfgBool   { false,           DEFAULT } );
    m_cfgBool.insert("generate-legend",           struc_CfgBool   { true,            DEFAULT } );
    m_cfgBool.insert("dot-cleanup",               struc_CfgBool   { true,            DEFAULT } );
+   m_cfgString.insert("dot-cache-dir",           struc_CfgString { QString(),       DEFAULT } );
+   m_cfgBool.insert("dot-graphviz-lib",          struc_CfgBool   { false,           DEFAULT } );
 
    // tab 3 ( appear on tab 1 and tab 3 )
    m_cfgBool.insert("generate-html",             struc_CfgBool   { true,            DEFAULT } );
@@ -399,8 +409,11 @@ void Config::load_Defaults()
    m_cfgBool.insert("html-search",               struc_CfgBool   { true,             DEFAULT } );
    m_cfgBool.insert("search-server-based",       struc_CfgBool   { false,            DEFAULT } );
    m_cfgBool.insert("search-external",           struc_CfgBool   { false,            DEFAULT } );
+   m_cfgBool.insert("search-compress-data",      struc_CfgBool   { false,            DEFAULT } );
    m_cfgString.insert("search-external-url",     struc_CfgString { QString(),        DEFAULT } );
    m_cfgString.insert("search-data-file",        struc_CfgString { "searchdata.xml", DEFAULT } );
+   m_cfgBool.insert("search-data-streaming",     struc_CfgBool   { false,            DEFAULT } );
+   m_cfgInt.insert("search-data-shard-size",     struc_CfgInt    { 0,                DEFAULT } );
    m_cfgString.insert("search-external-id",      struc_CfgString { QString(),        DEFAULT } );
    m_cfgList.insert("search-mappings",           struc_CfgList   { QStringList(),    DEFAULT } );
 
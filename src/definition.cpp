@@ -20,7 +20,6 @@
 *************************************************************************/
 
 #include <QCryptographicHash>
-#include <QProcess>
 #include <QRegularExpression>
 
 #include <ctype.h>
@@ -38,6 +37,7 @@
 #include <message.h>
 #include <outputlist.h>
 #include <parse_base.h>
+#include <sourcecache.h>
 #include <util.h>
 
 class Definition_Private
@@ -597,129 +597,45 @@ void Definition::setInbodyDocumentation(const QString &d, const QString &inbodyF
  */
 static bool readCodeFragment(const QString &fileName, int &startLine, int &endLine, QString &result)
 {
-   static const bool filterSourceFiles = Config::getBool("filter-source-files");
-
    if (fileName.isEmpty()) {
       return false;
    }
 
-   SrcLangExt lang = getLanguageFromFileName(fileName);
-
-   QString tmpResult;
-   QString filter = getFileFilter(fileName, true);
-
-   QByteArray buffer;
-
-   if (filterSourceFiles && ! filter.isEmpty()) {
-
-      QStringList cmdList;
-      cmdList.append(fileName);
-
-      QProcess task;
-      task.start(filter, cmdList);
-
-      while (task.waitForReadyRead(-1)) {
-         buffer.append(task.readAllStandardOutput());
-      }
-
-      if (task.exitStatus() != QProcess::NormalExit) {
-         err("Unable to execute %s\n", csPrintable(fileName));
-         return false;
-      }
-
-    } else {
-      QFile f(fileName);
-
-      if (! f.open(QIODevice::ReadOnly)) {
-         err("Unable to open file %s for reading, OS Error #: %d\n", csPrintable(fileName), f.error());
-         return false;
-      }
+   // each file is read and filtered once, later fragments are taken from the line index
+   QSharedPointer<const SourceFile> file = SourceCache::instance().file(fileName);
 
-      buffer = f.readAll();
-      f.close();
+   if (file == nullptr) {
+      return false;
    }
 
+   SrcLangExt lang = getLanguageFromFileName(fileName);
+
    // for TCL, Python, and Fortran no bracket search is possible
    bool found = (lang == SrcLangExt_Tcl) || (lang == SrcLangExt_Python) || (lang == SrcLangExt_Fortran);
 
-   const char *ptr = buffer.constData();
-
-   if (ptr) {
-      int c      = 0;
-      int lineNr = 1;
+   if (startLine < 1) {
+      startLine = 1;
+   }
 
-      // skip until the startLine has reached
+   if (startLine <= file->lineCount()) {
+      found = true;
 
-      while (lineNr < startLine && *ptr) {
-         while ((c = *ptr++) != '\n' && c != 0) {
-            // skip
-         }
+      // at least the start line is copied
+      endLine = qBound(startLine, endLine, file->lineCount());
+      result  = file->lines(startLine, endLine);
 
-         lineNr++;
+      // strip stuff after closing bracket
+      int newLineIndex = result.lastIndexOf('\n');
+      int braceIndex   = result.lastIndexOf('}');
 
-         if (found && c == '\n') {
-            c = '\0';
-         }
+      if (braceIndex > newLineIndex) {
+         result.truncate(braceIndex + 1);
       }
 
-      if (*ptr) {
-         found = true;
-
-         // skip over newline
-         if (c == '\n') {
-             c = *ptr;
-             ++ptr;
-         }
-
-         // copy until end of line
-         if (c != '\0') {
-            tmpResult += c;
-         }
-
-         startLine = lineNr;
-
-         constexpr const int maxLineLength = 4096;
-         char lineStr[maxLineLength];
-
-         do {
-            int size_read;
-
-            do {
-               // read up to maxLineLength-1 bytes, the last byte being zero
-               int i = 0;
-
-               while ((c = *ptr++) && i < maxLineLength - 1) {
-                  lineStr[i] = c;
-                  ++i;
-
-                  if (c == '\n') {
-                     break;
-                  }
-               }
-
-               size_read = i;
-               tmpResult += QString::fromUtf8(lineStr, size_read);
-
-            } while (size_read == (maxLineLength - 1));
-
-            ++lineNr;
-
-         } while (lineNr <= endLine && *ptr);
-
-         // strip stuff after closing bracket
-         int newLineIndex = tmpResult.lastIndexOf('\n');
-         int braceIndex   = tmpResult.lastIndexOf('}');
-
-         if (braceIndex > newLineIndex) {
-            tmpResult.truncate(braceIndex + 1);
-         }
-
-         endLine = lineNr - 1;
-      }
+   } else {
+      result = QString();
    }
 
-   result = tmpResult;
-
    if (! result.isEmpty() && ! result.endsWith('\n')) {
       result += "\n";
    }
@@ -0,0 +1,162 @@
+/************************************************************************
+*
+* Copyright (c) 2014-2025 Barbara Geller & Ansel Sermersheim
+*
+* Copyright (c) 1997-2014 Dimitri van Heesch
+*
+* DoxyPress is free software. You can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* version 2 as published by the Free Software Foundation.
+*
+* DoxyPress is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+*
+* Documents produced by DoxyPress are derivative works derived from the
+* input used in their production; they are not affected by this license.
+*
+* https://www.gnu.org/licenses/
+*
+*************************************************************************/
+
+#include <QDir>
+#include <QMutexLocker>
+
+#include <dirscanner.h>
+
+#include <patternmatcher.h>
+
+DirScannerThread::DirScannerThread(DirScanner *scanner)
+   : m_scanner(scanner)
+{
+}
+
+void DirScannerThread::run()
+{
+   QString dirName;
+
+   while (m_scanner->nextDirectory(dirName)) {
+      m_scanner->finished(dirName, DirScanner::readDirectory(dirName));
+   }
+}
+
+DirScanner::DirScanner(int numThreads)
+   : m_numThreads(numThreads), m_busy(0)
+{
+}
+
+QFileInfoList DirScanner::readDirectory(const QString &dirName)
+{
+   // same filter and sort order as Doxy_Work::readDir
+   QDir dir(dirName);
+   dir.setFilter(QDir::Files | QDir::Dirs | QDir::Hidden);
+
+   QFileInfoList list = dir.entryInfoList();
+
+   // fetch the file information now, QFileInfo keeps it for the walk
+   for (auto &cfi : list) {
+      if (cfi.exists()) {
+         cfi.isReadable();
+         cfi.isSymLink();
+
+         if (cfi.isFile()) {
+            cfi.size();
+         }
+      }
+   }
+
+   return list;
+}
+
+void DirScanner::scan(const QString &dirName, QSharedPointer<const FilePatternMatcher> excludeMatcher)
+{
+   if (m_numThreads < 2) {
+      return;
+   }
+
+   m_excludeMatcher = excludeMatcher;
+   m_queue.enqueue(dirName);
+
+   QList<DirScannerThread *> workers;
+
+   for (int i = 0; i < m_numThreads; ++i) {
+      DirScannerThread *thread = new DirScannerThread(this);
+      thread->start();
+
+      if (thread->isRunning()) {
+         workers.append(thread);
+
+      } else {
+         // no more threads available
+         delete thread;
+         break;
+      }
+   }
+
+   for (auto thread : workers) {
+      thread->wait();
+      delete thread;
+   }
+}
+
+bool DirScanner::nextDirectory(QString &dirName)
+{
+   QMutexLocker locker(&m_mutex);
+
+   while (m_queue.isEmpty() && m_busy > 0) {
+      // another thread may still find subdirectories
+      m_workAvailable.wait(&m_mutex);
+   }
+
+   if (m_queue.isEmpty()) {
+      return false;
+   }
+
+   dirName = m_queue.dequeue();
+   ++m_busy;
+
+   return true;
+}
+
+void DirScanner::finished(const QString &dirName, const QFileInfoList &list)
+{
+   QStringList subDirs;
+
+   for (const auto &cfi : list) {
+      // symbolic links are resolved during the walk, hidden directories are never read
+      if (cfi.isDir() && ! cfi.isSymLink() && cfi.isReadable() && ! cfi.fileName().startsWith('.')) {
+
+         if (m_excludeMatcher == nullptr || ! m_excludeMatcher->match(cfi)) {
+            subDirs.append(cfi.absoluteFilePath());
+         }
+      }
+   }
+
+   QMutexLocker locker(&m_mutex);
+
+   m_listings.insert(dirName, list);
+
+   for (const auto &item : subDirs) {
+      m_queue.enqueue(item);
+   }
+
+   --m_busy;
+   m_workAvailable.wakeAll();
+}
+
+QFileInfoList DirScanner::entryList(const QString &dirName)
+{
+   {
+      QMutexLocker locker(&m_mutex);
+      auto iter = m_listings.find(dirName);
+
+      if (iter != m_listings.end()) {
+         QFileInfoList retval = iter.value();
+         m_listings.erase(iter);
+
+         return retval;
+      }
+   }
+
+   return readDirectory(dirName);
+}
@@ -0,0 +1,87 @@
+/************************************************************************
+*
+* Copyright (c) 2014-2025 Barbara Geller & Ansel Sermersheim
+*
+* Copyright (c) 1997-2014 Dimitri van Heesch
+*
+* DoxyPress is free software. You can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* version 2 as published by the Free Software Foundation.
+*
+* DoxyPress is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+*
+* Documents produced by DoxyPress are derivative works derived from the
+* input used in their production; they are not affected by this license.
+*
+* https://www.gnu.org/licenses/
+*
+*************************************************************************/
+
+#ifndef DIRSCANNER_H
+#define DIRSCANNER_H
+
+#include <QFileInfo>
+#include <QHash>
+#include <QList>
+#include <QMutex>
+#include <QQueue>
+#include <QSharedPointer>
+#include <QString>
+#include <QThread>
+#include <QWaitCondition>
+
+class DirScanner;
+class FilePatternMatcher;
+
+/** Worker thread which reads directories for the DirScanner */
+class DirScannerThread : public QThread
+{
+ public:
+   DirScannerThread(DirScanner *scanner);
+   void run() override;
+
+ private:
+   DirScanner *m_scanner;
+};
+
+/** Reads a directory tree on worker threads before the tree is walked in order
+ *
+ *  Each directory is listed once and the file information of every entry is fetched on the
+ *  worker threads. The listings are returned in the same order QDir would produce, so the walk
+ *  which consumes them builds the same file lists as a single threaded run. Symbolic links and
+ *  excluded directories are not entered, these are read when they are requested.
+ */
+class DirScanner
+{
+ public:
+   DirScanner(int numThreads);
+
+   // reads dirName and all directories below it, returns when the whole tree was read
+   void scan(const QString &dirName, QSharedPointer<const FilePatternMatcher> excludeMatcher);
+
+   // returns the entries of dirName, the directory is read now if it was not scanned
+   QFileInfoList entryList(const QString &dirName);
+
+   static QFileInfoList readDirectory(const QString &dirName);
+
+ private:
+   bool nextDirectory(QString &dirName);
+   void finished(const QString &dirName, const QFileInfoList &list);
+
+   int m_numThreads;
+   int m_busy;
+
+   QSharedPointer<const FilePatternMatcher> m_excludeMatcher;
+
+   QQueue<QString> m_queue;
+   QHash<QString, QFileInfoList> m_listings;
+
+   QMutex         m_mutex;
+   QWaitCondition m_workAvailable;
+
+   friend class DirScannerThread;
+};
+
+#endif
@@ -71,7 +71,7 @@ static bool supportedHtmlAttribute(const QString &name)
    return htmlWords.contains(name);
 }
 
-void DocbookDocVisitor::visitPreStart(QTextStream  &t, const QList<DocNode *> &children, bool hasCaption,
+void DocbookDocVisitor::visitPreStart(QTextStream  &t, const DocNodeList &children, bool hasCaption,
                   const QString &name, const QString &width, const QString &height, bool inlineImage)
 {
    if (hasCaption && ! inlineImage)   {
@@ -129,7 +129,7 @@ void DocbookDocVisitor::visitPostEnd(QTextStream &t, const bool hasCaption, bool
    }
 }
 
-void DocbookDocVisitor::visitCaption(const QList<DocNode *> &children)
+void DocbookDocVisitor::visitCaption(const DocNodeList &children)
 {
    for (auto item : children) {
       item->accept(this);
@@ -1859,7 +1859,7 @@ void DocbookDocVisitor::writePlantUMLFile(const QString &baseName, DocVerbatim *
 }
 
 void DocbookDocVisitor::startMscFile(const QString &fileName, const QString &width, const QString &height,
-                  bool hasCaption, const QList<DocNode *> &children)
+                  bool hasCaption, const DocNodeList &children)
 {
    static const QString docbookOutDir = Config::getString("docbook-output");
 
@@ -1909,7 +1909,7 @@ void DocbookDocVisitor::writeDiaFile(const QString &baseName, DocVerbatim *s)
 }
 
 void DocbookDocVisitor::startDiaFile(const QString &fileName, const QString &width, const QString &height,
-                  bool hasCaption, const QList<DocNode *> &children)
+                  bool hasCaption, const DocNodeList &children)
 {
    static const QString docbookOutDir = Config::getString("docbook-output");
 
@@ -1960,7 +1960,7 @@ void DocbookDocVisitor::writeDotFile(const QString &baseName, DocVerbatim *s)
 }
 
 void DocbookDocVisitor::startDotFile(const QString &fileName, const QString &width, const QString &height,
-                  bool hasCaption, const QList<DocNode *> &children)
+                  bool hasCaption, const DocNodeList &children)
 {
    static const QString docbookOutDir = Config::getString("docbook-output");
    static const QString imageExt      = Config::getEnum("dot-image-extension");
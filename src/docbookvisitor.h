@@ -147,15 +147,15 @@ class DocbookDocVisitor : public DocVisitor
    void pushEnabled();
    void popEnabled();
    void startMscFile(const QString &fileName, const QString &width, const QString &height,
-            bool hasCaption, const QList<DocNode *> &children);
+            bool hasCaption, const DocNodeList &children);
    void endMscFile(bool hasCaption);
 
    void startDiaFile(const QString &fileName, const QString &width, const QString &height,
-            bool hasCaption, const QList<DocNode *> &children);
+            bool hasCaption, const DocNodeList &children);
    void endDiaFile(bool hasCaption);
 
    void startDotFile(const QString &fileName, const QString &width, const QString &height,
-            bool hasCaption, const QList<DocNode *> &children);
+            bool hasCaption, const DocNodeList &children);
    void endDotFile(bool hasCaption);
 
    void writeDotFile(const QString &fileName, DocVerbatim *s);
@@ -163,11 +163,11 @@ class DocbookDocVisitor : public DocVisitor
    void writeDiaFile(const QString &fileName, DocVerbatim *s);
    void writePlantUMLFile(const QString &fileName, DocVerbatim *s);
 
-   void visitPreStart(QTextStream  &t, const QList<DocNode  *> &children, bool hasCaption,
+   void visitPreStart(QTextStream  &t, const DocNodeList &children, bool hasCaption,
                   const QString &name, const QString &width, const QString &height, bool inlineImage = false);
 
    void visitPostEnd(QTextStream  &t, bool hasCaption, bool inlineImage = false);
-   void visitCaption(const QList<DocNode *> &children);
+   void visitCaption(const DocNodeList &children);
 
    QTextStream &m_t;
    CodeGenerator &m_ci;
@@ -0,0 +1,136 @@
+/************************************************************************
+*
+* Copyright (c) 2014-2025 Barbara Geller & Ansel Sermersheim
+*
+* Copyright (c) 1997-2014 Dimitri van Heesch
+*
+* DoxyPress is free software. You can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* version 2 as published by the Free Software Foundation.
+*
+* DoxyPress is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+*
+* Documents produced by DoxyPress are derivative works derived from the
+* input used in their production; they are not affected by this license.
+*
+* https://www.gnu.org/licenses/
+*
+*************************************************************************/
+
+#include <docnodearena.h>
+
+#include <new>
+
+#include <stdlib.h>
+
+// every allocation is preceded by a header which records the arena owning the memory
+struct alignas(std::max_align_t) ArenaHeader {
+   DocNodeArena *arena;
+};
+
+static const size_t arenaBlockSize = 32 * 1024;
+
+// allocations larger than this are taken from the heap
+static const size_t arenaMaxAlloc  = arenaBlockSize / 4;
+
+static thread_local DocNodeArena *s_currentArena = nullptr;
+
+// the scope which created the arena holds the first reference
+DocNodeArena::DocNodeArena()
+   : m_liveCount(1)
+{
+}
+
+DocNodeArena::~DocNodeArena()
+{
+   for (char *block : m_blocks) {
+      free(block);
+   }
+}
+
+void *DocNodeArena::allocate(size_t size)
+{
+   size_t total = sizeof(ArenaHeader) + size;
+   total = (total + alignof(std::max_align_t) - 1) & ~(alignof(std::max_align_t) - 1);
+
+   ArenaHeader *header;
+
+   if (s_currentArena != nullptr && total <= arenaMaxAlloc) {
+      header = static_cast<ArenaHeader *>(s_currentArena->alloc(total));
+      header->arena = s_currentArena;
+
+   } else {
+      header = static_cast<ArenaHeader *>(malloc(total));
+
+      if (header == nullptr) {
+         throw std::bad_alloc();
+      }
+
+      header->arena = nullptr;
+   }
+
+   return header + 1;
+}
+
+void DocNodeArena::release(void *ptr)
+{
+   if (ptr == nullptr) {
+      return;
+   }
+
+   ArenaHeader *header = static_cast<ArenaHeader *>(ptr) - 1;
+   DocNodeArena *arena = header->arena;
+
+   if (arena == nullptr) {
+      free(header);
+
+   } else {
+      arena->unref();
+   }
+}
+
+void *DocNodeArena::alloc(size_t size)
+{
+   if (size > m_remaining) {
+      m_current = static_cast<char *>(malloc(arenaBlockSize));
+
+      if (m_current == nullptr) {
+         throw std::bad_alloc();
+      }
+
+      m_remaining = arenaBlockSize;
+      m_blocks.push_back(m_current);
+   }
+
+   void *retval = m_current;
+
+   m_current   += size;
+   m_remaining -= size;
+
+   ++m_liveCount;
+
+   return retval;
+}
+
+void DocNodeArena::unref()
+{
+   if (--m_liveCount == 0) {
+      delete this;
+   }
+}
+
+DocNodeArenaScope::DocNodeArenaScope()
+   : m_arena(new DocNodeArena), m_previous(s_currentArena)
+{
+   s_currentArena = m_arena;
+}
+
+DocNodeArenaScope::~DocNodeArenaScope()
+{
+   s_currentArena = m_previous;
+
+   // nodes which outlive the scope keep the arena alive
+   m_arena->unref();
+}
@@ -0,0 +1,73 @@
+/************************************************************************
+*
+* Copyright (c) 2014-2025 Barbara Geller & Ansel Sermersheim
+*
+* Copyright (c) 1997-2014 Dimitri van Heesch
+*
+* DoxyPress is free software. You can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* version 2 as published by the Free Software Foundation.
+*
+* DoxyPress is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+*
+* Documents produced by DoxyPress are derivative works derived from the
+* input used in their production; they are not affected by this license.
+*
+* https://www.gnu.org/licenses/
+*
+*************************************************************************/
+
+#ifndef DOCNODEARENA_H
+#define DOCNODEARENA_H
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+/** Bump pointer allocator for the nodes of one documentation tree
+ *
+ *  While a DocNodeArenaScope is active every DocNode created on the calling thread is placed
+ *  in the arena of the scope. Deleting a node only runs its destructor, the memory of the
+ *  arena is released in one step once the scope has ended and the last node was deleted.
+ */
+class DocNodeArena
+{
+ public:
+   static void *allocate(size_t size);
+   static void release(void *ptr);
+
+ private:
+   DocNodeArena();
+   ~DocNodeArena();
+
+   void *alloc(size_t size);
+   void unref();
+
+   std::vector<char *> m_blocks;
+
+   char  *m_current   = nullptr;
+   size_t m_remaining = 0;
+
+   std::atomic<int> m_liveCount;
+
+   friend class DocNodeArenaScope;
+};
+
+/** Makes a new arena current for the calling thread, the previous arena is restored on destruction */
+class DocNodeArenaScope
+{
+ public:
+   DocNodeArenaScope();
+   ~DocNodeArenaScope();
+
+   DocNodeArenaScope(const DocNodeArenaScope &) = delete;
+   DocNodeArenaScope &operator=(const DocNodeArenaScope &) = delete;
+
+ private:
+   DocNodeArena *m_arena;
+   DocNodeArena *m_previous;
+};
+
+#endif
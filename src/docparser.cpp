@@ -61,8 +61,8 @@
 #define INTERNAL_ASSERT(x) do {} while(0)
 // #define INTERNAL_ASSERT(x) if (!(x)) DBG(("INTERNAL_ASSERT(%s) failed retval=0x%x: file=%s line=%d\n",#x,retval,__FILE__,__LINE__));
 
-static bool defaultHandleToken(DocNode *parent, int tok, QList<DocNode *> &children, bool handleWord = true);
-static void handleImg(DocNode *parent, QList<DocNode *> &children, const HtmlAttribList &tagHtmlAttribs);
+static bool defaultHandleToken(DocNode *parent, int tok, DocNodeList &children, bool handleWord = true);
+static void handleImg(DocNode *parent, DocNodeList &children, const HtmlAttribList &tagHtmlAttribs);
 
 static const QString sectionLevelToName[] = {
    "page",
@@ -111,40 +111,40 @@ struct DocParserContext {
    TokenInfo *token;
 };
 
-// Parser state variables during a call to validatingParseDoc
-static QSharedPointer<Definition> s_scope;
-static QString                 s_context;
-static bool                    s_inSeeBlock;
-static bool                    s_xmlComment;
-static bool                    s_insideHtmlLink;
-static QStack<DocNode *>       s_nodeStack;
-static QStack<DocStyleChange>  s_styleStack;
-static QStack<DocStyleChange>  s_initialStyleStack;
+// Parser state variables during a call to validatingParseDoc, each thread parses with its own state
+static thread_local QSharedPointer<Definition> s_scope;
+static thread_local QString                 s_context;
+static thread_local bool                    s_inSeeBlock;
+static thread_local bool                    s_xmlComment;
+static thread_local bool                    s_insideHtmlLink;
+static thread_local QStack<DocNode *>       s_nodeStack;
+static thread_local QStack<DocStyleChange>  s_styleStack;
+static thread_local QStack<DocStyleChange>  s_initialStyleStack;
 
-static QList<QSharedPointer<Definition>> s_copyStack;
+static thread_local QList<QSharedPointer<Definition>> s_copyStack;
 
-static QString                 s_fileName;
-static QString                 s_relPath;
+static thread_local QString                 s_fileName;
+static thread_local QString                 s_relPath;
 
-static bool                    s_hasParamCommand;
-static bool                    s_hasReturnCommand;
-static QSet<QString>           s_paramsFound;
+static thread_local bool                    s_hasParamCommand;
+static thread_local bool                    s_hasReturnCommand;
+static thread_local QSet<QString>           s_paramsFound;
 
-static QSharedPointer<MemberDef> s_memberDef;
+static thread_local QSharedPointer<MemberDef> s_memberDef;
 
-static bool                    s_isExample;
-static QString                 s_exampleName;
-static SectionDict            *s_sectionDict;
-static QString                 s_searchUrl;
+static thread_local bool                    s_isExample;
+static thread_local QString                 s_exampleName;
+static thread_local SectionDict            *s_sectionDict;
+static thread_local QString                 s_searchUrl;
 
-static QString                 s_includeFileName;
-static QString                 s_includeFileText;
-static uint                    s_includeFileOffset;
-static uint                    s_includeFileLength;
-static uint                    s_includeFileLine;
-static bool                    s_includeFileUseLN;
+static thread_local QString                 s_includeFileName;
+static thread_local QString                 s_includeFileText;
+static thread_local uint                    s_includeFileOffset;
+static thread_local uint                    s_includeFileLength;
+static thread_local uint                    s_includeFileLine;
+static thread_local bool                    s_includeFileUseLN;
 
-static QStack<DocParserContext> s_parserStack;
+static thread_local QStack<DocParserContext> s_parserStack;
 
 static void docParserPushContext(bool saveParamInfo = true)
 {
@@ -978,7 +978,7 @@ static QSharedPointer<Definition> findDocsForMemberOrCompound(QString commandNam
    return retval;
 }
 
-static int handleStyleArgument(DocNode *parent, QList<DocNode *> &children, const QString &cmdName)
+static int handleStyleArgument(DocNode *parent, DocNodeList &children, const QString &cmdName)
 {
    DBG(("handleStyleArgument(%s)\n", csPrintable(cmdName)));
 
@@ -1038,7 +1038,7 @@ static int handleStyleArgument(DocNode *parent, QList<DocNode *> &children, cons
 }
 
 // Called when a style change starts. For instance a \<b\> command is encountered
-static void handleStyleEnter(DocNode *parent, QList<DocNode *> &children, DocStyleChange::Style s,
+static void handleStyleEnter(DocNode *parent, DocNodeList &children, DocStyleChange::Style s,
             const HtmlAttribList *attribs)
 {
    DBG(("HandleStyleEnter\n"));
@@ -1049,7 +1049,7 @@ static void handleStyleEnter(DocNode *parent, QList<DocNode *> &children, DocSty
 }
 
 // Called when a style change ends. For instance a \</b\> command is encountered
-static void handleStyleLeave(DocNode *parent, QList<DocNode *> &children, DocStyleChange::Style s, const QString &tagName)
+static void handleStyleLeave(DocNode *parent, DocNodeList &children, DocStyleChange::Style s, const QString &tagName)
 {
    DBG(("HandleStyleLeave\n"));
 
@@ -1081,7 +1081,7 @@ static void handleStyleLeave(DocNode *parent, QList<DocNode *> &children, DocSty
  *  (e.g. a <b> without a </b>). The closed styles are pushed onto a stack
  *  and entered again at the start of a new paragraph.
  */
-static void handlePendingStyleCommands(DocNode *parent, QList<DocNode *> &children)
+static void handlePendingStyleCommands(DocNode *parent, DocNodeList &children)
 {
    if (! s_styleStack.isEmpty()) {
       DocStyleChange sc = s_styleStack.top();
@@ -1110,7 +1110,7 @@ static void handlePendingStyleCommands(DocNode *parent, QList<DocNode *> &childr
    }
 }
 
-static void handleInitialStyleCommands(DocPara *parent, QList<DocNode *> &children)
+static void handleInitialStyleCommands(DocPara *parent, DocNodeList &children)
 {
    while (! s_initialStyleStack.isEmpty()) {
       DocStyleChange sc = s_initialStyleStack.pop();
@@ -1118,7 +1118,7 @@ static void handleInitialStyleCommands(DocPara *parent, QList<DocNode *> &childr
    }
 }
 
-static int handleAHref(DocNode *parent, QList<DocNode *> &children, const HtmlAttribList &tagHtmlAttribs)
+static int handleAHref(DocNode *parent, DocNodeList &children, const HtmlAttribList &tagHtmlAttribs)
 {
    int index  = 0;
    int retval = RetVal_OK;
@@ -1258,7 +1258,7 @@ static void handleUnclosedStyleCommands()
    }
 }
 
-static void handleLinkedWord(DocNode *parent, QList<DocNode *> &children, bool ignoreAutoLinkFlag = false)
+static void handleLinkedWord(DocNode *parent, DocNodeList &children, bool ignoreAutoLinkFlag = false)
 {
    static const bool autolinkSupport        = Config::getBool("auto-link");
    static const bool warnSeeAlsoMissingLink = Config::getBool("warn-sa-missing-links");
@@ -1379,7 +1379,7 @@ static void handleLinkedWord(DocNode *parent, QList<DocNode *> &children, bool i
    }
 }
 
-static void handleParameterType(DocNode *parent, QList<DocNode *> &children, const QString &paramTypes)
+static void handleParameterType(DocNode *parent, DocNodeList &children, const QString &paramTypes)
 {
    QString name = g_token->name;
    QString tmp;
@@ -1549,7 +1549,7 @@ static void handleAnchorName(DocNode *parent)
  * @param[out] width     the extracted width specifier
  * @param[out] height    the extracted height specifier
  */
-static void defaultHandleTitleAndSize(const int cmd, DocNode *parent, QList<DocNode *> &children,
+static void defaultHandleTitleAndSize(const int cmd, DocNode *parent, DocNodeList &children,
          QString &width, QString &height)
 {
    s_nodeStack.push(parent);
@@ -1629,7 +1629,7 @@ static void defaultHandleTitleAndSize(const int cmd, DocNode *parent, QList<DocN
    assert(n == parent);
 }
 
-static void handleImage(DocNode *parent, QList<DocNode *> &children)
+static void handleImage(DocNode *parent, DocNodeList &children)
 {
    bool inlineImage = false;
    QString anchorStr;
@@ -1765,7 +1765,7 @@ static void handleImage(DocNode *parent, QList<DocNode *> &children)
  * @retval true      The token was handled.
  * @retval false     The token was not handled.
  */
-static bool defaultHandleToken(DocNode *parent, int tok, QList<DocNode *> &children, bool handleWord)
+static bool defaultHandleToken(DocNode *parent, int tok, DocNodeList &children, bool handleWord)
 {
    DBG(("token %s at %d", csPrintable(tokToString(tok)), getDoctokenLineNum()));
 
@@ -2230,7 +2230,7 @@ static bool defaultHandleToken(DocNode *parent, int tok, QList<DocNode *> &child
    return true;
 }
 
-void handleImg(DocNode *parent, QList<DocNode *> &children, const HtmlAttribList &tagHtmlAttribs)
+void handleImg(DocNode *parent, DocNodeList &children, const HtmlAttribList &tagHtmlAttribs)
 {
    bool found = false;
    int index = 0;
@@ -2290,7 +2290,7 @@ DocEmoji::DocEmoji(DocNode *parent, const QString &symName)
    }
 }
 
-static int internalValidatingParseDoc(DocNode *parent, QList<DocNode *> &children, const QString &doc)
+static int internalValidatingParseDoc(DocNode *parent, DocNodeList &children, const QString &doc)
 {
    int retval = RetVal_OK;
 
@@ -2742,7 +2742,7 @@ void DocIncOperator::parse()
    }
 }
 
-void DocCopy::parse(QList<DocNode *> &children)
+void DocCopy::parse(DocNodeList &children)
 {
    QString doc;
    QString brief;
@@ -3203,14 +3203,14 @@ DocRef::DocRef(DocNode *parent, const QString &target, const QString &context)
          csPrintable(target));
 }
 
-static void flattenParagraphs(DocNode *root, QList<DocNode *> &children)
+static void flattenParagraphs(DocNode *root, DocNodeList &children)
 {
-   QList<DocNode*> newChildren;
+   DocNodeList newChildren;
 
    for (auto dn : children) {
       if (dn->kind() == DocNode::Kind_Para) {
          DocPara *para = (DocPara *)dn;
-         QList<DocNode *> &paraChildren = para->children();
+         DocNodeList &paraChildren = para->children();
 
          for (auto item : paraChildren) {
             newChildren.append(item); // add them to new node
@@ -9168,6 +9168,9 @@ DocRoot *validatingParseDoc(const QString &fileName, int startLine, QSharedPoint
                   QSharedPointer<MemberDef> md, const QString &input, bool indexWords, bool isExample,
                   const QString &exampleName, bool singleLine, bool linkFromIndex)
 {
+   // all nodes of the tree are allocated from one arena
+   DocNodeArenaScope arenaScope;
+
    // store parser state so we can re-enter this function if needed
 
    // bool fortranOpt = Config::getBool("optimize-fortran");
@@ -9275,6 +9278,8 @@ DocRoot *validatingParseDoc(const QString &fileName, int startLine, QSharedPoint
 
 DocText *validatingParseText(const QString &input)
 {
+   DocNodeArenaScope arenaScope;
+
    // store parser state so we can re-enter this function if needed
    docParserPushContext();
 
@@ -23,17 +23,21 @@
 #define DOCPARSER_H
 
 #include <definition.h>
+#include <docnodearena.h>
 #include <docvisitor.h>
 #include <htmlattrib.h>
 #include <membergroup.h>
 
 #include <QList>
+#include <QVector>
 
 #include <stdio.h>
 
 class DocNode;
 class MemberDef;
 
+using DocNodeList = QVector<DocNode *>;
+
 // rtl
 namespace Text {
 
@@ -156,6 +160,15 @@ class DocNode
    virtual ~DocNode()
    { }
 
+   // nodes are placed in the arena of the active DocNodeArenaScope
+   static void *operator new(size_t size) {
+      return DocNodeArena::allocate(size);
+   }
+
+   static void operator delete(void *ptr) {
+      DocNodeArena::release(ptr);
+   }
+
    // Returns the kind of node. Provides runtime type information
    virtual Kind kind() const = 0;
 
@@ -212,16 +225,16 @@ class CompAccept
       v->visitPost(obj);
    }
 
-   const QList<DocNode *> &children() const {
+   const DocNodeList &children() const {
       return m_children;
    }
 
-   QList<DocNode *> &children() {
+   DocNodeList &children() {
       return m_children;
    }
 
  protected:
-   QList<DocNode *> m_children;
+   DocNodeList m_children;
 };
 
 // Node representing a word
@@ -771,11 +784,11 @@ class DocVerbatim : public DocNode
       return m_height;
    }
 
-   const QList<DocNode *> &children() const {
+   const DocNodeList &children() const {
       return m_children;
    }
 
-   QList<DocNode *> &children() {
+   DocNodeList &children() {
       return m_children;
    }
 
@@ -806,7 +819,7 @@ class DocVerbatim : public DocNode
 
    QString m_width;
    QString m_height;
-   QList<DocNode *> m_children;
+   DocNodeList m_children;
 };
 
 // Node representing an included text block from file
@@ -1104,7 +1117,7 @@ class DocCopy : public DocNode
       /*CompAccept<DocCopy>::accept(this,v);*/
    }
 
-   void parse(QList<DocNode *> &children);
+   void parse(DocNodeList &children);
 
  private:
    QString  m_link;
@@ -2136,11 +2149,11 @@ class DocParamList : public DocNode
       return Kind_ParamList;
    }
 
-   const QList<DocNode *> &parameters() {
+   const DocNodeList &parameters() {
       return m_params;
    }
 
-   const QList<DocNode *> &paramTypes() {
+   const DocNodeList &paramTypes() {
       return m_paramTypes;
    }
 
@@ -2183,8 +2196,8 @@ class DocParamList : public DocNode
 
  private:
    QList<DocPara *>        m_paragraphs;
-   QList<DocNode *>        m_params;
-   QList<DocNode *>        m_paramTypes;
+   DocNodeList        m_params;
+   DocNodeList        m_paramTypes;
    DocParamSect::Type      m_type;
    DocParamSect::Direction m_dir;
    bool                    m_isFirst;
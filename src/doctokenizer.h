@@ -122,8 +122,7 @@ struct TokenInfo {
 };
 
 // globals
-extern TokenInfo *g_token;
-extern FILE *doctokenizerYYin;
+extern thread_local TokenInfo *g_token;
 
 // helper functions
 QString tokToString(int token);
@@ -24,6 +24,7 @@
 #include <config.h>
 #include <default_args.h>
 #include <docparser.h>
+#include <dotlayout.h>
 #include <doxy_globals.h>
 #include <groupdef.h>
 #include <language.h>
@@ -33,9 +34,16 @@
 #include <sortedlist.h>
 #include <util.h>
 
+#include <QBuffer>
 #include <QCryptographicHash>
+#include <QDateTime>
 #include <QDir>
+#include <QElapsedTimer>
 #include <QFile>
+#include <QProcess>
+#include <QSaveFile>
+
+#include <algorithm>
 
 #include <stdlib.h>
 
@@ -48,6 +56,22 @@ int DotGroupCollaboration::m_curNodeNumber = 0;
 
 std::mutex DotRunner::m_output_mutex;
 
+QString       DotCache::m_dirName;
+QByteArray    DotCache::m_dotVersion;
+QSet<QString> DotCache::m_usedKeys;
+QMutex        DotCache::m_mutex;
+
+QString                           DotProfile::m_fileName;
+QHash<QString, qint64>            DotProfile::m_lastTimes;
+QList<DotProfile::Timing>         DotProfile::m_timings;
+QMutex                            DotProfile::m_mutex;
+
+QHash<const ClassDef *, QVector<DotGraphCache::ClassEdge>>   DotGraphCache::m_inheritanceEdges[2];
+QHash<const ClassDef *, QVector<DotGraphCache::ClassEdge>>   DotGraphCache::m_collaborationEdges[2];
+QHash<const FileDef *, QVector<DotGraphCache::IncludeEdge>>  DotGraphCache::m_includeEdges[2];
+QHash<const MemberDef *, QVector<DotGraphCache::CallEdge>>   DotGraphCache::m_callEdges[2];
+QMutex                                                       DotGraphCache::m_mutex;
+
 #define MAP_CMD "cmapx"
 
 //#define FONTNAME "Helvetica"
@@ -371,30 +395,48 @@ static QString replaceRef(const QString &buf, const QString relPath, bool urlOnl
 static bool convertMapFile(QTextStream &t, const QString &mapName, const QString &relPath, bool urlOnly = false,
                            const QString &context = QString())
 {
+   static QMutex logMutex;
    static int logCount = 0;
-   QFile f(mapName);
 
-   if (! f.open(QIODevice::ReadOnly)) {
+   QByteArray mapData;
 
-      if (logCount < 3) {
-         ++logCount;
+   if (DotLayout::takeMap(mapName, mapData)) {
+      // map was rendered in process, no need to read the file back
 
-         errNoPrefixAll("\n");
-         errAll("Unable to open dot map file %s\n"
-                  "If dot was installed after a previous issue, delete the output directory and run DoxyPress again\n",
-                   csPrintable(mapName));
+   } else {
+      QFile f(mapName);
+
+      if (f.open(QIODevice::ReadOnly)) {
+         mapData = f.readAll();
+         f.close();
 
-      } else if (logCount == 3) {
-         ++logCount;
-         errNoPrefixAll("\n** Suppressing further messages regarding dot map file\n\n");
+      } else {
+         // files are patched by several threads
+         QMutexLocker locker(&logMutex);
 
-      }
+         if (logCount < 3) {
+            ++logCount;
 
-      return false;
+            errNoPrefixAll("\n");
+            errAll("Unable to open dot map file %s\n"
+                     "If dot was installed after a previous issue, delete the output directory and run DoxyPress again\n",
+                      csPrintable(mapName));
+
+         } else if (logCount == 3) {
+            ++logCount;
+            errNoPrefixAll("\n** Suppressing further messages regarding dot map file\n\n");
+
+         }
+
+         return false;
+      }
    }
 
-   while (! f.atEnd()) {
-      QByteArray buf = f.readLine();
+   QBuffer buffer(&mapData);
+   buffer.open(QIODevice::ReadOnly);
+
+   while (! buffer.atEnd()) {
+      QByteArray buf = buffer.readLine();
 
       if (buf.startsWith("<area")) {
          QString replaceBuffer = replaceRef(buf, relPath, urlOnly, context);
@@ -511,6 +553,11 @@ static bool writeVecGfxFigure(QTextStream &out, const QString &baseName, const Q
    int width  = 400;
    int height = 550;
 
+   if (DotManager::instance()->isInFlight(figureName + (usePdfLatex ? ".pdf" : ".eps"))) {
+      // still being rendered, the figure is inserted when the output is patched
+      return false;
+   }
+
    if (usePdfLatex) {
       if (! readBoundingBox(figureName + ".pdf", &width, &height, false)) {
          return false;
@@ -600,6 +647,11 @@ static bool writeSVGFigureLink(QTextStream &out, const QString &relPath, const Q
    int width  = 600;
    int height = 600;
 
+   if (DotManager::instance()->isInFlight(absImgName)) {
+      // the file may be partially written or not yet patched
+      return false;
+   }
+
    if (! readSVGSize(absImgName, &width, &height)) {
       return false;
    }
@@ -679,7 +731,7 @@ static bool insertMapFile(QTextStream &out, const QString &mapFile, const QStrin
 {
    QFileInfo fi(mapFile);
 
-   if (fi.exists() && fi.size() > 0) {
+   if (fi.exists() && fi.size() > 0 && ! DotManager::instance()->isInFlight(mapFile)) {
       // reuse existing map file
 
       QString tmpstr;
@@ -746,14 +798,15 @@ static bool checkDeliverables(const QString &file1, const QString &file2 = QStri
    bool file1Ok = true;
    bool file2Ok = true;
 
+   // a file which is still being rendered or patched is not available
    if (! file1.isEmpty()) {
       QFileInfo fi(file1);
-      file1Ok = (fi.exists() && fi.size() > 0);
+      file1Ok = (fi.exists() && fi.size() > 0 && ! DotManager::instance()->isInFlight(file1));
    }
 
    if (! file2.isEmpty()) {
       QFileInfo fi(file2);
-      file2Ok = (fi.exists() && fi.size() > 0);
+      file2Ok = (fi.exists() && fi.size() > 0 && ! DotManager::instance()->isInFlight(file2));
    }
    return file1Ok && file2Ok;
 }
@@ -767,6 +820,229 @@ int DotNode::findParent(DotNode *n)
    return m_parents->indexOf(n);
 }
 
+void DotCache::setDirectory(const QString &dirName)
+{
+   static const QString dotPath = Config::getString("dot-path");
+
+   // images from a different version of dot are not reused, the version is written to stderr
+   QProcess task;
+   task.start(dotPath, QStringList() << "-V");
+   task.waitForFinished(-1);
+
+   m_dotVersion = task.readAllStandardError().trimmed();
+   m_dirName    = dirName;
+}
+
+QString DotCache::key(const QByteArray &dotSource, const QString &format)
+{
+   QCryptographicHash hash(QCryptographicHash::Md5);
+
+   hash.addData(m_dotVersion);
+   hash.addData(QByteArray(1, '\0'));
+   hash.addData(portable_getenv("DOTFONTPATH").toUtf8());
+   hash.addData(QByteArray(1, '\0'));
+   hash.addData(format.toUtf8());
+   hash.addData(QByteArray(1, '\0'));
+   hash.addData(dotSource);
+
+   return QString::fromLatin1(hash.result().toHex());
+}
+
+bool DotCache::fetch(const QString &key, const QString &output)
+{
+   QString cacheName = m_dirName + "/" + key;
+
+   if (! QFile::exists(cacheName)) {
+      return false;
+   }
+
+   QFile::remove(output);
+
+   if (! QFile::copy(cacheName, output)) {
+      return false;
+   }
+
+   QMutexLocker locker(&m_mutex);
+   m_usedKeys.insert(key);
+
+   return true;
+}
+
+void DotCache::store(const QString &key, const QString &output)
+{
+   QString cacheName = m_dirName + "/" + key;
+
+   // several worker threads may store the same graph, copy to a unique name first
+   QString tmpName = cacheName + "." + QString::number(reinterpret_cast<quintptr>(QThread::currentThreadId())) + ".tmp";
+
+   QFile::remove(tmpName);
+
+   if (QFile::copy(output, tmpName)) {
+      QFile::remove(cacheName);
+      QFile::rename(tmpName, cacheName);
+
+      QMutexLocker locker(&m_mutex);
+      m_usedKeys.insert(key);
+   }
+}
+
+void DotCache::prune()
+{
+   if (m_dirName.isEmpty()) {
+      return;
+   }
+
+   // other projects or configurations may share the directory, their files are kept for a while
+   static const qint64 maxAge = 7 * 24 * 60 * 60;
+
+   QMutexLocker locker(&m_mutex);
+
+   const QDateTime now = QDateTime::currentDateTime();
+   const QFileInfoList fileList = QDir(m_dirName).entryInfoList(QDir::Files);
+
+   for (const auto &fi : fileList) {
+      // temporary files left by an interrupted run have the key as base name
+      QString key = fi.baseName();
+
+      if (key == "profile" || m_usedKeys.contains(key)) {
+         continue;
+      }
+
+      if (fi.lastModified().secsTo(now) > maxAge) {
+         QFile::remove(fi.absoluteFilePath());
+      }
+   }
+}
+
+// graphs with the same file name are written to each output format, the profile uses the path in output-dir
+static QString profileName(const QString &dotFile)
+{
+   static const QString outputDir = Config::getString("output-dir");
+   return QDir(outputDir).relativeFilePath(QFileInfo(dotFile).absoluteFilePath());
+}
+
+void DotProfile::load(const QString &fileName)
+{
+   QMutexLocker locker(&m_mutex);
+
+   m_fileName = fileName;
+
+   QFile f(m_fileName);
+
+   if (! f.open(QIODevice::ReadOnly)) {
+      return;
+   }
+
+   // each line holds the time in ms and the name of the dot file, separated by a tab
+   while (! f.atEnd()) {
+      QString line = QString::fromUtf8(f.readLine()).trimmed();
+      int pos      = line.indexOf('\t');
+
+      if (pos > 0) {
+         m_lastTimes.insert(line.mid(pos + 1), line.left(pos).toLongLong());
+      }
+   }
+}
+
+void DotProfile::save()
+{
+   QMutexLocker locker(&m_mutex);
+
+   if (m_fileName.isEmpty() || m_timings.isEmpty()) {
+      return;
+   }
+
+   for (const auto &item : m_timings) {
+      m_lastTimes.insert(item.name, item.ms);
+   }
+
+   QFile f(m_fileName);
+
+   if (! f.open(QIODevice::WriteOnly)) {
+      err("Unable to write dot profile %s, OS Error #: %d\n", csPrintable(m_fileName), f.error());
+      return;
+   }
+
+   QTextStream t(&f);
+
+   for (auto iter = m_lastTimes.begin(); iter != m_lastTimes.end(); ++iter) {
+      t << iter.value() << "\t" << iter.key() << "\n";
+   }
+}
+
+qint64 DotProfile::lastTime(const QString &dotFile)
+{
+   QMutexLocker locker(&m_mutex);
+   return m_lastTimes.value(profileName(dotFile), -1);
+}
+
+void DotProfile::record(const QString &dotFile, qint64 ms, bool degraded)
+{
+   QMutexLocker locker(&m_mutex);
+
+   Timing item;
+   item.name     = profileName(dotFile);
+   item.ms       = ms;
+   item.degraded = degraded;
+
+   m_timings.append(item);
+}
+
+void DotProfile::printSlowest(int count)
+{
+   QMutexLocker locker(&m_mutex);
+
+   if (m_timings.isEmpty()) {
+      return;
+   }
+
+   QList<Timing> list = m_timings;
+
+   std::sort(list.begin(), list.end(), [](const Timing &a, const Timing &b) {
+      return a.ms > b.ms;
+   });
+
+   msg("Slowest dot graphs:\n");
+
+   for (int i = 0; i < qMin(count, list.count()); ++i) {
+      const Timing &item = list.at(i);
+      msg("  %8.3f sec  %s%s\n", item.ms / 1000.0, csPrintable(item.name), item.degraded ? "  (timeout, simplified layout)" : "");
+   }
+}
+
+// runs dot, returns -2 when the process was stopped after dot-timeout seconds for each of the graphs
+static int runDotProcess(const QString &dotExe, const QString &dotArgs, int numGraphs = 1)
+{
+   static const int dotTimeout = Config::getInt("dot-timeout");
+
+   if (dotTimeout == 0) {
+      return portable_system(dotExe, dotArgs, false);
+   }
+
+   QProcess task;
+   task.start("\"" + dotExe + "\" " + dotArgs);
+
+   if (! task.waitForStarted()) {
+      return -1;
+   }
+
+   // the limit of a large batch is capped at one day, waitForFinished() takes an int
+   qint64 msecs = qMin(qint64(dotTimeout) * 1000 * numGraphs, qint64(24 * 60 * 60 * 1000));
+
+   if (! task.waitForFinished(int(msecs))) {
+      task.kill();
+      task.waitForFinished(-1);
+
+      return -2;
+   }
+
+   if (task.exitStatus() != QProcess::NormalExit) {
+      return -1;
+   }
+
+   return task.exitCode();
+}
+
 DotRunner::DotRunner(const QString &file, const QString &path, bool checkResult, const QString &imageName)
    : m_file(file), m_path(path), m_imageName(imageName), m_checkResult(checkResult)
 {
@@ -781,8 +1057,11 @@ DotRunner::DotRunner(const QString &file, const QString &path, bool checkResult,
 
 void DotRunner::addJob(const QString &format, const QString &output)
 {
-   QString args = "-T" + format + " -o \"" + output + "\"";
-   m_jobs.append(args);
+   DotJob job;
+   job.format = format;
+   job.output = output;
+
+   m_jobs.append(job);
 }
 
 void DotRunner::addPostProcessing(const  QString &cmd, const  QString &args)
@@ -791,35 +1070,107 @@ void DotRunner::addPostProcessing(const  QString &cmd, const  QString &args)
    m_postArgs = args;
 }
 
-bool DotRunner::run()
+bool DotRunner::runJobs(const QList<DotJob> &jobs, int &exitCode, QString &dotArgs)
 {
-   static int logCount = 0;
+   if (jobs.isEmpty()) {
+      return true;
+   }
 
-   int exitCode = 0;
-   QString dotArgs;
+   if (DotLayout::isAvailable() && DotLayout::render(m_source, jobs)) {
+      // rendered in process by the graphviz library
+      return true;
+   }
+
+   // after a timeout the graph is laid out again with fewer ranking and crossing iterations and straight edges
+   static const QString degradedArgs = " -Gnslimit=1 -Gnslimit1=1 -Gmclimit=0.1 -Gsplines=line";
 
    if (m_multiTargets) {
       dotArgs = "\"" + m_file + "\"";
 
-      for (auto s : m_jobs) {
-         dotArgs += ' ';
-         dotArgs += s;
+      for (const auto &job : jobs) {
+         dotArgs += " -T" + job.format + " -o \"" + job.output + "\"";
+      }
+
+      if (m_degraded) {
+         dotArgs += degradedArgs;
       }
 
-      if ((exitCode = portable_system(m_dotExe, dotArgs, false)) != 0) {
-         goto error;
+      exitCode = runDotProcess(m_dotExe, dotArgs);
+
+      if (exitCode == -2 && ! m_degraded) {
+         m_degraded = true;
+         return runJobs(jobs, exitCode, dotArgs);
+      }
+
+      if (exitCode != 0) {
+         return false;
       }
 
    } else {
-      for (auto s : m_jobs) {
-         dotArgs = "\"" + m_file + "\" " + s;
+      for (const auto &job : jobs) {
+         dotArgs = "\"" + m_file + "\" -T" + job.format + " -o \"" + job.output + "\"";
 
-         if ((exitCode = portable_system(m_dotExe, dotArgs, false)) != 0) {
-            goto error;
+         if (m_degraded) {
+            dotArgs += degradedArgs;
+         }
+
+         exitCode = runDotProcess(m_dotExe, dotArgs);
+
+         if (exitCode == -2 && ! m_degraded) {
+            m_degraded = true;
+            return runJobs(jobs, exitCode, dotArgs);
+         }
+
+         if (exitCode != 0) {
+            return false;
          }
       }
    }
 
+   return true;
+}
+
+void DotRunner::fetchCached(QList<DotJob> &jobs, QStringList &cacheKeys)
+{
+   jobs = m_jobs;
+   cacheKeys.clear();
+
+   if (m_source.isEmpty() && (DotCache::isEnabled() || DotLayout::isAvailable())) {
+      // graph was not passed by the caller, read it once for the cache key and the graphviz library
+      QFile f(m_file);
+
+      if (f.open(QIODevice::ReadOnly)) {
+         m_source = f.readAll();
+         f.close();
+      }
+   }
+
+   if (DotCache::isEnabled() && ! m_source.isEmpty()) {
+      // only run dot for the outputs which are not in the cache
+      jobs.clear();
+
+      for (const auto &job : m_jobs) {
+         QString key = DotCache::key(m_source, job.format);
+
+         if (! DotCache::fetch(key, job.output)) {
+            jobs.append(job);
+            cacheKeys.append(key);
+         }
+      }
+   }
+}
+
+bool DotRunner::finish(const QList<DotJob> &jobs, const QStringList &cacheKeys)
+{
+   if (! jobs.isEmpty()) {
+      DotProfile::record(m_file, m_elapsed, m_degraded);
+   }
+
+   // a simplified layout is not stored, the next run tries the full layout again
+   for (int i = 0; i < cacheKeys.count() && ! m_degraded; ++i) {
+      DotCache::store(cacheKeys[i], jobs[i].output);
+   }
+
    if (! m_postCmd.isEmpty() && portable_system(m_postCmd, m_postArgs) != 0) {
       std::lock_guard<std::mutex> lock(m_output_mutex);
 
@@ -837,8 +1188,12 @@ bool DotRunner::run()
    }
 
    return true;
+}
+
+void DotRunner::reportError(int exitCode, const QString &dotArgs)
+{
+   static int logCount = 0;
 
-error:
    std::lock_guard<std::mutex> lock(m_output_mutex);
 
    if (logCount < 3) {
@@ -847,6 +1202,9 @@ error:
       if (exitCode == -1) {
          errAll("Unable to run '%s', most likely the Dot program was not found\n", csPrintable(m_dotExe));
 
+      } else if (exitCode == -2) {
+         errAll("Dot did not finish within dot-timeout seconds, graph %s was not generated\n", csPrintable(m_file));
+
       } else  {
          errNoPrefixAll("\n");
          errAll("Unable to run '%s', exit code = %d\nArguments = '%s'\n", csPrintable(m_dotExe),
@@ -858,8 +1216,216 @@ error:
       errNoPrefixAll("\n** Suppressing further messages regarding dot program execution\n\n");
 
    }
+}
 
-   return false;
+bool DotRunner::run()
+{
+   int exitCode = 0;
+   QString dotArgs;
+
+   QList<DotJob> jobs;
+   QStringList cacheKeys;
+
+   fetchCached(jobs, cacheKeys);
+
+   QElapsedTimer timer;
+   timer.start();
+
+   if (! runJobs(jobs, exitCode, dotArgs)) {
+      reportError(exitCode, dotArgs);
+      return false;
+   }
+
+   m_elapsed = timer.elapsed();
+   m_source.clear();
+
+   return finish(jobs, cacheKeys);
+}
+
+bool DotRunner::isBatchable() const
+{
+   if (DotLayout::isAvailable()) {
+      // no process is started when the graphviz library is used
+      return false;
+   }
+
+   // dot names the output of a batch after the input file and the format
+   QSet<QString> formats;
+
+   for (const auto &job : m_jobs) {
+      if (formats.contains(job.format)) {
+         return false;
+      }
+
+      formats.insert(job.format);
+   }
+
+   return m_postCmd.isEmpty() && ! m_jobs.isEmpty();
+}
+
+QStringList DotRunner::outputs() const
+{
+   QStringList retval;
+
+   for (const auto &job : m_jobs) {
+      retval.append(job.output);
+   }
+
+   return retval;
+}
+
+QStringList DotRunner::files() const
+{
+   QStringList retval = outputs();
+   retval.append(m_file);
+
+   return retval;
+}
+
+qint64 DotRunner::sourceSize() const
+{
+   return QFileInfo(m_file).size();
+}
+
+qint64 DotRunner::estimatedCost() const
+{
+   qint64 retval = DotProfile::lastTime(m_file);
+
+   if (retval < 0) {
+      // no timing from a previous run, the source grows with the number of nodes and edges
+      retval = sourceSize() / 256;
+   }
+
+   return retval;
+}
+
+void DotRunner::runBatch(const QList<DotRunner *> &runners)
+{
+   if (runners.count() == 1) {
+      runners.first()->run();
+      return;
+   }
+
+   struct Pending {
+      DotRunner     *runner;
+      QList<DotJob>  jobs;
+      QStringList    cacheKeys;
+      bool           failed;
+   };
+
+   QList<Pending> pending;
+
+   for (auto runner : runners) {
+      Pending item;
+      item.runner = runner;
+      item.failed = false;
+
+      runner->fetchCached(item.jobs, item.cacheKeys);
+
+      if (item.jobs.isEmpty()) {
+         runner->finish(item.jobs, item.cacheKeys);
+      } else {
+         pending.append(item);
+      }
+   }
+
+   if (pending.isEmpty()) {
+      return;
+   }
+
+   const QString dotExe = pending.first().runner->m_dotExe;
+
+   // the time of each dot process is shared by the graphs based on the size of their source
+   QElapsedTimer timer;
+   timer.start();
+
+   qint64 totalSize = 0;
+   QVector<qint64> sizeList;
+
+   for (const auto &item : pending) {
+      qint64 size = item.runner->sourceSize();
+
+      sizeList.append(size);
+      totalSize += size;
+   }
+
+   // collect the input files for each format, one dot process handles all files of a format
+   QStringList formatList;
+   QHash<QString, QList<int>> filesPerFormat;
+
+   for (int i = 0; i < pending.count(); ++i) {
+      for (const auto &job : pending[i].jobs) {
+         if (! filesPerFormat.contains(job.format)) {
+            formatList.append(job.format);
+         }
+
+         filesPerFormat[job.format].append(i);
+      }
+   }
+
+   for (const auto &format : formatList) {
+      const QList<int> &fileList = filesPerFormat[format];
+
+      QString dotArgs = "-T" + format + " -O";
+
+      for (int i : fileList) {
+         dotArgs += " \"" + pending[i].runner->m_file + "\"";
+      }
+
+      // dot-timeout is the limit for one graph, the batch gets the sum of the limits of its graphs
+      if (runDotProcess(dotExe, dotArgs, fileList.count()) != 0) {
+         // find the graphs which failed or took too long by running them on their own
+         for (int i : fileList) {
+            pending[i].failed = true;
+         }
+
+         continue;
+      }
+
+      // -O writes the output next to the input file, with the parts of the format appended in reverse order
+      QStringList formatParts = format.split(':');
+      std::reverse(formatParts.begin(), formatParts.end());
+
+      QString suffix = formatParts.join(".");
+
+      for (int i : fileList) {
+         QString batchOutput = pending[i].runner->m_file + "." + suffix;
+
+         for (const auto &job : pending[i].jobs) {
+            if (job.format == format && job.output != batchOutput) {
+               QFile::remove(job.output);
+
+               if (! QFile::rename(batchOutput, job.output)) {
+                  pending[i].failed = true;
+               }
+            }
+         }
+      }
+   }
+
+   qint64 batchTime = timer.elapsed();
+
+   for (int i = 0; i < pending.count(); ++i) {
+      Pending &item = pending[i];
+
+      item.runner->m_elapsed = batchTime * sizeList[i] / qMax(totalSize, qint64(1));
+
+      if (item.failed) {
+         int exitCode = 0;
+         QString dotArgs;
+
+         timer.restart();
+
+         if (! item.runner->runJobs(item.jobs, exitCode, dotArgs)) {
+            item.runner->reportError(exitCode, dotArgs);
+            continue;
+         }
+
+         item.runner->m_elapsed = timer.elapsed();
+      }
+
+      item.runner->finish(item.jobs, item.cacheKeys);
+   }
 }
 
 DotFilePatcher::DotFilePatcher(const QString &patchFile)
@@ -956,33 +1522,17 @@ bool DotFilePatcher::run()
       relPath = map.relPath;
    }
 
-   QString tmpName   = m_patchFile + ".tmp";
-   QString patchFile = m_patchFile;
-
-   if (QDir::current().exists(tmpName)) {
-      // remove old tmp file
-      QDir::current().remove(tmpName);
-   }
-
-   if (! QDir::current().rename(patchFile, tmpName)) {
-      err("Unable to rename file %s to %s\n", csPrintable(m_patchFile), csPrintable(tmpName));
-      return false;
-   }
-
-   QFile fi(tmpName);
-   QFile fo(patchFile);
+   // the patched file is written to a temporary file which atomically replaces the original on commit
+   QFile fi(m_patchFile);
+   QSaveFile fo(m_patchFile);
 
    if (! fi.open(QIODevice::ReadOnly)) {
-      err("Unable to open file for updating %s, OS Error #: %d\n", csPrintable(tmpName), fi.error());
-
-      QDir::current().rename(tmpName, patchFile);
+      err("Unable to open file for updating %s, OS Error #: %d\n", csPrintable(m_patchFile), fi.error());
       return false;
    }
 
    if (! fo.open(QIODevice::WriteOnly)) {
       err("Unable to open file for updating %s, OS Error #: %d\n", csPrintable(m_patchFile), fo.error());
-
-      QDir::current().rename(tmpName, patchFile);
       return false;
    }
 
@@ -1101,6 +1651,9 @@ bool DotFilePatcher::run()
 
             if (! writeVecGfxFigure(t, map.label, map.mapFile)) {
                err("Unable to write FIG %d figure, verify if the dot program is installed\n", mapId);
+
+               fo.cancelWriting();
+
                return false;
             }
 
@@ -1125,19 +1678,24 @@ bool DotFilePatcher::run()
       QString orgName = m_patchFile.left(m_patchFile.length() - 4) + "_org.svg";
 
       t << substitute(svgZoomFooter, "$orgname", stripPath(orgName));
-      fo.close();
 
       // keep original SVG file so we can refer to it, need to replace dummy link with real one
-      QFile fileIn(tmpName);
+      QFile fileIn(m_patchFile);
       QFile fileOut(orgName);
 
       if (! fileIn.open(QIODevice::ReadOnly)) {
-         err("Unable to open file %s for reading, OS Error #: %d\n", csPrintable(tmpName), fileIn.error());
+         err("Unable to open file %s for reading, OS Error #: %d\n", csPrintable(m_patchFile), fileIn.error());
+
+         fo.cancelWriting();
+
          return false;
       }
 
       if (! fileOut.open(QIODevice::WriteOnly)) {
          err("Unable to open file %s for writing, OS error #: %d\n", csPrintable(orgName), fileOut.error());
+
+         fo.cancelWriting();
+
          return false;
       }
 
@@ -1159,21 +1717,46 @@ bool DotFilePatcher::run()
       fileOut.close();
    }
 
-   // remove temporary file
-   QDir::current().remove(tmpName);
+   t.flush();
+
+   // the original is only replaced once the patched file is complete
+   if (! fo.commit()) {
+      err("Unable to write file %s, OS Error #: %d\n", csPrintable(m_patchFile), fo.error());
+      return false;
+   }
 
    return true;
 }
 
-void DotRunnerQueue::enqueue(DotRunner *runner)
+void DotRunnerQueue::enqueue(const QList<DotRunner *> &batch)
 {
+   Item item;
+   item.cost  = 0;
+   item.batch = batch;
+
+   if (batch.isEmpty()) {
+      // terminators go after all work
+      item.cost = -1;
+   }
+
+   for (auto runner : batch) {
+      item.cost += runner->estimatedCost();
+   }
+
    QMutexLocker locker(&m_mutex);
 
-   m_queue.enqueue(runner);
+   // keep the queue sorted by cost so a large graph does not end up running alone at the end
+   auto iter = std::upper_bound(m_queue.begin(), m_queue.end(), item, [](const Item &a, const Item &b) {
+      return a.cost > b.cost;
+   });
+
+   m_queue.insert(iter, item);
+   m_runnerCount += batch.count();
+
    m_bufferNotEmpty.wakeAll();
 }
 
-DotRunner *DotRunnerQueue::dequeue()
+QList<DotRunner *> DotRunnerQueue::dequeue()
 {
    QMutexLocker locker(&m_mutex);
 
@@ -1182,7 +1765,8 @@ DotRunner *DotRunnerQueue::dequeue()
       m_bufferNotEmpty.wait(&m_mutex);
    }
 
-   DotRunner *result = m_queue.dequeue();
+   QList<DotRunner *> result = m_queue.takeFirst().batch;
+   m_runnerCount -= result.count();
 
    return result;
 }
@@ -1190,7 +1774,7 @@ DotRunner *DotRunnerQueue::dequeue()
 uint DotRunnerQueue::count() const
 {
    QMutexLocker locker(&m_mutex);
-   return m_queue.count();
+   return m_runnerCount;
 }
 
 
@@ -1201,14 +1785,19 @@ DotWorkerThread::DotWorkerThread(DotRunnerQueue *queue)
 
 void DotWorkerThread::run()
 {
-   DotRunner *runner;
+   QList<DotRunner *> batch;
+
+   while (! (batch = m_queue->dequeue()).isEmpty()) {
+      DotRunner::runBatch(batch);
 
-   while ((runner = m_queue->dequeue())) {
-      runner->run();
-      DotRunner::CleanupItem cleanup = runner->cleanup();
+      for (auto runner : batch) {
+         DotManager::instance()->runFinished(runner);
 
-      if (! cleanup.file.isEmpty()) {
-         m_cleanupItems.append(cleanup);
+         DotRunner::CleanupItem cleanup = runner->cleanup();
+
+         if (! cleanup.file.isEmpty()) {
+            m_cleanupItems.append(cleanup);
+         }
       }
    }
 }
@@ -1220,10 +1809,32 @@ void DotWorkerThread::cleanup()
    }
 }
 
+DotPatcherThread::DotPatcherThread(const QList<QSharedPointer<DotFilePatcher>> &list, int first, int step,
+                  int offset, int total)
+   : m_list(list), m_first(first), m_step(step), m_offset(offset), m_total(total)
+{
+}
+
+void DotPatcherThread::run()
+{
+   for (int i = m_first; i < m_list.count(); i += m_step) {
+      const auto &patcher = m_list.at(i);
+
+      msg("Patching output file %d/%d %s\n", m_offset + i + 1, m_total, csPrintable(patcher->file()));
+
+      if (! patcher->run()) {
+         m_result = false;
+      }
+   }
+}
+
 DotManager *DotManager::m_theInstance = nullptr;
 
 DotManager *DotManager::instance()
 {
+   static QMutex instanceMutex;
+   QMutexLocker locker(&instanceMutex);
+
    if (!m_theInstance) {
       m_theInstance = new DotManager;
    }
@@ -1257,6 +1868,24 @@ DotManager::DotManager()
 
       assert(m_workers.count() > 0);
    }
+
+   // graphs are rendered while the output pages are still being written, set the font path up front
+   if (Config::getBool("generate-html")) {
+      setDotFontPath(Config::getString("html-output"));
+      m_fontPathSet = true;
+
+   } else if (Config::getBool("generate-docbook")) {
+      setDotFontPath(Config::getString("docbook-output"));
+      m_fontPathSet = true;
+
+   } else if (Config::getBool("generate-latex")) {
+      setDotFontPath(Config::getString("latex-output"));
+      m_fontPathSet = true;
+
+   } else if (Config::getBool("generate-rtf")) {
+      setDotFontPath(Config::getString("rtf-output"));
+      m_fontPathSet = true;
+   }
 }
 
 DotManager::~DotManager()
@@ -1266,12 +1895,172 @@ DotManager::~DotManager()
 
 void DotManager::addRun(DotRunner *run)
 {
+   QMutexLocker locker(&m_mutex);
    m_dotRuns.append(run);
+
+   if (m_workers.isEmpty()) {
+      return;
+   }
+
+   const QStringList files = run->files();
+
+   for (const auto &file : files) {
+      ++m_inFlight[file];
+      m_lastRun.insert(file, run);
+   }
+
+   ++m_pendingRuns;
+
+   for (const auto &file : files) {
+      if (m_activeFiles.contains(file)) {
+         // the same graph is rendered again, wait until the first run has finished
+         m_deferredRuns.append(run);
+         return;
+      }
+   }
+
+   for (const auto &file : files) {
+      m_activeFiles.insert(file);
+   }
+
+   // start rendering while the remaining pages are generated
+   queueRun(run);
+}
+
+bool DotManager::isInFlight(const QString &file)
+{
+   QMutexLocker locker(&m_mutex);
+   return m_inFlight.value(file) > 0;
+}
+
+int DotManager::pendingRuns()
+{
+   QMutexLocker locker(&m_mutex);
+   return m_pendingRuns;
+}
+
+bool DotManager::isPatched(const QString &file) const
+{
+   DotRunner *run = m_patchedBy.value(file);
+   return run != nullptr && run == m_lastRun.value(file);
+}
+
+void DotManager::startDeferredRuns()
+{
+   for (auto iter = m_deferredRuns.begin(); iter != m_deferredRuns.end(); ) {
+      DotRunner *run = *iter;
+      const QStringList files = run->files();
+
+      bool isFree = true;
+
+      for (const auto &file : files) {
+         if (m_activeFiles.contains(file)) {
+            isFree = false;
+            break;
+         }
+      }
+
+      if (isFree) {
+         for (const auto &file : files) {
+            m_activeFiles.insert(file);
+         }
+
+         // not batched, the last partial batch may already have been queued
+         m_queue->enqueue(QList<DotRunner *>() << run);
+         iter = m_deferredRuns.erase(iter);
+
+      } else {
+         ++iter;
+      }
+   }
+}
+
+void DotManager::queueRun(DotRunner *run)
+{
+   // same limits as createBatches(), the number of runs is not known yet so the batch count is fixed
+   static const qint64 maxBatchSource = 64 * 1024;
+   static const qint64 maxSourceSize  = 8 * 1024;
+   static const int    maxBatchCount  = 16;
+
+   qint64 size = run->sourceSize();
+
+   if (! run->isBatchable() || size > maxSourceSize) {
+      m_queue->enqueue(QList<DotRunner *>() << run);
+      return;
+   }
+
+   if (! m_pendingBatch.isEmpty() && m_pendingSource + size > maxBatchSource) {
+      flushPendingBatch();
+   }
+
+   m_pendingBatch.append(run);
+   m_pendingSource += size;
+
+   if (m_pendingBatch.count() >= maxBatchCount) {
+      flushPendingBatch();
+   }
+}
+
+void DotManager::flushPendingBatch()
+{
+   if (! m_pendingBatch.isEmpty()) {
+      m_queue->enqueue(m_pendingBatch);
+   }
+
+   m_pendingBatch.clear();
+   m_pendingSource = 0;
+}
+
+void DotManager::runFinished(DotRunner *runner)
+{
+   // patch the svg files of this graph right away, html pages are patched at the end since
+   // they read the header of the patched svg and may still be written
+   for (const auto &output : runner->outputs()) {
+      if (! output.endsWith(".svg")) {
+         continue;
+      }
+
+      QSharedPointer<DotFilePatcher> snapshot;
+
+      {
+         QMutexLocker locker(&m_mutex);
+         QSharedPointer<DotFilePatcher> map = m_dotMaps.find(output);
+
+         if (! map || m_lastRun.value(output) != runner) {
+            // no conversion registered yet or the file will be rendered again, patched later
+            continue;
+         }
+
+         // conversions may still be added by the page writers while this copy is patched
+         snapshot = QMakeShared<DotFilePatcher>(*map);
+      }
+
+      if (snapshot->run()) {
+         QMutexLocker locker(&m_mutex);
+         m_patchedBy.insert(output, runner);
+      }
+   }
+
+   QMutexLocker locker(&m_mutex);
+
+   for (const auto &file : runner->files()) {
+      m_activeFiles.remove(file);
+
+      if (--m_inFlight[file] <= 0) {
+         m_inFlight.remove(file);
+      }
+   }
+
+   --m_pendingRuns;
+
+   startDeferredRuns();
 }
 
 int DotManager::addMap(const QString &file, const QString &mapFile,
                        const QString &relPath, bool urlOnly, const QString &context, const QString &label)
 {
+   QMutexLocker locker(&m_mutex);
+
    QSharedPointer<DotFilePatcher> map = m_dotMaps.find(file);
 
    if (! map) {
@@ -1284,6 +2073,8 @@ int DotManager::addMap(const QString &file, const QString &mapFile,
 
 int DotManager::addFigure(const QString &file, const QString &baseName, const QString &figureName, bool heightCheck)
 {
+   QMutexLocker locker(&m_mutex);
+
   QSharedPointer<DotFilePatcher> map = m_dotMaps.find(file);
 
    if (! map) {
@@ -1297,11 +2088,14 @@ int DotManager::addFigure(const QString &file, const QString &baseName, const QS
 int DotManager::addSVGConversion(const QString &file, const QString &relPath,
                                  bool urlOnly, const QString &context, bool zoomable,int graphId)
 {
+   QMutexLocker locker(&m_mutex);
+
    QSharedPointer<DotFilePatcher> map = m_dotMaps.find(file);
 
    if (! map) {
       map = QMakeShared<DotFilePatcher>(DotFilePatcher(file));
       m_dotMaps.insert(file, map);
+
    }
 
    return map->addSVGConversion(relPath, urlOnly, context, zoomable, graphId);
@@ -1309,6 +2103,8 @@ int DotManager::addSVGConversion(const QString &file, const QString &relPath,
 
 int DotManager::addSVGObject(const QString &file, const QString &baseName, const QString &absImgName, const QString &relPath)
 {
+   QMutexLocker locker(&m_mutex);
+
    QSharedPointer<DotFilePatcher> map = m_dotMaps.find(file);
 
    if (! map) {
@@ -1319,6 +2115,90 @@ int DotManager::addSVGObject(const QString &file, const QString &baseName, const
    return map->addSVGObject(baseName, absImgName, relPath);
 }
 
+QList<QList<DotRunner *>> DotManager::createBatches() const
+{
+   // starting dot costs more than laying out a small graph, small graphs share one dot process
+   static const qint64 maxBatchSource = 64 * 1024;
+   static const qint64 maxSourceSize  = 8 * 1024;
+
+   // keep enough batches for all worker threads
+   int maxBatchCount = m_dotRuns.count() / qMax(1, m_workers.count() * 4);
+   maxBatchCount     = qBound(1, maxBatchCount, 32);
+
+   QList<QList<DotRunner *>> retval;
+
+   QList<DotRunner *> batch;
+   qint64 batchSource = 0;
+
+   for (auto dr : m_dotRuns) {
+      qint64 size = dr->sourceSize();
+
+      if (! dr->isBatchable() || size > maxSourceSize) {
+         retval.append(QList<DotRunner *>() << dr);
+         continue;
+      }
+
+      if (! batch.isEmpty() && (batch.count() >= maxBatchCount || batchSource + size > maxBatchSource)) {
+         retval.append(batch);
+
+         batch.clear();
+         batchSource = 0;
+      }
+
+      batch.append(dr);
+      batchSource += size;
+   }
+
+   if (! batch.isEmpty()) {
+      retval.append(batch);
+   }
+
+   return retval;
+}
+
+bool DotManager::runPatchers(const QList<QSharedPointer<DotFilePatcher>> &list, int offset, int total)
+{
+   // each patcher writes its own file
+   int numThreads = qMin(m_workers.count(), list.count());
+
+   if (numThreads <= 1) {
+      bool retval = true;
+
+      for (int i = 0; i < list.count(); ++i) {
+         msg("Patching output file %d/%d %s\n", offset + i + 1, total, csPrintable(list.at(i)->file()));
+
+         if (! list.at(i)->run()) {
+            retval = false;
+         }
+      }
+
+      return retval;
+   }
+
+   QList<DotPatcherThread *> threads;
+
+   for (int i = 0; i < numThreads; ++i) {
+      DotPatcherThread *thread = new DotPatcherThread(list, i, numThreads, offset, total);
+      thread->start();
+
+      threads.append(thread);
+   }
+
+   bool retval = true;
+
+   for (auto thread : threads) {
+      thread->wait();
+
+      if (! thread->result()) {
+         retval = false;
+      }
+
+      delete thread;
+   }
+
+   return retval;
+}
+
 bool DotManager::run()
 {
    int numDotRuns = m_dotRuns.count();
@@ -1334,48 +2214,31 @@ bool DotManager::run()
       }
    }
 
-   int i = 1;
-   bool setPath = false;
-
-   if (Config::getBool("generate-html")) {
-      setDotFontPath(Config::getString("html-output"));
-      setPath = true;
-
-   } else if (Config::getBool("generate-docbook")) {
-      setDotFontPath(Config::getString("docbook-output"));
-      setPath = true;
-
-   } else if (Config::getBool("generate-latex")) {
-      setDotFontPath(Config::getString("latex-output"));
-      setPath = true;
-
-   } else if (Config::getBool("generate-rtf")) {
-      setDotFontPath(Config::getString("rtf-output"));
-      setPath = true;
-   }
+   int i = 1;
 
    portable_sysTimerStart();
 
-   // fill work queue with dot operations
    int prev = 1;
 
    if (m_workers.count() == 0) {
       // no threads to work with
+      QList<QList<DotRunner *>> batches = createBatches();
 
-      for (auto dr : m_dotRuns) {
+      for (const auto &batch : batches) {
          msg("Running dot for graph %d/%d\n", prev, numDotRuns);
-         dr->run();
-         prev++;
+         DotRunner::runBatch(batch);
+         prev += batch.count();
       }
 
    } else {
-      // use multiple threads to run instances of dot in parallel
-      for (auto dr : m_dotRuns) {
-         m_queue->enqueue(dr);
+      // runs were queued by addRun(), queue the last partial batch
+      {
+         QMutexLocker locker(&m_mutex);
+         flushPendingBatch();
       }
 
-      // wait for the queue to become empty
-      while ((i = m_queue->count()) > 0) {
+      // wait for all runs to finish, deferred runs are queued when the run before them is done
+      while ((i = pendingRuns()) > 0) {
          i = numDotRuns - i;
 
          while (i >= prev) {
@@ -1392,7 +2255,7 @@ bool DotManager::run()
 
       // signal the workers we are done
       for (i = 0; i < m_workers.count(); i++) {
-         m_queue->enqueue(nullptr); // add terminator for each worker
+         m_queue->enqueue(QList<DotRunner *>()); // add terminator for each worker
       }
 
       // wait for the workers to finish
@@ -1406,8 +2269,17 @@ bool DotManager::run()
       }
    }
    portable_sysTimerStop();
-   if (setPath) {
+
+   DotProfile::save();
+   DotCache::prune();
+
+   if (Doxy_Globals::infoLog_Stat.isEnabled()) {
+      DotProfile::printSlowest(10);
+   }
+
+   if (m_fontPathSet) {
       unsetDotFontPath();
+      m_fontPathSet = false;
    }
 
    // patch the output file and insert the maps and figures
@@ -1417,26 +2289,28 @@ bool DotManager::run()
    // (for zoomable SVGs), and patching the .html files requires reading that header
    // after the SVG is patched, first process the .svg files and then the other files
 
-   for (auto mapItem : m_dotMaps) {
-      if (mapItem->file().endsWith(".svg")) {
-         msg("Patching output file %d/%d %s\n", i, numDotMaps, csPrintable(mapItem->file()));
+   QList<QSharedPointer<DotFilePatcher>> svgList;
+   QList<QSharedPointer<DotFilePatcher>> fileList;
 
-         if (! mapItem->run()) {
-            return false;
-         }
+   for (auto mapItem : m_dotMaps) {
+      if (isPatched(mapItem->file())) {
+         // already patched by a worker thread
          i++;
+
+      } else if (mapItem->file().endsWith(".svg")) {
+         svgList.append(mapItem);
+
+      } else {
+         fileList.append(mapItem);
       }
    }
 
-   for (auto mapItem : m_dotMaps) {
-      if (! mapItem->file().endsWith(".svg")) {
-         msg("Patching output file %d/%d  %s\n", i, numDotMaps, csPrintable(mapItem->file()));
+   if (! runPatchers(svgList, i - 1, numDotMaps)) {
+      return false;
+   }
 
-         if (! mapItem->run()) {
-            return false;
-         }
-         i++;
-      }
+   if (! runPatchers(fileList, i - 1 + svgList.count(), numDotMaps)) {
+      return false;
    }
 
    return true;
@@ -2416,6 +3290,7 @@ void DotGfxHierarchyTable::writeGraph(QTextStream &out, const QString &path, con
          f.close();
 
          DotRunner *dotRun = new DotRunner(dotName, d.absolutePath(), true, absImgName);
+         dotRun->setSource(theGraph);
          dotRun->addJob(imageFormat, absImgName);
          dotRun->addJob(MAP_CMD, absMapName);
          DotManager::instance()->addRun(dotRun);
@@ -2559,54 +3434,362 @@ DotGfxHierarchyTable::DotGfxHierarchyTable()
    bool done    = false;
    int curColor = 0;
 
-   QListIterator<DotNode *> dnli(*m_rootNodes);
+   QListIterator<DotNode *> dnli(*m_rootNodes);
+
+   while (! done) {
+      // there are still nodes to color
+      DotNode *n;
+
+      // we are done unless there are still uncolored nodes
+      done = true;
+
+      dnli.toBack();
+
+      while (dnli.hasPrevious() ) {
+         n = dnli.previous();
+
+         if (n->m_subgraphId == -1) {
+            // still uncolored nodes
+            done = false;
+
+            n->m_subgraphId = curColor;
+
+            n->markAsVisible();
+            n->colorConnectedNodes(curColor);
+            curColor++;
+
+            DotNode *dn = const_cast<DotNode *>(n->findDocNode());
+
+            if (dn != nullptr) {
+               m_rootSubgraphs->inSort(dn);
+
+            } else {
+               m_rootSubgraphs->inSort(n);
+
+            }
+         }
+      }
+   }
+
+   for (auto n : *m_rootSubgraphs) {
+      int number = 0;
+      n->renumberNodes(number);
+   }
+}
+
+DotGfxHierarchyTable::~DotGfxHierarchyTable()
+{
+   delete m_rootNodes;
+   delete m_usedNodes;
+   delete m_rootSubgraphs;
+}
+
+QVector<DotGraphCache::ClassEdge> DotGraphCache::classEdges(QSharedPointer<ClassDef> cd, DotNode::GraphType graphType, bool base)
+{
+   auto &cache = (graphType == DotNode::Collaboration) ? m_collaborationEdges[base ? 0 : 1] : m_inheritanceEdges[base ? 0 : 1];
+
+   {
+      QMutexLocker locker(&m_mutex);
+      auto iter = cache.find(cd.data());
+
+      if (iter != cache.end()) {
+         return iter.value();
+      }
+   }
+
+   // collected without holding the lock, building a tooltip may parse documentation
+   QVector<ClassEdge> retval = findClassEdges(cd, graphType, base);
+
+   QMutexLocker locker(&m_mutex);
+   cache.insert(cd.data(), retval);
+
+   return retval;
+}
+
+QVector<DotGraphCache::IncludeEdge> DotGraphCache::includeEdges(QSharedPointer<FileDef> fd, bool inverse)
+{
+   static const bool hideUndocRelations = Config::getBool("hide-undoc-relations");
+
+   auto &cache = m_includeEdges[inverse ? 1 : 0];
+
+   {
+      QMutexLocker locker(&m_mutex);
+      auto iter = cache.find(fd.data());
+
+      if (iter != cache.end()) {
+         return iter.value();
+      }
+   }
+
+   QVector<IncludeEdge> retval;
+   QList<IncludeInfo> *includeFiles = inverse ? fd->includedByFileList() : fd->includeFileList();
+
+   if (includeFiles) {
+
+      for (auto &item : *includeFiles) {
+         QSharedPointer<FileDef> bfd = item.fileDef;
+         QString in  = item.includeName;
+
+         bool doc = true, src = false;
+
+         if (bfd) {
+            in  = bfd->getFilePath();
+            doc = bfd->isLinkable() && ! bfd->isHidden();
+            src = bfd->generateSourceFile();
+         }
+
+         if (doc || src || ! hideUndocRelations) {
+            QString url;
+
+            if (bfd) {
+               url = bfd->getOutputFileBase();
+            }
+
+            if (! doc && src) {
+               url = bfd->getSourceFileBase();
+            }
+
+            IncludeEdge edge;
+            edge.fileDef  = bfd;
+            edge.filePath = in;
+            edge.label    = item.includeName;
+
+            if (bfd) {
+               edge.url     = doc || src ? bfd->getReference() + "$" + url : QString();
+               edge.tooltip = bfd->briefDescriptionAsTooltip();
+            }
+
+            retval.append(edge);
+         }
+      }
+   }
+
+   QMutexLocker locker(&m_mutex);
+   cache.insert(fd.data(), retval);
+
+   return retval;
+}
+
+QVector<DotGraphCache::CallEdge> DotGraphCache::callEdges(QSharedPointer<MemberDef> md, bool inverse)
+{
+   auto &cache = m_callEdges[inverse ? 1 : 0];
+
+   {
+      QMutexLocker locker(&m_mutex);
+      auto iter = cache.find(md.data());
+
+      if (iter != cache.end()) {
+         return iter.value();
+      }
+   }
+
+   QVector<CallEdge> retval;
+   const MemberSDict &refs = inverse ? md->getReferencedByMembers() : md->getReferencesMembers();
+
+   for (auto &rmd : refs) {
+      if (rmd->showInCallGraph()) {
+         CallEdge edge;
+
+         edge.memberDef  = rmd;
+         edge.scope      = rmd->getOuterScope();
+         edge.uniqueId   = rmd->getReference() + "$" + rmd->getOutputFileBase() + "#" + rmd->anchor();
+         edge.label      = linkToText(rmd->getLanguage(), rmd->qualifiedName(), false);
+         edge.localLabel = linkToText(rmd->getLanguage(), rmd->name(), false);
+         edge.tooltip    = rmd->briefDescriptionAsTooltip();
+
+         retval.append(edge);
+      }
+   }
+
+   QMutexLocker locker(&m_mutex);
+   cache.insert(md.data(), retval);
+
+   return retval;
+}
+
+void DotGraphCache::addClassEdge(QVector<ClassEdge> &list, QSharedPointer<ClassDef> cd, int prot, const QString &label,
+                  const QString &usedName, const QString &templSpec, bool base)
+{
+   static const bool hideUndocClasses = Config::getBool("hide-undoc-classes");
+   static const bool hideScopeNames   = Config::getBool("hide-scope-names");
+
+   if (hideUndocClasses && ! cd->isLinkable()) {
+      return;
+   }
+
+   ClassEdge edge;
+
+   edge.classDef = cd;
+   edge.prot     = prot;
+   edge.label    = label;
+   edge.base     = base;
+
+   if (! label.isEmpty() || prot == EdgeInfo::Orange || prot == EdgeInfo::Orange2) {
+      edge.edgeStyle = EdgeInfo::Dashed;
+   } else {
+      edge.edgeStyle = EdgeInfo::Solid;
+   }
+
+   if (cd->isAnonymous()) {
+      edge.className = "anonymous:";
+      edge.className += label;
+
+   } else if (! usedName.isEmpty()) {
+      // name is a typedef
+      edge.className = usedName;
+
+   } else if (! templSpec.isEmpty()) {
+      // name has a template part
+      edge.className = insertTemplateSpecifierInScope(cd->name(), templSpec);
+
+   } else {
+      // just a normal name
+      edge.className = cd->displayName();
+   }
+
+   edge.displayName = edge.className;
+
+   if (hideScopeNames) {
+      edge.displayName = stripScope(edge.displayName);
+   }
+
+   if (cd->isLinkable() && ! cd->isHidden()) {
+      edge.url = cd->getReference() + "$" + cd->getOutputFileBase();
+
+      if (! cd->anchor().isEmpty()) {
+         edge.url += "#" + cd->anchor();
+      }
+   }
+
+   edge.tooltip = cd->briefDescriptionAsTooltip();
+
+   list.append(edge);
+}
+
+QVector<DotGraphCache::ClassEdge> DotGraphCache::findClassEdges(QSharedPointer<ClassDef> cd, DotNode::GraphType graphType, bool base)
+{
+   QVector<ClassEdge> retval;
+
+   // add inheritance relations
+   static const bool templateRelations = Config::getBool("template-relations");
+
+   if (graphType == DotNode::Inheritance || graphType == DotNode::Collaboration) {
+      SortedList<BaseClassDef *> *bcl = base ? cd->baseClasses() : cd->subClasses();
+
+      if (bcl != nullptr) {
+         for (const auto &bcd : *bcl) {
+            addClassEdge(retval, bcd->classDef, bcd->prot, QString(), bcd->usedName, bcd->templSpecifiers, base);
+         }
+      }
+   }
+
+   if (graphType == DotNode::Collaboration) {
+      // add usage relations
+      const QHash<QString, UsesClassDef> &dict = base ? cd->usedImplementationClasses() : cd->usedByImplementationClasses();
+
+      for (auto &ucd : dict) {
+         QString label;
+
+         bool first    = true;
+         int count     = 0;
+         int maxLabels = 10;
+
+         for (auto &s : ucd.m_accessors ) {
+
+            if (count >= maxLabels) {
+               break;
+            }
+
+            if (first) {
+               label = s;
+               first = false;
+
+            } else {
+               label += "\n" + s;
+            }
+
+            ++count;
+         }
+
+         if (count == maxLabels) {
+            label += "\n...";
+         }
+
+         addClassEdge(retval, ucd.m_classDef, EdgeInfo::Purple, label, "", ucd.m_templSpecifiers, base);
+      }
+   }
+
+   if (templateRelations && base) {
+      QHash<QString, QSharedPointer<ConstraintClassDef>> dict = cd->templateTypeConstraints();
+
+      for (auto ccd : dict) {
+         QString label;
+
+         bool first    = true;
+         int count     = 0;
+         int maxLabels = 10;
+
+         for (auto s : ccd->m_accessors)  {
+
+            if (count >= maxLabels) {
+               break;
+            }
+
+            if (first) {
+               label = s;
+               first = false;
+
+            } else {
+               label += "\n" + s;
+            }
+
+         }
+
+         if (count == maxLabels) {
+            label += "\n...";
+         }
 
-   while (! done) {
-      // there are still nodes to color
-      DotNode *n;
+         addClassEdge(retval, ccd->classDef, EdgeInfo::Orange2, label, QString(), QString(), true);
+         ++count;
+      }
 
-      // we are done unless there are still uncolored nodes
-      done = true;
+   }
 
-      dnli.toBack();
+   // ---- Add template instantiation relations
+   if (templateRelations) {
 
-      while (dnli.hasPrevious() ) {
-         n = dnli.previous();
+      if (base) {
+         // template relations for base classes
+         QSharedPointer<ClassDef> templMaster = cd->templateMaster();
 
-         if (n->m_subgraphId == -1) {
-            // still uncolored nodes
-            done = false;
+         if (templMaster) {
+            auto iter = templMaster->getTemplateInstances().begin();
 
-            n->m_subgraphId = curColor;
+            for (auto templInstance : templMaster->getTemplateInstances()) {
 
-            n->markAsVisible();
-            n->colorConnectedNodes(curColor);
-            curColor++;
+               if (templInstance == cd) {
+                  addClassEdge(retval, templMaster, EdgeInfo::Orange, iter.key(),QString(), QString(), true);
+               }
 
-            DotNode *dn = const_cast<DotNode *>(n->findDocNode());
+               ++iter;
+            }
+         }
 
-            if (dn != nullptr) {
-               m_rootSubgraphs->inSort(dn);
+      } else {
+         // template relations for super classes
+         const QHash<QString, QSharedPointer<ClassDef>> &templInstances = cd->getTemplateInstances();
 
-            } else {
-               m_rootSubgraphs->inSort(n);
+         auto iter = templInstances.begin();
 
-            }
+         for (auto templInstance : templInstances) {
+            addClassEdge(retval, templInstance, EdgeInfo::Orange, iter.key(), QString(), QString(), false);
+
+            ++iter;
          }
       }
    }
 
-   for (auto n : *m_rootSubgraphs) {
-      int number = 0;
-      n->renumberNodes(number);
-   }
-}
-
-DotGfxHierarchyTable::~DotGfxHierarchyTable()
-{
-   delete m_rootNodes;
-   delete m_usedNodes;
-   delete m_rootSubgraphs;
+   return retval;
 }
 
 void DotClassGraph::resetNumbering()
@@ -2614,90 +3797,31 @@ void DotClassGraph::resetNumbering()
    m_curNodeNumber = 0;
 }
 
-void DotClassGraph::addClass(QSharedPointer<ClassDef> cd, DotNode *n, int prot, const QString &label,
-                             const QString &usedName, const QString &templSpec, bool base, int distance)
+DotNode *DotClassGraph::addClass(const DotGraphCache::ClassEdge &edge, DotNode *n, int distance)
 {
-   static const bool hideUndocClasses = Config::getBool("hide-undoc-classes");
-
-   if (hideUndocClasses && ! cd->isLinkable()) {
-      return;
-   }
+   DotNode *bn = m_usedNodes->value(edge.className);
+   bool isNew  = false;
 
-   int edgeStyle;
+   if (! bn) {
+      // new class
+      bn = new DotNode(m_curNodeNumber++, edge.displayName, edge.tooltip, edge.url, false, edge.classDef);
+      m_usedNodes->insert(edge.className, bn);
 
-   if (! label.isEmpty() || prot == EdgeInfo::Orange || prot == EdgeInfo::Orange2) {
-      edgeStyle = EdgeInfo::Dashed;
-   } else {
-      edgeStyle = EdgeInfo::Solid;
+      isNew = true;
    }
 
-   QString className;
-
-   if (cd->isAnonymous()) {
-      className = "anonymous:";
-      className += label;
-
-   } else if (! usedName.isEmpty()) {
-      // name is a typedef
-      className = usedName;
-
-   } else if (! templSpec.isEmpty()) {
-      // name has a template part
-      className = insertTemplateSpecifierInScope(cd->name(), templSpec);
+   if (edge.base) {
+      n->addChild(bn, edge.prot, edge.edgeStyle, edge.label);
+      bn->addParent(n);
 
    } else {
-      // just a normal name
-      className = cd->displayName();
+      bn->addChild(n, edge.prot, edge.edgeStyle, edge.label);
+      n->addParent(bn);
    }
 
-   DotNode *bn = m_usedNodes->value(className);
-
-   if (bn) {
-      // class already inserted
-
-      if (base) {
-         n->addChild(bn, prot, edgeStyle, label);
-         bn->addParent(n);
-
-      } else {
-         bn->addChild(n, prot, edgeStyle, label);
-         n->addParent(bn);
-      }
-
-      bn->setDistance(distance);
-
-   } else {
-      // new class
-
-      QString displayName = className;
-
-      if (Config::getBool("hide-scope-names")) {
-         displayName = stripScope(displayName);
-      }
-
-      QString tmp_url;
-      if (cd->isLinkable() && !cd->isHidden()) {
-         tmp_url = cd->getReference() + "$" + cd->getOutputFileBase();
-         if (!cd->anchor().isEmpty()) {
-            tmp_url += "#" + cd->anchor();
-         }
-      }
-      QString tooltip = cd->briefDescriptionAsTooltip();
-      bn = new DotNode(m_curNodeNumber++, displayName, tooltip, tmp_url, false, cd);
-
-      if (base) {
-         n->addChild(bn, prot, edgeStyle, label);
-         bn->addParent(n);
-      } else {
-         bn->addChild(n, prot, edgeStyle, label);
-         n->addParent(bn);
-      }
-
-      bn->setDistance(distance);
-      m_usedNodes->insert(className, bn);
+   bn->setDistance(distance);
 
-      buildGraph(cd, bn, base, distance + 1);
-   }
+   return isNew ? bn : nullptr;
 }
 
 void DotClassGraph::determineTruncatedNodes(QList<DotNode *> &queue, bool includeParents)
@@ -2849,129 +3973,43 @@ bool DotClassGraph::determineVisibleNodes(DotNode *rootNode, int maxNodes, bool
    // left to right order.
 }
 
-void DotClassGraph::buildGraph(QSharedPointer<ClassDef> cd, DotNode *n, bool base, int distance)
+void DotClassGraph::buildGraph(QSharedPointer<ClassDef> cd, bool base, bool fullGraph)
 {
-   // add inheritance relations
-   static const bool templateRelations = Config::getBool("template-relations");
-
-   if (m_graphType == DotNode::Inheritance || m_graphType == DotNode::Collaboration) {
-      SortedList<BaseClassDef *> *bcl = base ? cd->baseClasses() : cd->subClasses();
-
-      if (bcl != nullptr) {
-         for (const auto &bcd : *bcl) {
-            addClass(bcd->classDef, n, bcd->prot, QString(), bcd->usedName, bcd->templSpecifiers, base, distance);
-         }
-      }
-   }
-
-   if (m_graphType == DotNode::Collaboration) {
-      // add usage relations
-      const QHash<QString, UsesClassDef> &dict = base ? cd->usedImplementationClasses() : cd->usedByImplementationClasses();
-
-      for (auto &ucd : dict) {
-         QString label;
-
-         bool first    = true;
-         int count     = 0;
-         int maxLabels = 10;
-
-         for (auto &s : ucd.m_accessors ) {
-
-            if (count >= maxLabels) {
-               break;
-            }
-
-            if (first) {
-               label = s;
-               first = false;
-
-            } else {
-               label += "\n" + s;
-            }
-
-            ++count;
-         }
-
-         if (count == maxLabels) {
-            label += "\n...";
-         }
-
-         addClass(ucd.m_classDef, n, EdgeInfo::Purple, label, "", ucd.m_templSpecifiers, base, distance);
-      }
-   }
-
-   if (templateRelations && base) {
-      QHash<QString, QSharedPointer<ConstraintClassDef>> dict = cd->templateTypeConstraints();
-
-      for (auto ccd : dict) {
-         QString label;
-
-         bool first    = true;
-         int count     = 0;
-         int maxLabels = 10;
-
-         for (auto s : ccd->m_accessors)  {
-
-            if (count >= maxLabels) {
-               break;
-            }
+   static const int maxNodes = Config::getInt("dot-graph-max-nodes");
+   static const int maxDepth = Config::getInt("dot-graph-max-depth");
 
-            if (first) {
-               label = s;
-               first = false;
+   struct PendingNode {
+      DotNode *node;
+      QSharedPointer<ClassDef> classDef;
+   };
 
-            } else {
-               label += "\n" + s;
-            }
+   // breadth first so each node has its shortest distance when it is expanded
+   QVector<PendingNode> queue;
+   queue.append({ m_startNode, cd });
 
-         }
+   // only the first maxNodes classes can be visible in a collaboration graph, classes after these are added
+   // to mark the graph as truncated and are not expanded. In an inheritance graph nodes are also truncated
+   // by their parents, so all classes are added
+   bool limitNodes = ! fullGraph && m_graphType == DotNode::Collaboration;
 
-         if (count == maxLabels) {
-            label += "\n...";
-         }
+   for (int index = 0; index < queue.count(); ++index) {
+      PendingNode item = queue.at(index);
 
-         addClass(ccd->classDef, n, EdgeInfo::Orange2, label, QString(), QString(), true, distance);
-         ++count;
+      if (limitNodes && (index >= maxNodes || item.node->distance() > maxDepth)) {
+         break;
       }
 
-   }
-
-   // ---- Add template instantiation relations
-   if (templateRelations) {
-
-      if (base) {
-         // template relations for base classes
-         QSharedPointer<ClassDef> templMaster = cd->templateMaster();
-
-         if (templMaster) {
-            auto iter = templMaster->getTemplateInstances().begin();
-
-            for (auto templInstance : templMaster->getTemplateInstances()) {
-
-               if (templInstance == cd) {
-                  addClass(templMaster, n, EdgeInfo::Orange, iter.key(),QString(), QString(), true, distance);
-               }
-
-               ++iter;
-            }
-         }
-
-      } else {
-         // template relations for super classes
-         const QHash<QString, QSharedPointer<ClassDef>> &templInstances = cd->getTemplateInstances();
-
-         auto iter = templInstances.begin();
-
-         for (auto templInstance : templInstances) {
-            addClass(templInstance, n, EdgeInfo::Orange, iter.key(), QString(), QString(), false, distance);
+      for (const auto &edge : DotGraphCache::classEdges(item.classDef, m_graphType, base)) {
+         DotNode *bn = addClass(edge, item.node, item.node->distance() + 1);
 
-            ++iter;
+         if (bn) {
+            queue.append({ bn, edge.classDef });
          }
       }
    }
 }
 
-DotClassGraph::DotClassGraph(QSharedPointer<ClassDef> cd, DotNode::GraphType t)
+DotClassGraph::DotClassGraph(QSharedPointer<ClassDef> cd, DotNode::GraphType t, bool fullGraph)
 {
    static const int maxNodes = Config::getInt("dot-graph-max-nodes");
 
@@ -2996,10 +4034,10 @@ DotClassGraph::DotClassGraph(QSharedPointer<ClassDef> cd, DotNode::GraphType t)
    m_usedNodes = new QHash<QString, DotNode *>;
    m_usedNodes->insert(className, m_startNode);
 
-   buildGraph(cd, m_startNode, true, 1);
+   buildGraph(cd, true, fullGraph);
 
    if (t == DotNode::Inheritance) {
-      buildGraph(cd, m_startNode, false, 1);
+      buildGraph(cd, false, fullGraph);
    }
 
    m_lrRank = determineVisibleNodes(m_startNode, maxNodes, t == DotNode::Inheritance);
@@ -3092,11 +4130,8 @@ QString computeMd5Signature(DotNode *root, DotNode::GraphType gt, GraphOutputFor
 }
 
 static bool updateDotGraph(DotNode *root, DotNode::GraphType gt, const QString &baseName, GraphOutputFormat format,
-                           bool lrRank, bool renderParents, bool backArrows, const QString &title = QString() )
+                           bool lrRank, bool renderParents, bool backArrows, const QString &title, QString &theGraph)
 {
-   QString theGraph;
-
-   // TODO: write graph to theGraph, then compute md5 checksum
    QString md5 = computeMd5Signature( root, gt, format, lrRank, renderParents, backArrows, title, theGraph);
    QFile f(baseName + ".dot");
 
@@ -3174,8 +4209,9 @@ QString DotClassGraph::writeGraph(QTextStream &out, GraphOutputFormat graphForma
    bool regenerate = false;
 
    bool ok = false;
+   QString theGraph;
    bool x  = updateDotGraph(m_startNode, m_graphType, absBaseName, graphFormat, m_lrRank,
-                            m_graphType == DotNode::Inheritance, true, m_startNode->label() );
+                            m_graphType == DotNode::Inheritance, true, m_startNode->label(), theGraph);
 
    if (x)  {
       ok = true;
@@ -3214,6 +4250,7 @@ QString DotClassGraph::writeGraph(QTextStream &out, GraphOutputFormat graphForma
          // run dot to create a bitmap image
 
          DotRunner *dotRun = new DotRunner(absDotName, d.absolutePath(), true, absImgName);
+         dotRun->setSource(theGraph);
          dotRun->addJob(imageFormat, absImgName);
 
          if (generateImageMap) {
@@ -3225,6 +4262,7 @@ QString DotClassGraph::writeGraph(QTextStream &out, GraphOutputFormat graphForma
       } else if (graphFormat == GOF_EPS) {
          // run dot to create a .eps image
          DotRunner *dotRun = new DotRunner(absDotName, d.absolutePath(), false);
+         dotRun->setSource(theGraph);
 
          if (usePDFLatex) {
             dotRun->addJob("pdf", absPdfName);
@@ -3338,63 +4376,47 @@ void DotClassGraph::writeDEF(QTextStream &t)
    }
 }
 
-void DotInclDepGraph::buildGraph(DotNode *n, QSharedPointer<FileDef> fd, int distance)
+void DotInclDepGraph::buildGraph(QSharedPointer<FileDef> fd, bool fullGraph)
 {
-   QList<IncludeInfo> *includeFiles = m_inverse ? fd->includedByFileList() : fd->includeFileList();
-
-   if (includeFiles) {
-
-      for (auto &item : *includeFiles) {
-         QSharedPointer<FileDef> bfd = item.fileDef;
-         QString in  = item.includeName;
-
-         bool doc = true, src = false;
-
-         if (bfd) {
-            in  = bfd->getFilePath();
-            doc = bfd->isLinkable() && ! bfd->isHidden();
-            src = bfd->generateSourceFile();
-         }
+   static const int maxNodes = Config::getInt("dot-graph-max-nodes");
+   static const int maxDepth = Config::getInt("dot-graph-max-depth");
 
-         if (doc || src || ! Config::getBool("hide-undoc-relations")) {
-            QString url;
+   struct PendingNode {
+      DotNode *node;
+      QSharedPointer<FileDef> fileDef;
+   };
 
-            if (bfd) {
-               url = bfd->getOutputFileBase();
-            }
+   // breadth first, the order in which nodes are added is the order determineVisibleNodes() uses
+   QVector<PendingNode> queue;
+   queue.append({ m_startNode, fd });
 
-            if (! doc && src) {
-               url = bfd->getSourceFileBase();
-            }
+   for (int index = 0; index < queue.count(); ++index) {
+      PendingNode item = queue.at(index);
 
-            DotNode *bn  = m_usedNodes->value(in);
+      if (! fullGraph && (index >= maxNodes || item.node->distance() > maxDepth)) {
+         // remaining files are never visible, their includes are not needed
+         break;
+      }
 
-            if (bn) {
-               // file is already a node in the graph
-               n->addChild(bn, 0, 0, QString());
-               bn->addParent(n);
-               bn->setDistance(distance);
+      if (! item.fileDef) {
+         continue;
+      }
 
-            } else {
-               QString tmp_url;
-               QString tooltip;
+      int distance = item.node->distance() + 1;
 
-               if (bfd) {
-                  tmp_url = doc || src ? bfd->getReference() + "$" + url : QString();
-                  tooltip = bfd->briefDescriptionAsTooltip();
-               }
-               bn = new DotNode(m_curNodeNumber++, item.includeName, tooltip, tmp_url, false, QSharedPointer<ClassDef>());
+      for (const auto &edge : DotGraphCache::includeEdges(item.fileDef, m_inverse)) {
+         DotNode *bn = m_usedNodes->value(edge.filePath);
 
-               n->addChild(bn, 0, 0, QString());
-               bn->addParent(n);
-               m_usedNodes->insert(in, bn);
-               bn->setDistance(distance);
+         if (! bn) {
+            bn = new DotNode(m_curNodeNumber++, edge.label, edge.tooltip, edge.url, false, QSharedPointer<ClassDef>());
+            m_usedNodes->insert(edge.filePath, bn);
 
-               if (bfd) {
-                  buildGraph(bn, bfd, distance + 1);
-               }
-            }
+            queue.append({ bn, edge.fileDef });
          }
+
+         item.node->addChild(bn, 0, 0, QString());
+         bn->addParent(item.node);
+         bn->setDistance(distance);
       }
    }
 }
@@ -3451,7 +4473,7 @@ void DotInclDepGraph::resetNumbering()
    m_curNodeNumber = 0;
 }
 
-DotInclDepGraph::DotInclDepGraph(QSharedPointer<FileDef> fd, bool inverse)
+DotInclDepGraph::DotInclDepGraph(QSharedPointer<FileDef> fd, bool inverse, bool fullGraph)
 {
    static const int nodes = Config::getInt("dot-graph-max-nodes");
 
@@ -3468,7 +4490,7 @@ DotInclDepGraph::DotInclDepGraph(QSharedPointer<FileDef> fd, bool inverse)
 
    m_usedNodes = new QHash<QString, DotNode *>;
    m_usedNodes->insert(fd->getFilePath(), m_startNode);
-   buildGraph(m_startNode, fd, 1);
+   buildGraph(fd, fullGraph);
 
    int maxNodes = nodes;
 
@@ -3537,9 +4559,11 @@ QString DotInclDepGraph::writeGraph(QTextStream &out, GraphOutputFormat graphFor
    const QString absEpsName  = absBaseName + ".eps";
    const QString absImgName  = absBaseName + "." + imageExt;
 
+   QString theGraph;
    bool regenerate = false;
+
    if (updateDotGraph(m_startNode, DotNode::Dependency, absBaseName, graphFormat, false, false,
-                      m_inverse, m_startNode->label() ) || ! checkDeliverables(graphFormat == GOF_BITMAP ? absImgName :
+                      m_inverse, m_startNode->label(), theGraph) || ! checkDeliverables(graphFormat == GOF_BITMAP ? absImgName :
                             usePDFLatex ? absPdfName : absEpsName,
                             graphFormat == GOF_BITMAP && generateImageMap ? absMapName : QString())) {
 
@@ -3548,6 +4572,7 @@ QString DotInclDepGraph::writeGraph(QTextStream &out, GraphOutputFormat graphFor
          // run dot to create a bitmap image
 
          DotRunner *dotRun = new DotRunner(absDotName, d.absolutePath(), true, absImgName);
+         dotRun->setSource(theGraph);
          dotRun->addJob(imageFormat, absImgName);
 
          if (generateImageMap) {
@@ -3558,6 +4583,7 @@ QString DotInclDepGraph::writeGraph(QTextStream &out, GraphOutputFormat graphFor
 
       } else if (graphFormat == GOF_EPS) {
          DotRunner *dotRun = new DotRunner(absDotName, d.absolutePath(), false);
+         dotRun->setSource(theGraph);
 
          if (usePDFLatex) {
             dotRun->addJob("pdf", absPdfName);
@@ -3670,42 +4696,50 @@ void DotInclDepGraph::writeDocbook(QTextStream &t)
    }
 }
 
-void DotCallGraph::buildGraph(DotNode *n, QSharedPointer<MemberDef> md, int distance)
+void DotCallGraph::buildGraph(QSharedPointer<MemberDef> md)
 {
-   const MemberSDict &refs = m_inverse ? md->getReferencedByMembers() : md->getReferencesMembers();
+   static const int  maxNodes       = Config::getInt("dot-graph-max-nodes");
+   static const int  maxDepth       = Config::getInt("dot-graph-max-depth");
+   static const bool hideScopeNames = Config::getBool("hide-scope-names");
 
-   for (auto &rmd : refs) {
-      if (rmd->showInCallGraph()) {
-         QString uniqueId;
+   struct PendingNode {
+      DotNode *node;
+      QSharedPointer<MemberDef> memberDef;
+   };
 
-         uniqueId = rmd->getReference() + "$" + rmd->getOutputFileBase() + "#" + rmd->anchor();
-         DotNode *bn  = m_usedNodes->value(uniqueId);
+   // breadth first, the order in which nodes are added is the order determineVisibleNodes() uses
+   QVector<PendingNode> queue;
+   queue.append({ m_startNode, md });
 
-         if (bn) {
-            // file is already a node in the graph
-            n->addChild(bn, 0, 0, QString());
-            bn->addParent(n);
-            bn->setDistance(distance);
+   for (int index = 0; index < queue.count(); ++index) {
+      PendingNode item = queue.at(index);
 
-         } else {
-            QString name;
+      if (index >= maxNodes || item.node->distance() > maxDepth) {
+         // remaining members are never visible, their references are not needed
+         break;
+      }
 
-            if (Config::getBool("hide-scope-names")) {
-               name  = rmd->getOuterScope() == m_scope ? rmd->name() : rmd->qualifiedName();
-            } else {
-               name = rmd->qualifiedName();
-            }
+      int distance = item.node->distance() + 1;
+
+      for (const auto &edge : DotGraphCache::callEdges(item.memberDef, m_inverse)) {
+         DotNode *bn = m_usedNodes->value(edge.uniqueId);
+
+         if (! bn) {
+            QString label = edge.label;
 
-            QString tooltip = rmd->briefDescriptionAsTooltip();
+            if (hideScopeNames && edge.scope == m_scope) {
+               label = edge.localLabel;
+            }
 
-            bn = new DotNode(m_curNodeNumber++, linkToText(rmd->getLanguage(), name, false), tooltip, uniqueId, false);
-            n->addChild(bn, 0, 0, QString());
-            bn->addParent(n);
-            bn->setDistance(distance);
-            m_usedNodes->insert(uniqueId, bn);
+            bn = new DotNode(m_curNodeNumber++, label, edge.tooltip, edge.uniqueId, false);
+            m_usedNodes->insert(edge.uniqueId, bn);
 
-            buildGraph(bn, rmd, distance + 1);
+            queue.append({ bn, edge.memberDef });
          }
+
+         item.node->addChild(bn, 0, 0, QString());
+         bn->addParent(item.node);
+         bn->setDistance(distance);
       }
    }
 }
@@ -3785,7 +4819,7 @@ DotCallGraph::DotCallGraph(QSharedPointer<MemberDef> md, bool inverse)
    m_startNode->setDistance(0);
    m_usedNodes = new QHash<QString, DotNode *>;
    m_usedNodes->insert(uniqueId, m_startNode);
-   buildGraph(m_startNode, md, 1);
+   buildGraph(md);
 
    int maxNodes = nodes;
 
@@ -3830,12 +4864,14 @@ QString DotCallGraph::writeGraph(QTextStream &out, GraphOutputFormat graphFormat
    QString absEpsName  = absBaseName + ".eps";
    QString absImgName  = absBaseName + "." + imageExt;
 
+   QString theGraph;
    bool regenerate = false;
+
    if (updateDotGraph(m_startNode, DotNode::CallGraph, absBaseName, graphFormat,
                       true,         // lrRank
                       false,        // renderParents
                       m_inverse,    // backArrows
-                      m_startNode->label() ) ||
+                      m_startNode->label(), theGraph) ||
                       ! checkDeliverables(graphFormat == GOF_BITMAP ? absImgName :
                             usePDFLatex ? absPdfName : absEpsName,
                             graphFormat == GOF_BITMAP && generateImageMap ? absMapName : QString()) ) {
@@ -3846,6 +4882,7 @@ QString DotCallGraph::writeGraph(QTextStream &out, GraphOutputFormat graphFormat
          // run dot to create a bitmap image
 
          DotRunner *dotRun = new DotRunner(absDotName, d.absolutePath(), true, absImgName);
+         dotRun->setSource(theGraph);
          dotRun->addJob(imageFormat, absImgName);
 
          if (generateImageMap) {
@@ -3857,6 +4894,7 @@ QString DotCallGraph::writeGraph(QTextStream &out, GraphOutputFormat graphFormat
       } else if (graphFormat == GOF_EPS) {
          // run dot to create a .eps image
          DotRunner *dotRun = new DotRunner(absDotName, d.absolutePath(), false);
+         dotRun->setSource(theGraph);
 
          if (usePDFLatex) {
             dotRun->addJob("pdf", absPdfName);
@@ -4052,6 +5090,7 @@ QString DotDirDeps::writeGraph(QTextStream &out, GraphOutputFormat graphFormat,
          // run dot to create a bitmap image
 
          DotRunner *dotRun = new DotRunner(absDotName, d.absolutePath(), true, absImgName);
+         dotRun->setSource(theGraph);
          dotRun->addJob(imageFormat, absImgName);
 
          if (generateImageMap) {
@@ -4062,6 +5101,7 @@ QString DotDirDeps::writeGraph(QTextStream &out, GraphOutputFormat graphFormat,
 
       } else if (graphFormat == GOF_EPS) {
          DotRunner *dotRun = new DotRunner(absDotName, d.absolutePath(), false);
+         dotRun->setSource(theGraph);
 
          if (usePDFLatex) {
             dotRun->addJob("pdf", absPdfName);
@@ -4211,6 +5251,7 @@ void generateGraphLegend(const QString &path)
 
       // run dot to generate the a bitmap image from the graph
       DotRunner *dotRun = new DotRunner(absDotName, d.absolutePath(), true, absImgName);
+      dotRun->setSource(theGraph);
       dotRun->addJob(imageFormat, absImgName);
       DotManager::instance()->addRun(dotRun);
 
@@ -4625,6 +5666,7 @@ QString DotGroupCollaboration::writeGraph( QTextStream &t, GraphOutputFormat gra
          // run dot to create a bitmap image
 
          DotRunner *dotRun = new DotRunner(absDotName, d.absolutePath(), false);
+         dotRun->setSource(theGraph);
 
          dotRun->addJob(imageFormat, absImgName);
          if (writeImageMap) {
@@ -4634,6 +5676,7 @@ QString DotGroupCollaboration::writeGraph( QTextStream &t, GraphOutputFormat gra
 
       } else if (graphFormat == GOF_EPS) {
          DotRunner *dotRun = new DotRunner(absDotName, d.absolutePath(), false);
+         dotRun->setSource(theGraph);
 
          if (usePDFLatex) {
             dotRun->addJob("pdf", absPdfName);
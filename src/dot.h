@@ -29,9 +29,10 @@
 #include <QHash>
 #include <QList>
 #include <QMutex>
-#include <QQueue>
+#include <QSet>
 #include <QTextStream>
 #include <QThread>
+#include <QVector>
 #include <QWaitCondition>
 
 class ClassDef;
@@ -182,11 +183,71 @@ class DotGfxHierarchyTable
    SortedList<DotNode *>  *m_rootSubgraphs;
 };
 
+/** Relations of classes, files, and members used to build the dot graphs
+ *
+ *  The relations of a definition are collected once and shared by every graph which contains it.
+ */
+class DotGraphCache
+{
+ public:
+   struct ClassEdge {
+      QSharedPointer<ClassDef> classDef;
+
+      QString className;         // unique name of the node in the graph
+      QString displayName;
+      QString label;
+      QString tooltip;
+      QString url;
+
+      int  prot;
+      int  edgeStyle;
+      bool base;
+   };
+
+   struct IncludeEdge {
+      QSharedPointer<FileDef> fileDef;
+
+      QString filePath;          // unique name of the node in the graph
+      QString label;
+      QString tooltip;
+      QString url;
+   };
+
+   struct CallEdge {
+      QSharedPointer<MemberDef>  memberDef;
+      QSharedPointer<Definition> scope;
+
+      QString uniqueId;          // unique name of the node in the graph
+      QString label;
+      QString localLabel;        // label without the scope, used with hide-scope-names
+      QString tooltip;
+   };
+
+   static QVector<ClassEdge> classEdges(QSharedPointer<ClassDef> cd, DotNode::GraphType graphType, bool base);
+   static QVector<IncludeEdge> includeEdges(QSharedPointer<FileDef> fd, bool inverse);
+   static QVector<CallEdge> callEdges(QSharedPointer<MemberDef> md, bool inverse);
+
+ private:
+   static QVector<ClassEdge> findClassEdges(QSharedPointer<ClassDef> cd, DotNode::GraphType graphType, bool base);
+
+   static void addClassEdge(QVector<ClassEdge> &list, QSharedPointer<ClassDef> cd, int prot, const QString &label,
+                  const QString &usedName, const QString &templSpec, bool base);
+
+   // index 0 is used for base classes or forward relations, index 1 for derived classes or inverse relations
+   static QHash<const ClassDef *, QVector<ClassEdge>>   m_inheritanceEdges[2];
+   static QHash<const ClassDef *, QVector<ClassEdge>>   m_collaborationEdges[2];
+   static QHash<const FileDef *, QVector<IncludeEdge>>  m_includeEdges[2];
+   static QHash<const MemberDef *, QVector<CallEdge>>   m_callEdges[2];
+
+   static QMutex m_mutex;
+};
+
 /** Representation of a class inheritance or dependency graph */
 class DotClassGraph
 {
  public:
-   DotClassGraph(QSharedPointer<ClassDef> cd, DotNode::GraphType t);
+   // the full graph includes nodes which are never visible, these are only used in the XML output
+   DotClassGraph(QSharedPointer<ClassDef> cd, DotNode::GraphType t, bool fullGraph = false);
    ~DotClassGraph();
 
    bool isTrivial() const;
@@ -204,12 +265,12 @@ class DotClassGraph
    static void resetNumbering();
 
  private:
-   void buildGraph(QSharedPointer<ClassDef> cd, DotNode *n, bool base, int distance);
+   void buildGraph(QSharedPointer<ClassDef> cd, bool base, bool fullGraph);
    bool determineVisibleNodes(DotNode *rootNode, int maxNodes, bool includeParents);
    void determineTruncatedNodes(QList<DotNode *> &queue, bool includeParents);
 
-   void addClass(QSharedPointer<ClassDef> cd, DotNode *n, int prot, const QString &label,
-                 const QString &usedName, const QString &templSpec, bool base, int distance);
+   // returns the new node or a nullptr if the class was already in the graph
+   DotNode *addClass(const DotGraphCache::ClassEdge &edge, DotNode *n, int distance);
 
    DotNode *m_startNode;
    QHash<QString, DotNode *> *m_usedNodes;
@@ -224,7 +285,7 @@ class DotClassGraph
 class DotInclDepGraph
 {
  public:
-   DotInclDepGraph(QSharedPointer<FileDef> fd, bool inverse);
+   DotInclDepGraph(QSharedPointer<FileDef> fd, bool inverse, bool fullGraph = false);
    ~DotInclDepGraph();
    QString writeGraph(QTextStream &t, GraphOutputFormat gf, EmbeddedOutputFormat ef,
                          const QString &path, const QString &fileName, const QString &relPath,
@@ -241,7 +302,7 @@ class DotInclDepGraph
    static void resetNumbering();
 
  private:
-   void buildGraph(DotNode *n, QSharedPointer<FileDef> fd, int distance);
+   void buildGraph(QSharedPointer<FileDef> fd, bool fullGraph);
    void determineVisibleNodes(QList<DotNode *> &queue, int &maxNodes);
    void determineTruncatedNodes(QList<DotNode *> &queue);
 
@@ -264,7 +325,7 @@ class DotCallGraph
                          const QString  &path, const QString &fileName, const QString  &relPath,
                          bool writeImageMap = true, int graphId = -1) const;
 
-   void buildGraph(DotNode *n, QSharedPointer<MemberDef> md, int distance);
+   void buildGraph(QSharedPointer<MemberDef> md);
    bool isTrivial() const;
    bool isTooBig() const;
    int numNodes() const;
@@ -366,6 +427,72 @@ class DotGroupCollaboration
    QList<Edge *>   m_edges;
 };
 
+/** Content addressed store of the files produced by dot
+ *
+ *  Files are keyed by the dot source, the output format, the dot version, and the font path.
+ *  The store is shared by all output formats and survives clean builds when dot-cache-dir
+ *  points outside of the output directory. Files not used by a run are removed once they
+ *  are older than a week.
+ */
+class DotCache
+{
+ public:
+   static void setDirectory(const QString &dirName);
+
+   static bool isEnabled() {
+      return ! m_dirName.isEmpty();
+   }
+
+   static QString key(const QByteArray &dotSource, const QString &format);
+
+   // copies the cached file to output, returns false if the key is not in the store
+   static bool fetch(const QString &key, const QString &output);
+   static void store(const QString &key, const QString &output);
+
+   // removes files which were not used by this run and are older than a week
+   static void prune();
+
+ private:
+   static QString m_dirName;
+   static QByteArray m_dotVersion;
+
+   // keys read or written by this run
+   static QSet<QString> m_usedKeys;
+   static QMutex m_mutex;
+};
+
+/** Layout time of each dot graph
+ *
+ *  Used to run the most expensive graphs first. Graphs are identified by their path relative
+ *  to output-dir. The timings are saved in the dot-cache-dir, or in the output-dir when no
+ *  cache directory is set, so the next run can use them.
+ */
+class DotProfile
+{
+ public:
+   static void load(const QString &fileName);
+   static void save();
+
+   // returns the time in ms of the last layout of the graph, -1 if not known
+   static qint64 lastTime(const QString &dotFile);
+   static void record(const QString &dotFile, qint64 ms, bool degraded);
+
+   // lists the slowest graphs of this run
+   static void printSlowest(int count);
+
+ private:
+   struct Timing {
+      QString name;
+      qint64  ms;
+      bool    degraded;
+   };
+
+   static QString m_fileName;
+   static QHash<QString, qint64> m_lastTimes;
+   static QList<Timing> m_timings;
+   static QMutex m_mutex;
+};
+
 /** Helper class to run dot
  */
 class DotRunner
@@ -376,6 +503,11 @@ class DotRunner
       QString file;
    };
 
+   struct DotJob {
+      QString format;
+      QString output;
+   };
+
    /** Creates a runner for a dot \a file. */
    DotRunner(const QString &file, const QString &fontPath, bool checkResult, const QString &imageName = QString());
 
@@ -385,6 +517,11 @@ class DotRunner
    void addJob(const QString &format, const QString &output);
    void addPostProcessing(const QString &cmd, const QString &args);
 
+   /** Sets the graph text which was written to the dot file, saves reading the file again. */
+   void setSource(const QString &source) {
+      m_source = source.toUtf8();
+   }
+
    void preventCleanUp() {
       m_cleanUp = false;
    }
@@ -392,12 +529,34 @@ class DotRunner
    /** Runs dot for all jobs added. */
    bool run();
 
+   /** Runs dot once for all runners in the list, runners which fail are run on their own. */
+   static void runBatch(const QList<DotRunner *> &runners);
+
+   // returns true if the runner can be part of a batch
+   bool isBatchable() const;
+   qint64 sourceSize() const;
+
+   // expected layout time in ms, used to start the expensive graphs first
+   qint64 estimatedCost() const;
+
    CleanupItem cleanup() const {
       return m_cleanupItem;
    }
 
+   QStringList outputs() const;
+
+   // dot file and outputs, a second run for any of these files must wait for this one
+   QStringList files() const;
+
  private:
-   QList<QString> m_jobs;
+   void fetchCached(QList<DotJob> &jobs, QStringList &cacheKeys);
+   bool runJobs(const QList<DotJob> &jobs, int &exitCode, QString &dotArgs);
+   bool finish(const QList<DotJob> &jobs, const QStringList &cacheKeys);
+   void reportError(int exitCode, const QString &dotArgs);
+
+   QList<DotJob> m_jobs;
+
+   QByteArray m_source;
 
    QString m_postArgs;
    QString m_postCmd;
@@ -411,6 +570,10 @@ class DotRunner
    bool m_cleanUp;
    bool m_multiTargets;
 
+   // set when dot-timeout was reached and the graph was rendered with a simplified layout
+   bool   m_degraded = false;
+   qint64 m_elapsed  = 0;
+
    CleanupItem m_cleanupItem;
 
    static std::mutex m_output_mutex;
@@ -449,13 +612,22 @@ class DotFilePatcher
 class DotRunnerQueue
 {
  public:
-   void enqueue(DotRunner *runner);
-   DotRunner *dequeue();
+   // an empty batch tells the worker to stop, batches with the highest cost are dequeued first
+   void enqueue(const QList<DotRunner *> &batch);
+   QList<DotRunner *> dequeue();
+
+   // number of runners in the queue
    uint count() const;
 
  private:
+   struct Item {
+      qint64 cost;
+      QList<DotRunner *> batch;
+   };
+
    QWaitCondition  m_bufferNotEmpty;
-   QQueue<DotRunner *> m_queue;
+   QList<Item>     m_queue;
+   uint            m_runnerCount = 0;
    mutable QMutex  m_mutex;
 };
 
@@ -472,6 +644,30 @@ class DotWorkerThread : public QThread
    QList<DotRunner::CleanupItem> m_cleanupItems;
 };
 
+/** Worker thread to patch output files, each thread patches every n-th file of the list */
+class DotPatcherThread : public QThread
+{
+ public:
+   DotPatcherThread(const QList<QSharedPointer<DotFilePatcher>> &list, int first, int step, int offset, int total);
+   void run() override;
+
+   bool result() const {
+      return m_result;
+   }
+
+ private:
+   QList<QSharedPointer<DotFilePatcher>> m_list;
+
+   int m_first;
+   int m_step;
+
+   // used for the progress messages
+   int m_offset;
+   int m_total;
+
+   bool m_result = true;
+};
+
 /** Singleton that manages dot relation actions */
 class DotManager
 {
@@ -491,17 +687,65 @@ class DotManager
 
    bool run();
 
+   // called by the worker threads when a run is finished
+   void runFinished(DotRunner *runner);
+
+   // returns true while a graph is queued, rendered, or patched for this output file
+   bool isInFlight(const QString &file);
+
  private:
    DotManager();
    virtual ~DotManager();
 
+   // groups the runs so small graphs share one dot process
+   QList<QList<DotRunner *>> createBatches() const;
+
+   // adds a run to the pending batch, the batch is queued once it is full
+   void queueRun(DotRunner *run);
+   void flushPendingBatch();
+
+   // starts deferred runs whose files are no longer used by another run
+   void startDeferredRuns();
+
+   // an svg file only counts as patched if no later run has rendered it again
+   bool isPatched(const QString &file) const;
+
+   int pendingRuns();
+
+   // patches the files using the same number of threads as dot
+   bool runPatchers(const QList<QSharedPointer<DotFilePatcher>> &list, int offset, int total);
+
    QList<DotRunner *> m_dotRuns;
 
    StringMap<QSharedPointer<DotFilePatcher>> m_dotMaps;
 
+   QList<DotRunner *> m_pendingBatch;
+   qint64             m_pendingSource = 0;
+
+   // files of the runs which are queued or running, at most one run per file
+   QSet<QString>      m_activeFiles;
+
+   // runs which were added while one of their files was still in use
+   QList<DotRunner *> m_deferredRuns;
+
+   // number of runs which are queued, deferred, or running
+   int m_pendingRuns = 0;
+
+   // count of pending runs for each file, the file can not be read until it drops to zero
+   QHash<QString, int> m_inFlight;
+
+   // latest run which renders a file, and the run whose output was patched
+   QHash<QString, DotRunner *> m_lastRun;
+   QHash<QString, DotRunner *> m_patchedBy;
+
+   bool m_fontPathSet = false;
+
    static DotManager        *m_theInstance;
    DotRunnerQueue           *m_queue;
    QList<DotWorkerThread *>  m_workers;
+
+   // graphs may be added by several threads writing output pages
+   QMutex m_mutex;
 };
 
 
@@ -0,0 +1,195 @@
+/************************************************************************
+*
+* Copyright (c) 2014-2025 Barbara Geller & Ansel Sermersheim
+*
+* Copyright (c) 1997-2014 Dimitri van Heesch
+*
+* DoxyPress is free software. You can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* version 2 as published by the Free Software Foundation.
+*
+* DoxyPress is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+*
+* Documents produced by DoxyPress are derivative works derived from the
+* input used in their production; they are not affected by this license.
+*
+* https://www.gnu.org/licenses/
+*
+*************************************************************************/
+
+#include <dotlayout.h>
+
+#ifdef HAVE_GRAPHVIZ_LIB
+
+#include <config.h>
+
+#include <QFile>
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
+
+#include <gvc.h>
+
+// graphviz keeps global state, only one graph can be laid out at a time
+static QMutex s_graphvizMutex;
+static GVC_t *s_gvc = nullptr;
+
+static QMutex s_mapMutex;
+static QHash<QString, QByteArray> s_maps;
+
+// the type of the length argument of gvRenderData differs between graphviz versions
+template <typename T>
+static bool renderData(GVC_t *gvc, Agraph_t *graph, const char *format, QByteArray &data,
+                  int (*)(GVC_t *, Agraph_t *, const char *, char **, T *))
+{
+   char *result = nullptr;
+   T length     = 0;
+
+   if (gvRenderData(gvc, graph, format, &result, &length) != 0) {
+      return false;
+   }
+
+   data = QByteArray(result, length);
+   gvFreeRenderData(result);
+
+   return true;
+}
+
+bool DotLayout::isAvailable()
+{
+   static const bool useLibrary = Config::getBool("dot-graphviz-lib");
+
+   return useLibrary;
+}
+
+bool DotLayout::render(const QByteArray &dotSource, const QList<DotRunner::DotJob> &jobs)
+{
+   if (dotSource.isEmpty()) {
+      return false;
+   }
+
+   QList<QPair<QString, QByteArray>> maps;
+
+   {
+      QMutexLocker lock(&s_graphvizMutex);
+
+      if (s_gvc == nullptr) {
+         s_gvc = gvContext();
+      }
+
+      Agraph_t *graph = agmemread(dotSource.constData());
+
+      if (graph == nullptr) {
+         return false;
+      }
+
+      bool retval = (gvLayout(s_gvc, graph, "dot") == 0);
+
+      if (retval) {
+         for (const auto &job : jobs) {
+            QByteArray format = job.format.toUtf8();
+
+            if (job.format == "cmapx") {
+               // image maps are returned in memory, the patcher reads them from there
+               QByteArray data;
+
+               if (! renderData(s_gvc, graph, format.constData(), data, &gvRenderData)) {
+                  retval = false;
+                  break;
+               }
+
+               maps.append(qMakePair(job.output, data));
+
+            } else {
+               QByteArray output = job.output.toUtf8();
+
+               if (gvRenderFilename(s_gvc, graph, format.constData(), output.constData()) != 0) {
+                  retval = false;
+                  break;
+               }
+            }
+         }
+
+         gvFreeLayout(s_gvc, graph);
+      }
+
+      agclose(graph);
+
+      if (! retval) {
+         return false;
+      }
+   }
+
+   for (const auto &item : maps) {
+      // map file is still written, later runs reuse it when the graph did not change
+      QFile f(item.first);
+
+      if (! f.open(QIODevice::WriteOnly)) {
+         return false;
+      }
+
+      f.write(item.second);
+      f.close();
+
+      QMutexLocker lock(&s_mapMutex);
+      s_maps.insert(item.first, item.second);
+   }
+
+   return true;
+}
+
+bool DotLayout::takeMap(const QString &mapFile, QByteArray &data)
+{
+   QMutexLocker lock(&s_mapMutex);
+
+   auto iter = s_maps.find(mapFile);
+
+   if (iter == s_maps.end()) {
+      return false;
+   }
+
+   data = iter.value();
+   s_maps.erase(iter);
+
+   return true;
+}
+
+void DotLayout::cleanup()
+{
+   {
+      QMutexLocker lock(&s_mapMutex);
+      s_maps.clear();
+   }
+
+   QMutexLocker lock(&s_graphvizMutex);
+
+   if (s_gvc != nullptr) {
+      gvFreeContext(s_gvc);
+      s_gvc = nullptr;
+   }
+}
+
+#else
+
+bool DotLayout::isAvailable()
+{
+   return false;
+}
+
+bool DotLayout::render(const QByteArray &, const QList<DotRunner::DotJob> &)
+{
+   return false;
+}
+
+bool DotLayout::takeMap(const QString &, QByteArray &)
+{
+   return false;
+}
+
+void DotLayout::cleanup()
+{
+}
+
+#endif
@@ -0,0 +1,54 @@
+/************************************************************************
+*
+* Copyright (c) 2014-2025 Barbara Geller & Ansel Sermersheim
+*
+* Copyright (c) 1997-2014 Dimitri van Heesch
+*
+* DoxyPress is free software. You can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* version 2 as published by the Free Software Foundation.
+*
+* DoxyPress is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+*
+* Documents produced by DoxyPress are derivative works derived from the
+* input used in their production; they are not affected by this license.
+*
+* https://www.gnu.org/licenses/
+*
+*************************************************************************/
+
+#ifndef DOTLAYOUT_H
+#define DOTLAYOUT_H
+
+#include <QByteArray>
+#include <QList>
+#include <QString>
+
+#include <dot.h>
+
+/** Lays out and renders dot graphs with the graphviz libraries instead of running the dot program
+ *
+ *  Only available when DoxyPress is built with DOXYPRESS_GRAPHVIZ_LIB and dot-graphviz-lib is set.
+ *  The graphviz libraries keep global state, library mode is serialised and renders one graph at a
+ *  time no matter how many dot threads are used. It only pays off when starting the dot program is
+ *  expensive, otherwise dot-num-threads external processes are faster. When a graph can not be
+ *  rendered the caller falls back to the dot program.
+ */
+class DotLayout
+{
+ public:
+   static bool isAvailable();
+
+   // renders dotSource for each job, returns false if any of the outputs was not written
+   static bool render(const QByteArray &dotSource, const QList<DotRunner::DotJob> &jobs);
+
+   // image maps rendered in process are kept in memory until the page is patched
+   static bool takeMap(const QString &mapFile, QByteArray &data);
+
+   // releases the graphviz context, called at shutdown
+   static void cleanup();
+};
+
+#endif
@@ -19,9 +19,16 @@
 *
 *************************************************************************/
 
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
 #include <doxy_globals.h>
 #include <doxy_build_info.h>
 #include <filedef.h>
+#include <portable.h>
 
 class GenericsSDict;
 class IndexList;
@@ -89,7 +96,7 @@ QHash<QString, QSharedPointer<Definition>>   Doxy_Globals::clangUsrMap;
 QHash<long, QSharedPointer<MemberGroupInfo>> Doxy_Globals::memGrpInfoDict;    // dictionary of the member groups heading
 
 StringMap<QSharedPointer<DirRelation>>       Doxy_Globals::dirRelations;
-QCache<QString, LookupInfo>                  Doxy_Globals::lookupCache;
+LookupCache                                  Doxy_Globals::lookupCache;
 
 QString Doxy_Globals::htmlFileExtension;
 QString Doxy_Globals::latexStyleExtension = ".sty";
@@ -128,3 +135,183 @@ QMultiHash<QString, Definition *> &Doxy_Globals::glossary()
    static QMultiHash<QString, Definition *> data;
    return data;
 }
+
+// ** statistics
+void Statistics::setEnabled(bool enabled)
+{
+   m_enabled = enabled;
+}
+
+void Statistics::setTraceFile(const QString &fileName)
+{
+   if (! fileName.isEmpty()) {
+      // current directory changes while processing, save the full path
+      m_traceFile = QFileInfo(fileName).absoluteFilePath();
+      m_enabled   = true;
+   }
+}
+
+void Statistics::begin(const QString &name, bool display)
+{
+   if (display) {
+      msg(name);
+   }
+
+   if (! m_enabled) {
+      return;
+   }
+
+   if (! m_timer.isValid()) {
+      m_timer.start();
+   }
+
+   PhaseInfo phase;
+
+   phase.name        = name.trimmed();
+   phase.depth       = m_openPhases.size();
+   phase.startTime   = m_timer.nsecsElapsed() / 1000;
+   phase.wallTime    = 0;
+   phase.cpuStart    = portable_getCpuTime();
+   phase.cpuTime     = 0.0;
+   phase.rssStart    = portable_getPeakMemory();
+   phase.rssDelta    = 0;
+   phase.entryCount  = 0;
+   phase.classCount  = 0;
+   phase.memberCount = 0;
+
+   // counters are totals, the values for the phase are set in end()
+   phase.lookupHits      = Doxy_Globals::lookupCache.hits();
+   phase.lookupMisses    = Doxy_Globals::lookupCache.misses();
+   phase.lookupEvictions = Doxy_Globals::lookupCache.evictions();
+
+   m_openPhases.append(m_phases.size());
+   m_phases.append(phase);
+}
+
+void Statistics::end()
+{
+   if (! m_enabled || m_openPhases.isEmpty()) {
+      return;
+   }
+
+   PhaseInfo &phase = m_phases[m_openPhases.takeLast()];
+
+   phase.wallTime = m_timer.nsecsElapsed() / 1000 - phase.startTime;
+   phase.cpuTime  = portable_getCpuTime() - phase.cpuStart;
+   phase.rssDelta = portable_getPeakMemory() - phase.rssStart;
+
+   phase.entryCount = Entry::num;
+   phase.classCount = Doxy_Globals::classSDict.count() + Doxy_Globals::hiddenClasses.count();
+
+   int memberCount = 0;
+
+   for (const auto &mn : Doxy_Globals::memberNameSDict) {
+      memberCount += mn->count();
+   }
+
+   for (const auto &mn : Doxy_Globals::functionNameSDict) {
+      memberCount += mn->count();
+   }
+
+   phase.memberCount = memberCount;
+
+   phase.lookupHits      = Doxy_Globals::lookupCache.hits()      - phase.lookupHits;
+   phase.lookupMisses    = Doxy_Globals::lookupCache.misses()    - phase.lookupMisses;
+   phase.lookupEvictions = Doxy_Globals::lookupCache.evictions() - phase.lookupEvictions;
+}
+
+void Statistics::print()
+{
+   if (! m_enabled || m_phases.isEmpty()) {
+      return;
+   }
+
+   // close any phase which was not ended
+   while (! m_openPhases.isEmpty()) {
+      end();
+   }
+
+   if (Debug::isFlagSet(Debug::Time)) {
+      qint64 totalWall = 0;
+      double totalCpu  = 0.0;
+
+      printf("\n**  Phase Statistics\n\n");
+      printf("   %-52s %10s %10s %12s %10s %10s %10s %10s %8s %10s\n", "Phase", "Wall (s)", "CPU (s)",
+            "Peak RSS +MB", "Entries", "Classes", "Members", "Lookups", "Hit %", "Evicted");
+
+      for (const auto &phase : m_phases) {
+         QString label = QString(phase.depth * 2, ' ') + phase.name;
+
+         if (label.length() > 52) {
+            label = label.left(49) + "...";
+         }
+
+         qint64 lookups = phase.lookupHits + phase.lookupMisses;
+         double hitRate = lookups > 0 ? 100.0 * phase.lookupHits / lookups : 0.0;
+
+         printf("   %-52s %10.3f %10.3f %12.1f %10d %10d %10d %10lld %8.1f %10lld\n", csPrintable(label),
+               phase.wallTime / 1.0e6, phase.cpuTime, phase.rssDelta / (1024.0 * 1024.0),
+               phase.entryCount, phase.classCount, phase.memberCount,
+               lookups, hitRate, phase.lookupEvictions);
+
+         if (phase.depth == 0) {
+            totalWall += phase.wallTime;
+            totalCpu  += phase.cpuTime;
+         }
+      }
+
+      printf("\n   %-52s %10.3f %10.3f %12.1f\n\n", "Total", totalWall / 1.0e6, totalCpu,
+            portable_getPeakMemory() / (1024.0 * 1024.0));
+   }
+
+   if (! m_traceFile.isEmpty()) {
+      writeTraceFile();
+   }
+}
+
+void Statistics::writeTraceFile()
+{
+   // chrome trace event format, complete events are nested by their start time and duration
+   QJsonArray events;
+
+   for (const auto &phase : m_phases) {
+      QJsonObject args;
+      args.insert("depth",          phase.depth);
+      args.insert("cpu_ms",         phase.cpuTime * 1000.0);
+      args.insert("peak_rss_delta", double(phase.rssDelta));
+      args.insert("entries",        phase.entryCount);
+      args.insert("classes",        phase.classCount);
+      args.insert("members",        phase.memberCount);
+      args.insert("lookup_hits",    double(phase.lookupHits));
+      args.insert("lookup_misses",  double(phase.lookupMisses));
+      args.insert("lookup_evicted", double(phase.lookupEvictions));
+
+      QJsonObject event;
+      event.insert("name", phase.name);
+      event.insert("cat",  QString("phase"));
+      event.insert("ph",   QString("X"));
+      event.insert("ts",   double(phase.startTime));
+      event.insert("dur",  double(phase.wallTime));
+      event.insert("pid",  1);
+      event.insert("tid",  1);
+      event.insert("args", args);
+
+      events.append(event);
+   }
+
+   QJsonObject object;
+   object.insert("traceEvents",     events);
+   object.insert("displayTimeUnit", QString("ms"));
+
+   QFile file(m_traceFile);
+
+   if (! file.open(QIODevice::WriteOnly)) {
+      err("Unable to open trace file %s for writing\n", csPrintable(m_traceFile));
+      return;
+   }
+
+   file.write(QJsonDocument(object).toJson());
+   file.close();
+
+   msg("Trace file written to %s\n", csPrintable(m_traceFile));
+}
@@ -31,6 +31,7 @@
 #include <filenamelist.h>
 #include <formula.h>
 #include <groupdef.h>
+#include <lookupcache.h>
 #include <membergroup.h>
 #include <membername.h>
 #include <message.h>
@@ -42,28 +43,14 @@
 #include <stringmap.h>
 
 #include <QByteArray>
-#include <QCache>
+#include <QElapsedTimer>
 #include <QHash>
 #include <QList>
 #include <QMultiHash>
 #include <QSharedPointer>
 #include <QString>
 #include <QTime>
-
-struct LookupInfo {
-   LookupInfo()
-   { }
-
-   LookupInfo(QSharedPointer<ClassDef> cd, QSharedPointer<MemberDef> td, QString ts, QString rt)
-      : classDef(cd), typeDef(td), templSpec(ts), resolvedType(rt)
-   {}
-
-   QSharedPointer<ClassDef>  classDef;
-   QSharedPointer<MemberDef> typeDef;
-
-   QString templSpec;
-   QString resolvedType;
-};
+#include <QVector>
 
 class StringDict : public QHash<QString, QString>
 {
@@ -75,19 +62,60 @@ class StringDict : public QHash<QString, QString>
    {}
 };
 
+/** Collects timing, memory, and object counts for each processing phase */
 class Statistics
 {
  public:
    Statistics()
    {}
 
-   void begin(const QString &name) {
-      msg(name);
-   }
+   // phases may be nested, each call to begin() must be matched by a call to end()
+   void begin(const QString &name, bool display = true);
+   void end();
 
-   void end() {
+   // summary table is displayed when "-d time" is passed, trace file is written when "--trace" is passed
+   void setEnabled(bool enabled);
+   void setTraceFile(const QString &fileName);
+
+   bool isEnabled() const {
+      return m_enabled;
    }
 
+   void print();
+
+ private:
+   struct PhaseInfo {
+      QString name;
+      int     depth;
+
+      qint64  startTime;          // wall time in microseconds, relative to the first phase
+      qint64  wallTime;           // microseconds
+
+      double  cpuStart;           // seconds
+      double  cpuTime;
+
+      qint64  rssStart;           // bytes
+      qint64  rssDelta;
+
+      // number of objects which exist when the phase ends
+      int     entryCount;
+      int     classCount;
+      int     memberCount;
+
+      // lookup cache activity during the phase
+      qint64  lookupHits;
+      qint64  lookupMisses;
+      qint64  lookupEvictions;
+   };
+
+   void writeTraceFile();
+
+   bool    m_enabled = false;
+   QString m_traceFile;
+
+   QElapsedTimer      m_timer;
+   QVector<PhaseInfo> m_phases;
+   QVector<int>       m_openPhases;
 };
 
 namespace Doxy_Work{
@@ -164,7 +192,7 @@ class Doxy_Globals
       static QHash<long, QSharedPointer<MemberGroupInfo>> memGrpInfoDict;
 
       static StringMap<QSharedPointer<DirRelation>>       dirRelations;
-      static QCache<QString, LookupInfo>                  lookupCache;
+      static LookupCache                                  lookupCache;
 
       static QString htmlFileExtension;
       static QString latexStyleExtension;
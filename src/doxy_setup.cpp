@@ -35,6 +35,7 @@
 #include <cmdmapper.h>
 #include <code_cstyle.h>
 #include <config.h>
+#include <dotlayout.h>
 #include <doxy_globals.h>
 #include <doxy_build_info.h>
 #include <entry.h>
@@ -57,6 +58,7 @@
 #include <portable.h>
 #include <pre.h>
 #include <rtfgen.h>
+#include <searchreader.h>
 #include <util.h>
 
 namespace Doxy_Setup {
@@ -75,6 +77,8 @@ enum Options {
      DATETIME,
      HELP,
      OUTPUT_APP,
+     SEARCH_QUERY,
+     TRACE,
      DVERSION,
 };
 
@@ -142,6 +146,7 @@ void shutDownDoxyPress()
 
    Mappers::freeMappers();
    codeFreeScanner();
+   DotLayout::cleanup();
 }
 
 // **
@@ -160,6 +165,8 @@ CommandLine parseCommandLine(QStringList argList)
 
    argMap.insert( "--dt",       DATETIME        );
    argMap.insert( "--help",     HELP            );
+   argMap.insert( "--search-query", SEARCH_QUERY );
+   argMap.insert( "--trace",    TRACE           );
    argMap.insert( "--version",  DVERSION        );
 
    QStringList dashList;
@@ -358,6 +365,30 @@ CommandLine parseCommandLine(QStringList argList)
             cmdArgs.dateTimeStr = getValue(iter, argList.end());
             break;
 
+         case TRACE:
+            cmdArgs.traceName = getValue(iter, argList.end());
+
+            if (cmdArgs.traceName.isEmpty()) {
+               err("Option \"--trace\" is missing a file name\n");
+               Doxy_Work::stopDoxyPress();
+            }
+
+            Doxy_Globals::infoLog_Stat.setTraceFile(cmdArgs.traceName);
+            break;
+
+         case SEARCH_QUERY:
+         {
+            QString indexName = getValue(iter, argList.end());
+            QString queryText = getValue(iter, argList.end());
+
+            if (indexName.isEmpty() || queryText.isEmpty()) {
+               err("Option \"--search-query\" requires the search index file name and the query\n");
+               Doxy_Work::stopDoxyPress();
+            }
+
+            exit(searchQuery(indexName, queryText) ? 0 : 1);
+         }
+
          case HELP:
             usage();
             exit(0);
@@ -369,6 +400,10 @@ CommandLine parseCommandLine(QStringList argList)
       }
    }
 
+   if (Debug::isFlagSet(Debug::Time)) {
+      Doxy_Globals::infoLog_Stat.setEnabled(true);
+   }
+
    // is there anything left in the arguemnent list
    cmdArgs.configName = getValue(iter, argList.end());
 
@@ -716,6 +751,14 @@ void Doxy_Setup::usage()
    printf("Use passed date/time value in the output footer (yyyy/MM/dd HH:mm:ss):\n");
    printf("   --dt <date_time>          Default is the current system date and time\n");
 
+   printf("\n");
+   printf("Write timing and memory usage for each phase in the Chrome trace format:\n");
+   printf("   --trace <file name>\n");
+
+   printf("\n");
+   printf("Query the search index written when search-server-based is enabled:\n");
+   printf("   --search-query <html-output/search/search.dxs> \"<words>\"\n");
+
    printf("\n");
    printf("Other Options:\n");
    printf("   -b      turns off output buffering of displayed messages\n");
@@ -34,6 +34,7 @@ struct CommandLine {
    QString layoutName;
    QString debugLabel;
    QString formatName;
+   QString traceName;
 
    QString rtfExt;
    QString rtfStyle;
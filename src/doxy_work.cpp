@@ -26,6 +26,7 @@
 #include <config.h>
 #include <declinfo.h>
 #include <default_args.h>
+#include <dirscanner.h>
 #include <docbookgen.h>
 #include <docparser.h>
 #include <docsets.h>
@@ -34,11 +35,14 @@
 #include <doxy_globals.h>
 #include <doxy_setup.h>
 #include <eclipsehelp.h>
+#include <entrycache.h>
+#include <filtercache.h>
 #include <ftvhelp.h>
 #include <htags.h>
 #include <htmlgen.h>
 #include <htmlhelp.h>
 #include <index.h>
+#include <inputreader.h>
 #include <language.h>
 #include <latexgen.h>
 #include <layout.h>
@@ -49,6 +53,7 @@
 #include <parse_clang.h>
 #include <parse_cstyle.h>
 #include <parse_py.h>
+#include <patternmatcher.h>
 #include <perlmodgen.h>
 #include <portable.h>
 #include <pre.h>
@@ -380,8 +385,9 @@ namespace Doxy_Work{
    void organizeSubGroupsFiltered(QSharedPointer<Entry> ptrEntry, bool additional);
    void organizeSubGroups(QSharedPointer<Entry> ptrEntry);
 
-   void parseFile(ParserInterface *parser, QSharedPointer<Entry> ptrEntry,
-         QSharedPointer<FileDef> fd, QString fileName, enum ParserMode mode, QStringList &filesInSameTu);
+   void parseFile(ParserInterface *parser, QSharedPointer<Entry> ptrEntry, QSharedPointer<FileDef> fd,
+         QString fileName, QString fileContents, enum ParserMode mode, QStringList &filesInSameTu,
+         bool isPreprocessed = false);
 
    void parseFiles(QSharedPointer<Entry> ptrEntry);
 
@@ -417,6 +423,9 @@ struct ReadDirArgs {
 
    bool isPathSet = false;
    QSet<QString> pathSet;
+
+   // directory listings which were read ahead on worker threads
+   DirScanner *scanner = nullptr;
 };
 
    void readFileOrDirectory(const QString &fileName, ReadDirArgs &data);
@@ -452,6 +461,7 @@ using namespace Doxy_Work;
 void processFiles()
 {
    printf("Parse input files\n");
+   Doxy_Globals::infoLog_Stat.begin("Process input files", false);
 
    static const QString outputDir    = Config::getString("output-dir");
    static const bool generateHtml    = Config::getBool("generate-html");
@@ -518,6 +528,18 @@ void processFiles()
       xmlOutput = createOutputDirectory(outputDir, "xml-output", "/xml");
    }
 
+   static const QString entryCacheDir = Config::getString("entry-cache-dir");
+
+   if (! entryCacheDir.isEmpty()) {
+      EntryCache::instance().setDirectory(createOutputDirectory(outputDir, "entry-cache-dir", "/entry-cache"));
+   }
+
+   static const QString filterCacheDir = Config::getString("filter-cache-dir");
+
+   if (! filterCacheDir.isEmpty()) {
+      FilterCache::instance().setDirectory(createOutputDirectory(outputDir, "filter-cache-dir", "/filter-cache"));
+   }
+
    if (haveDot) {
       static const QString dotFontPath = Config::getString("dot-font-path");
 
@@ -535,6 +557,18 @@ void processFiles()
          portable_setenv("DOTFONTPATH", dotFontPath);
 
       }
+
+      static const QString dotCacheDir = Config::getString("dot-cache-dir");
+
+      if (! dotCacheDir.isEmpty()) {
+         QString cacheDir = createOutputDirectory(outputDir, "dot-cache-dir", "/dot-cache");
+
+         DotCache::setDirectory(cacheDir);
+         DotProfile::load(cacheDir + "/profile.txt");
+
+      } else {
+         DotProfile::load(outputDir + "/dot_profile.txt");
+      }
    }
 
    // handle layout file
@@ -622,7 +656,6 @@ void processFiles()
    Doxy_Globals::infoLog_Stat.end();
 
    // done with input scanning, free up the buffers used by lex (can be around 4MB)
-   preFreeScanner();
    cstyleFreeParser();
    pyFreeParser();
 
@@ -714,6 +747,7 @@ void processFiles()
    // UNO IDL
    Doxy_Globals::infoLog_Stat.begin("Building interface member list\n");
    buildInterfaceAndServiceList(root);
+   Doxy_Globals::infoLog_Stat.end();
 
    // using class info only
    Doxy_Globals::infoLog_Stat.begin("Building member list\n");
@@ -895,12 +929,16 @@ void processFiles()
    Doxy_Globals::infoLog_Stat.begin("Adding members to index pages\n");
    addMembersToIndex();
    Doxy_Globals::infoLog_Stat.end();
+
+   // end of "Process input files"
+   Doxy_Globals::infoLog_Stat.end();
 }
 
 void generateOutput()
 {
    // initialize output generators
    printf("\n**  Generate Documentation Output\n");
+   Doxy_Globals::infoLog_Stat.begin("Generate documentation output", false);
 
    if (Doxy_Globals::dumpGlossary) {
       dumpGlossary();
@@ -969,6 +1007,8 @@ void generateOutput()
 
       Doxy_Globals::indexList.initialize();
       HtmlGenerator::writeTabData();
+
+      Doxy_Globals::infoLog_Stat.end();
    }
 
    if (generateDocbook) {
@@ -978,6 +1018,8 @@ void generateOutput()
 
       Doxy_Globals::outputList.add(obj);
       obj->init();
+
+      Doxy_Globals::infoLog_Stat.end();
    }
 
    if (generateLatex) {
@@ -987,6 +1029,8 @@ void generateOutput()
 
       Doxy_Globals::outputList.add(obj);
       obj->init();
+
+      Doxy_Globals::infoLog_Stat.end();
    }
 
    if (generateMan) {
@@ -996,10 +1040,13 @@ void generateOutput()
 
       Doxy_Globals::outputList.add(obj);
       obj->init();
+
+      Doxy_Globals::infoLog_Stat.end();
    }
 
    if (generatePerl) {
       Doxy_Globals::infoLog_Stat.begin("Enable Perl output\n");
+      Doxy_Globals::infoLog_Stat.end();
    }
 
    if (generateRtf) {
@@ -1011,10 +1058,13 @@ void generateOutput()
       obj->init();
 
       copyLogo(rtfOutput);
+
+      Doxy_Globals::infoLog_Stat.end();
    }
 
    if (generateXml) {
       Doxy_Globals::infoLog_Stat.begin("Enable XML output\n");
+      Doxy_Globals::infoLog_Stat.end();
    }
 
    if (Config::getBool("use-htags")) {
@@ -1193,22 +1243,15 @@ void generateOutput()
          HtmlGenerator::writeSearchPage();
          Doxy_Globals::searchIndexBase->write(htmlOutput + "/search/search.idx");
 
+         // same words in the layout used by --search-query
+         QSharedPointer<SearchIndex> searchIndex = Doxy_Globals::searchIndexBase.dynamicCast<SearchIndex>();
+         searchIndex->writeMapped(htmlOutput + "/search/search.dxs");
+
       } else {
          // write data for external search index
          HtmlGenerator::writeExternalSearchPage();
 
-         QString searchDataFile = Config::getString("search-data-file");
-
-         if (searchDataFile.isEmpty()) {
-            searchDataFile = "searchdata.xml";
-         }
-
-         if (! QDir::isAbsolutePath(searchDataFile)) {
-            QString outputDirectory = Config::getString("output-dir");
-            searchDataFile.prepend(outputDirectory + "/");
-         }
-
-         Doxy_Globals::searchIndexBase->write(searchDataFile);
+         Doxy_Globals::searchIndexBase->write(searchDataFileName());
       }
 
       Doxy_Globals::infoLog_Stat.end();
@@ -1299,7 +1342,16 @@ void generateOutput()
       Doxy_Globals::infoLog_Stat.end();
    }
 
-   msg("Lookup cache used %d/%d \n", Doxy_Globals::lookupCache.count(), Doxy_Globals::lookupCache.size());
+   // end of "Generate documentation output"
+   Doxy_Globals::infoLog_Stat.end();
+
+   FilterCache::instance().prune();
+
+   msg("Lookup cache entries %d, cost %d/%d, hits %lld, misses %lld, evictions %lld\n", Doxy_Globals::lookupCache.count(),
+         Doxy_Globals::lookupCache.totalCost(), Doxy_Globals::lookupCache.maxCost(), Doxy_Globals::lookupCache.hits(),
+         Doxy_Globals::lookupCache.misses(), Doxy_Globals::lookupCache.evictions());
+   Doxy_Globals::infoLog_Stat.print();
+
    msg("Finished\n");
 
    // all done, cleaning up and exit
@@ -10195,8 +10247,7 @@ static ParserInterface *getParserForFile(const QString &fileName)
    return Doxy_Globals::parserManager.getParser(extension);
 }
 
-void Doxy_Work::parseFile(ParserInterface *parser, QSharedPointer<Entry> root,
-      QSharedPointer<FileDef> fd, QString fileName, enum ParserMode mode, QStringList &includedFiles)
+static bool needsPreprocessing(ParserInterface *parser, const QString &fileName)
 {
    static const bool clangParsing        = Config::getBool("clang-parsing");
    static const bool enablePreprocessing = Config::getBool("enable-preprocessing");
@@ -10210,19 +10261,25 @@ void Doxy_Work::parseFile(ParserInterface *parser, QSharedPointer<Entry> root,
       extension = ".no_extension";
    }
 
-   QFileInfo fi(fileName);
-   QString fileContents;
+   // if clang processing the preprocessor is not used
+   return ! clangParsing && enablePreprocessing && parser->needsPreprocessing(extension);
+}
+
+void Doxy_Work::parseFile(ParserInterface *parser, QSharedPointer<Entry> root, QSharedPointer<FileDef> fd,
+      QString fileName, QString fileContents, enum ParserMode mode, QStringList &includedFiles, bool isPreprocessed)
+{
+   static const bool clangParsing = Config::getBool("clang-parsing");
 
-   if (! clangParsing && enablePreprocessing && parser->needsPreprocessing(extension)) {
+   // fileContents was read by the caller, possibly preprocessed on a worker thread
+   if (needsPreprocessing(parser, fileName)) {
       msg("Processing %s\n", csPrintable(fileName));
 
-      fileContents = readInputFile(fileName);
-      fileContents = preprocessFile(fileName, fileContents);
+      if (! isPreprocessed) {
+         fileContents = preprocessFile(fileName, fileContents);
+      }
 
    } else {
-      // no preprocessing, if clang processing this branch is forced
       msg("Reading %s\n", csPrintable(fileName));
-      fileContents = readInputFile(fileName);
    }
 
    if (! fileContents.endsWith("\n")) {
@@ -10240,6 +10297,18 @@ void Doxy_Work::parseFile(ParserInterface *parser, QSharedPointer<Entry> root,
       // use clang for parsing
       parser->parseInput(fileName, buffer, root, mode, includedFiles, true);
 
+   } else if (EntryCache::instance().isEnabled() && ! clangParsing) {
+      // the key is computed after preprocessing, root only holds the entries for this file
+      EntryCache &cache = EntryCache::instance();
+      QByteArray key    = cache.key(fileName, buffer);
+
+      if (! cache.load(key, root)) {
+         EntryCache::Snapshot before = cache.snapshot();
+
+         parser->parseInput(fileName, buffer, root, mode, includedFiles, false);
+         cache.store(key, root, before);
+      }
+
    } else {
       // use lex for parser
       parser->parseInput(fileName, buffer, root, mode, includedFiles, false);
@@ -10257,6 +10326,8 @@ void Doxy_Work::parseFiles(QSharedPointer<Entry> root)
    static const bool clangParsing = Config::getBool("clang-parsing");
 
    if (clangParsing) {
+      static const int clangNumThreads = Config::getInt("clang-num-threads");
+
       QSet<QString> processedFiles;
       QSet<QString> filesToProcess;
 
@@ -10264,6 +10335,46 @@ void Doxy_Work::parseFiles(QSharedPointer<Entry> root)
          filesToProcess.insert(fName);
       }
 
+      int numThreads = qMin(32, clangNumThreads);
+
+      if (numThreads == 0) {
+         numThreads = qMax(2, QThread::idealThreadCount());
+
+      } else if (numThreads == 1) {
+         // translation units are parsed on the main thread
+         numThreads = 0;
+      }
+
+      // source files which are passed to libclang in the first pass
+      QStringList clangSources;
+
+      if (numThreads > 0) {
+         for (auto fName : Doxy_Globals::g_inputFiles) {
+            bool ambig;
+
+            QSharedPointer<FileDef> fd = findFileDef(&Doxy_Globals::inputNameDict, fName, ambig);
+
+            if (fd != nullptr && fd->isSource() && ! fd->isReference()) {
+               auto srcLang = fd->getLanguage();
+
+               if (srcLang == SrcLangExt_Cpp || srcLang == SrcLangExt_ObjC) {
+                  clangSources.append(fName);
+               }
+            }
+         }
+
+         if (! clangSources.isEmpty()) {
+            ClangParser::instance()->startPool(numThreads);
+            msg("Parsing %d source files with libclang, using %d threads\n", clangSources.count(), numThreads);
+         }
+      }
+
+      // contents of queued files, read once
+      QHash<QString, QString> queuedContents;
+
+      int numQueued  = 0;
+      int numStarted = 0;
+
       // process source files and their include dependencies
       for (auto fName : Doxy_Globals::g_inputFiles) {
          bool ambig;
@@ -10276,8 +10387,42 @@ void Doxy_Work::parseFiles(QSharedPointer<Entry> root)
 
             auto srcLang = fd->getLanguage();
 
+            if (srcLang == SrcLangExt_Cpp || srcLang == SrcLangExt_ObjC) {
+               ++numStarted;
+            }
+
+            // keep the workers busy with the next source files, the entries are still created in order
+            int maxQueued = qMin(clangSources.count(), numStarted + numThreads);
+
+            while (numQueued < maxQueued) {
+               const QString &item = clangSources.at(numQueued);
+               QSharedPointer<FileDef> qfd = findFileDef(&Doxy_Globals::inputNameDict, item, ambig);
+
+               QString contents = readInputFile(item);
+               queuedContents.insert(item, contents);
+
+               // must match the buffer parseFile() passes to the parser
+               if (! contents.endsWith("\n")) {
+                  contents += '\n';
+               }
+
+               QStringList queuedIncludes;
+               qfd->getAllIncludeFilesRecursively(queuedIncludes);
+
+               ClangParser::instance()->queueUnit(item, convertCppComments(contents, item), queuedIncludes);
+               ++numQueued;
+            }
+
+            QString fileContents;
+
+            if (queuedContents.contains(fName)) {
+               fileContents = queuedContents.take(fName);
+            } else {
+               fileContents = readInputFile(fName);
+            }
+
             ParserInterface *parser = getParserForFile(fName);
-            parseFile(parser, root, fd, fName, ParserMode::SOURCE_FILE, includedFiles);
+            parseFile(parser, root, fd, fName, fileContents, ParserMode::SOURCE_FILE, includedFiles);
 
             // process any include files in the the current source file
             for (auto file : includedFiles) {
@@ -10292,7 +10437,7 @@ void Doxy_Work::parseFiles(QSharedPointer<Entry> root)
                   if (ifd && ! ifd->isReference()) {
                      QStringList moreFiles;
 
-                     parseFile(parser, root, ifd, file, ParserMode::INCLUDE_FILE, moreFiles);
+                     parseFile(parser, root, ifd, file, readInputFile(file), ParserMode::INCLUDE_FILE, moreFiles);
                      processedFiles.insert(file);
                   }
                }
@@ -10306,6 +10451,8 @@ void Doxy_Work::parseFiles(QSharedPointer<Entry> root)
          }
       }
 
+      ClangParser::instance()->stopPool();
+
       // process remaining files, treat as source files even if they are header files
       for (auto fName : Doxy_Globals::g_inputFiles) {
 
@@ -10320,7 +10467,7 @@ void Doxy_Work::parseFiles(QSharedPointer<Entry> root)
             auto srcLang = fd->getLanguage();
 
             ParserInterface *parser = getParserForFile(fName);
-            parseFile(parser, root, fd, fName, ParserMode::SOURCE_FILE, includedFiles);
+            parseFile(parser, root, fd, fName, readInputFile(fName), ParserMode::SOURCE_FILE, includedFiles);
 
             if (srcLang == SrcLangExt_Cpp || srcLang == SrcLangExt_ObjC) {
                ClangParser::instance()->finish();
@@ -10332,6 +10479,35 @@ void Doxy_Work::parseFiles(QSharedPointer<Entry> root)
 
    } else  {
       // use lex and not clang
+      static const int readNumThreads = Config::getInt("read-num-threads");
+
+      int numThreads = qMin(32, readNumThreads);
+
+      if (numThreads == 0) {
+         numThreads = qMax(2, QThread::idealThreadCount());
+
+      } else if (numThreads == 1) {
+         // files are read on the main thread
+         numThreads = 0;
+      }
+
+      // input files are read, filtered, and preprocessed on worker threads, the lex parsers
+      // share global state and run on this thread in the order of g_inputFiles
+      InputReader reader(Doxy_Globals::g_inputFiles, numThreads, [](const QString &fName) {
+         QString fileContents = readInputFile(fName);
+
+         if (needsPreprocessing(getParserForFile(fName), fName)) {
+            fileContents = preprocessFile(fName, fileContents);
+         }
+
+         return fileContents;
+      });
+
+      if (reader.threadCount() > 0) {
+         msg("Reading input files using %d threads\n", reader.threadCount());
+      }
+
+      int index = 0;
 
       for (auto fName : Doxy_Globals::g_inputFiles) {
          QStringList includedFiles;
@@ -10341,8 +10517,30 @@ void Doxy_Work::parseFiles(QSharedPointer<Entry> root)
          QSharedPointer<FileDef> fd = findFileDef(&Doxy_Globals::inputNameDict, fName, ambig);
          assert(fd != nullptr);
 
+         QString fileContents = reader.take(index);
+         ++index;
+
+         // each file is parsed into a separate tree which is then attached to the root
+         QSharedPointer<Entry> fileRoot = QMakeShared<Entry>();
+
          ParserInterface *parser = getParserForFile(fName);
-         parseFile(parser, root, fd, fName, ParserMode::SOURCE_FILE, includedFiles);
+         parseFile(parser, fileRoot, fd, fName, fileContents, ParserMode::SOURCE_FILE, includedFiles, true);
+
+         for (auto child : fileRoot->children()) {
+            root->addSubEntry(child);
+         }
+      }
+
+      if (EntryCache::instance().isEnabled()) {
+         EntryCache::instance().prune();
+
+         msg("Entry cache, %d files loaded, %d files parsed\n", EntryCache::instance().hitCount(),
+               EntryCache::instance().missCount());
+      }
+
+      if (FilterCache::instance().hitCount() > 0 || FilterCache::instance().missCount() > 0) {
+         msg("Filter cache, %d files reused, %d files filtered\n", FilterCache::instance().hitCount(),
+               FilterCache::instance().missCount());
       }
    }
 }
@@ -10516,13 +10714,14 @@ void Doxy_Work::readDir(const QFileInfo &fi, ReadDirArgs &data)
       Doxy_Globals::g_pathsVisited.insert(dirName);
    }
 
-   QDir dir(dirName);
-   dir.setFilter(QDir::Files | QDir::Dirs | QDir::Hidden);
-
    int totalSize = 0;
    msg("Searching for files in directory %s\n", csPrintable(fi.absoluteFilePath()) );
 
-   const QFileInfoList list = dir.entryInfoList();
+   const QFileInfoList list = (data.scanner != nullptr) ? data.scanner->entryList(dirName) : DirScanner::readDirectory(dirName);
+
+   // pattern lists are compiled once and shared by all directories
+   QSharedPointer<const FilePatternMatcher> includeMatcher = FilePatternMatcher::instance(data.includePatternList);
+   QSharedPointer<const FilePatternMatcher> excludeMatcher = FilePatternMatcher::instance(data.excludePatternList);
 
    for (auto &cfi : list) {
       QString filePath = cfi.absoluteFilePath();
@@ -10543,8 +10742,8 @@ void Doxy_Work::readDir(const QFileInfo &fi, ReadDirArgs &data)
 
             if (cfi.isFile()) {
 
-               bool testA = (data.includePatternList.isEmpty() || patternMatch(cfi, data.includePatternList));
-               bool testB = (! patternMatch(cfi, data.excludePatternList));
+               bool testA = (data.includePatternList.isEmpty() || includeMatcher->match(cfi));
+               bool testB = (! excludeMatcher->match(cfi));
 
                if (testA && testB && ! data.killSet.contains(filePath) ) {
 
@@ -10589,7 +10788,7 @@ void Doxy_Work::readDir(const QFileInfo &fi, ReadDirArgs &data)
                   continue;
                }
 
-               if (patternMatch(cfi, data.excludePatternList) ) {
+               if (excludeMatcher->match(cfi)) {
                   continue;
                }
 
@@ -10671,7 +10870,26 @@ void Doxy_Work::readFileOrDirectory(const QString &str, ReadDirArgs &data)
 
          } else if (fi.isDir()) {
             // readable dir
-            readDir(fi, data);
+            static const int scanNumThreads = Config::getInt("scan-num-threads");
+
+            int numThreads = qMin(32, scanNumThreads);
+
+            if (numThreads == 0) {
+               numThreads = qMax(2, QThread::idealThreadCount());
+            }
+
+            if (data.recursive && numThreads > 1 && data.scanner == nullptr) {
+               // read the directory tree on worker threads, the walk below consumes the listings in order
+               DirScanner scanner(numThreads);
+               scanner.scan(filePath, FilePatternMatcher::instance(data.excludePatternList));
+
+               data.scanner = &scanner;
+               readDir(fi, data);
+               data.scanner = nullptr;
+
+            } else {
+               readDir(fi, data);
+            }
          }
       }
    }
@@ -25,14 +25,20 @@
 #include <doxy_globals.h>
 #include <section.h>
 
+std::atomic<int> Entry::num{0};
+
 Entry::Entry()
 {
+   ++num;
+
    m_parent.clear();
    reset();
 }
 
 Entry::Entry(const Entry &e)
 {
+   ++num;
+
    m_tagInfo        = e.m_tagInfo;
    argList          = e.argList;
    typeConstr       = e.typeConstr;
@@ -95,6 +101,7 @@ Entry::Entry(const Entry &e)
 
 Entry::~Entry()
 {
+   --num;
 }
 
 void Entry::reset()
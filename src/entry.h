@@ -31,6 +31,7 @@
 #include <QString>
 #include <QVector>
 
+#include <atomic>
 #include <bitset>
 
 class FileDef;
@@ -445,6 +446,8 @@ class Entry : public EnableSharedFromThis
    QVector<SectionInfo>   m_anchors;             // list of anchors defined in this entry
    QVector<ListItemInfo>  m_specialLists;        // special lists (test/todo/bug/deprecated/..)
 
+   static std::atomic<int> num;                  // number of Entry objects which currently exist
+
    // return command name used to define GROUPDOC_SEC
    QString groupDocCmd() const {
 
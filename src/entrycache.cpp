@@ -0,0 +1,482 @@
+/************************************************************************
+*
+* Copyright (c) 2014-2025 Barbara Geller & Ansel Sermersheim
+*
+* Copyright (c) 1997-2014 Dimitri van Heesch
+*
+* DoxyPress is free software. You can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* version 2 as published by the Free Software Foundation.
+*
+* DoxyPress is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+*
+* Documents produced by DoxyPress are derivative works derived from the
+* input used in their production; they are not affected by this license.
+*
+* https://www.gnu.org/licenses/
+*
+*************************************************************************/
+
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+
+#include <entrycache.h>
+
+#include <config.h>
+#include <doxy_build_info.h>
+#include <doxy_globals.h>
+#include <membergroup.h>
+#include <message.h>
+
+// change when the layout of the stored data changes
+static const qint32 cacheFormat = 1;
+static const char  *cacheMagic  = "DPEC";
+
+static void writeArgumentList(QDataStream &stream, const ArgumentList &argList)
+{
+   stream << qint32(argList.count());
+
+   for (const auto &arg : argList) {
+      stream << arg.attrib << arg.type << arg.name << arg.array << arg.defval << arg.docs << arg.typeConstraint;
+   }
+
+   stream << argList.constSpecifier << argList.volatileSpecifier << argList.pureSpecifier
+          << qint32(argList.refSpecifier) << argList.trailingReturnType << argList.isDeleted;
+}
+
+static void readArgumentList(QDataStream &stream, ArgumentList &argList)
+{
+   qint32 count;
+   stream >> count;
+
+   for (int i = 0; i < count && stream.status() == QDataStream::Ok; ++i) {
+      Argument arg;
+      stream >> arg.attrib >> arg.type >> arg.name >> arg.array >> arg.defval >> arg.docs >> arg.typeConstraint;
+
+      argList.append(arg);
+   }
+
+   qint32 refSpecifier;
+
+   stream >> argList.constSpecifier >> argList.volatileSpecifier >> argList.pureSpecifier
+          >> refSpecifier >> argList.trailingReturnType >> argList.isDeleted;
+
+   argList.refSpecifier = static_cast<RefType>(refSpecifier);
+}
+
+static void writeEntry(QDataStream &stream, QSharedPointer<Entry> entry)
+{
+   // m_entryMap, only the keys which are set
+   for (int key = 0; key <= static_cast<int>(EntryKey::User_Property); ++key) {
+      QString data = entry->getData(static_cast<EntryKey>(key));
+
+      if (! data.isEmpty()) {
+         stream << qint32(key) << data;
+      }
+   }
+
+   stream << qint32(-1);
+
+   stream << entry->m_tagInfo.tag_Name << entry->m_tagInfo.tag_FileName << entry->m_tagInfo.tag_Anchor;
+
+   writeArgumentList(stream, entry->argList);
+   writeArgumentList(stream, entry->typeConstr);
+
+   stream << qint32(entry->relatesType) << qint32(entry->virt) << qint32(entry->protection)
+          << qint32(entry->mtype) << qint32(entry->groupDocType) << qint32(entry->m_srcLang)
+          << entry->m_traits.toQByteArray();
+
+   stream << qint32(entry->section) << qint32(entry->initLines)
+          << entry->referencedByRelation << entry->referencesRelation
+          << qint32(entry->docLine) << qint32(entry->briefLine) << qint32(entry->inbodyLine)
+          << qint32(entry->startBodyLine) << qint32(entry->endBodyLine) << qint32(entry->mGrpId)
+          << qint32(entry->startLine) << qint32(entry->startColumn);
+
+   const LocalToc &toc = entry->localToc;
+
+   stream << toc.isHtmlEnabled()    << qint32(toc.htmlLevel())
+          << toc.isLatexEnabled()   << qint32(toc.latexLevel())
+          << toc.isXmlEnabled()     << qint32(toc.xmlLevel())
+          << toc.isDocbookEnabled() << qint32(toc.docbookLevel());
+
+   stream << entry->m_static << entry->explicitExternal << entry->proto << entry->subGrouping
+          << entry->callGraph << entry->callerGraph << entry->hidden << entry->artificial;
+
+   stream << entry->m_entryName;
+
+   stream << qint32(entry->m_templateArgLists.count());
+
+   for (const auto &argList : entry->m_templateArgLists) {
+      writeArgumentList(stream, argList);
+   }
+
+   stream << qint32(entry->extends.count());
+
+   for (const auto &item : entry->extends) {
+      stream << item.name << qint32(item.prot) << qint32(item.virt);
+   }
+
+   stream << qint32(entry->m_groups.count());
+
+   for (const auto &item : entry->m_groups) {
+      stream << item.groupname << qint32(item.pri);
+   }
+
+   stream << qint32(entry->m_anchors.count());
+
+   for (const auto &item : entry->m_anchors) {
+      stream << item.label << item.title << item.ref << item.fileName << qint32(item.lineNr)
+             << qint32(item.level) << item.generated << qint32(item.type)
+             << qint32(item.dupAnchor_cnt) << item.dupAnchor_fName;
+   }
+
+   // children
+   stream << qint32(entry->children().count());
+
+   for (const auto &child : entry->children()) {
+      writeEntry(stream, child);
+   }
+}
+
+static void readEntry(QDataStream &stream, QSharedPointer<Entry> entry)
+{
+   qint32 key;
+   stream >> key;
+
+   while (key != -1 && stream.status() == QDataStream::Ok) {
+      QString data;
+      stream >> data;
+
+      entry->setData(static_cast<EntryKey>(key), data);
+      stream >> key;
+   }
+
+   stream >> entry->m_tagInfo.tag_Name >> entry->m_tagInfo.tag_FileName >> entry->m_tagInfo.tag_Anchor;
+
+   readArgumentList(stream, entry->argList);
+   readArgumentList(stream, entry->typeConstr);
+
+   qint32 relatesType;
+   qint32 virt;
+   qint32 protection;
+   qint32 mtype;
+   qint32 groupDocType;
+   qint32 srcLang;
+   QByteArray traits;
+
+   stream >> relatesType >> virt >> protection >> mtype >> groupDocType >> srcLang >> traits;
+
+   entry->relatesType  = static_cast<RelatesType>(relatesType);
+   entry->virt         = static_cast<Specifier>(virt);
+   entry->protection   = static_cast<Protection>(protection);
+   entry->mtype        = static_cast<MethodType>(mtype);
+   entry->groupDocType = static_cast<Entry::GroupDocType>(groupDocType);
+   entry->m_srcLang    = static_cast<SrcLangExt>(srcLang);
+   entry->m_traits     = Entry::Traits::fromQByteArray(traits);
+
+   qint32 section;
+   qint32 initLines;
+   qint32 docLine;
+   qint32 briefLine;
+   qint32 inbodyLine;
+   qint32 startBodyLine;
+   qint32 endBodyLine;
+   qint32 mGrpId;
+   qint32 startLine;
+   qint32 startColumn;
+
+   stream >> section >> initLines >> entry->referencedByRelation >> entry->referencesRelation
+          >> docLine >> briefLine >> inbodyLine >> startBodyLine >> endBodyLine >> mGrpId
+          >> startLine >> startColumn;
+
+   entry->section       = section;
+   entry->initLines     = initLines;
+   entry->docLine       = docLine;
+   entry->briefLine     = briefLine;
+   entry->inbodyLine    = inbodyLine;
+   entry->startBodyLine = startBodyLine;
+   entry->endBodyLine   = endBodyLine;
+   entry->mGrpId        = mGrpId;
+   entry->startLine     = startLine;
+   entry->startColumn   = startColumn;
+
+   bool   tocEnabled[LocalToc::numTocTypes];
+   qint32 tocLevel[LocalToc::numTocTypes];
+
+   for (int i = 0; i < LocalToc::numTocTypes; ++i) {
+      stream >> tocEnabled[i] >> tocLevel[i];
+   }
+
+   if (tocEnabled[LocalToc::Html]) {
+      entry->localToc.enableHtml(tocLevel[LocalToc::Html]);
+   }
+
+   if (tocEnabled[LocalToc::Latex]) {
+      entry->localToc.enableLatex(tocLevel[LocalToc::Latex]);
+   }
+
+   if (tocEnabled[LocalToc::Xml]) {
+      entry->localToc.enableXml(tocLevel[LocalToc::Xml]);
+   }
+
+   if (tocEnabled[LocalToc::Docbook]) {
+      entry->localToc.enableDocbook(tocLevel[LocalToc::Docbook]);
+   }
+
+   stream >> entry->m_static >> entry->explicitExternal >> entry->proto >> entry->subGrouping
+          >> entry->callGraph >> entry->callerGraph >> entry->hidden >> entry->artificial;
+
+   stream >> entry->m_entryName;
+
+   qint32 count;
+   stream >> count;
+
+   for (int i = 0; i < count && stream.status() == QDataStream::Ok; ++i) {
+      ArgumentList argList;
+      readArgumentList(stream, argList);
+
+      entry->m_templateArgLists.append(argList);
+   }
+
+   stream >> count;
+
+   for (int i = 0; i < count && stream.status() == QDataStream::Ok; ++i) {
+      QString name;
+      qint32 prot;
+      qint32 virtBase;
+
+      stream >> name >> prot >> virtBase;
+      entry->extends.append(BaseInfo(name, static_cast<Protection>(prot), static_cast<Specifier>(virtBase)));
+   }
+
+   stream >> count;
+
+   for (int i = 0; i < count && stream.status() == QDataStream::Ok; ++i) {
+      QString groupName;
+      qint32 pri;
+
+      stream >> groupName >> pri;
+      entry->m_groups.append(Grouping(groupName, static_cast<Grouping::GroupPri_t>(pri)));
+   }
+
+   stream >> count;
+
+   for (int i = 0; i < count && stream.status() == QDataStream::Ok; ++i) {
+      QString label;
+      QString title;
+      QString ref;
+      QString fileName;
+      qint32 lineNr;
+      qint32 level;
+      bool generated;
+      qint32 type;
+      qint32 dupAnchorCnt;
+      QString dupAnchorName;
+
+      stream >> label >> title >> ref >> fileName >> lineNr >> level >> generated >> type
+             >> dupAnchorCnt >> dupAnchorName;
+
+      SectionInfo si(fileName, lineNr, label, title, static_cast<SectionInfo::SectionType>(type), level, ref);
+      si.generated       = generated;
+      si.dupAnchor_cnt   = dupAnchorCnt;
+      si.dupAnchor_fName = dupAnchorName;
+
+      entry->m_anchors.append(si);
+   }
+
+   stream >> count;
+
+   for (int i = 0; i < count && stream.status() == QDataStream::Ok; ++i) {
+      QSharedPointer<Entry> child = QMakeShared<Entry>();
+      readEntry(stream, child);
+
+      entry->addSubEntry(child);
+   }
+}
+
+// returns true if the tree refers to global state which is created while parsing and is not restored by load()
+static bool usesParserState(QSharedPointer<Entry> entry)
+{
+   if (! entry->m_specialLists.isEmpty() || entry->mGrpId != DOX_NOGROUP) {
+      return true;
+   }
+
+   static const EntryKey docKeys[] = { EntryKey::Brief_Docs, EntryKey::Main_Docs, EntryKey::Inbody_Docs };
+
+   for (auto key : docKeys) {
+      QString docs = entry->getData(key);
+
+      if (docs.contains("\\form#") || docs.contains("\\xrefitem") || docs.contains("\\cite") || docs.contains("@cite")) {
+         return true;
+      }
+   }
+
+   for (const auto &child : entry->children()) {
+      if (usesParserState(child)) {
+         return true;
+      }
+   }
+
+   return false;
+}
+
+// anchors and sections are added to the global dictionary by the comment scanner
+static void registerAnchors(QSharedPointer<Entry> entry)
+{
+   for (const auto &item : entry->m_anchors) {
+      QSharedPointer<SectionInfo> si = Doxy_Globals::sectionDict.find(item.label);
+
+      if (si == nullptr) {
+         Doxy_Globals::sectionDict.insert(item.label, QMakeShared<SectionInfo>(item));
+
+      } else if (item.type == SectionInfo::Anchor) {
+         si->dupAnchor_cnt++;
+      }
+   }
+
+   for (const auto &child : entry->children()) {
+      registerAnchors(child);
+   }
+}
+
+EntryCache &EntryCache::instance()
+{
+   static EntryCache retval;
+   return retval;
+}
+
+EntryCache::EntryCache()
+   : m_hits(0), m_misses(0)
+{
+}
+
+void EntryCache::setDirectory(const QString &dirName)
+{
+   m_dirName    = dirName;
+   m_configHash = Config::getConfigHash();
+}
+
+QByteArray EntryCache::key(const QString &fileName, const QString &buffer) const
+{
+   QCryptographicHash hash(QCryptographicHash::Md5);
+
+   hash.addData(versionString.toUtf8());
+   hash.addData(m_configHash);
+   hash.addData(fileName.toUtf8());
+   hash.addData(buffer.toUtf8());
+
+   return hash.result().toHex();
+}
+
+QString EntryCache::cacheFileName(const QByteArray &key) const
+{
+   return m_dirName + "/" + QString::fromLatin1(key) + ".entry";
+}
+
+EntryCache::Snapshot EntryCache::snapshot() const
+{
+   Snapshot retval;
+
+   retval.formulaCount        = Doxy_Globals::formulaList.count();
+   retval.memberGroupCount    = Doxy_Globals::memGrpInfoDict.count();
+   retval.namespaceAliasCount = Doxy_Globals::namespaceAliasDict.count();
+
+   return retval;
+}
+
+bool EntryCache::load(const QByteArray &key, QSharedPointer<Entry> root)
+{
+   QFile file(cacheFileName(key));
+
+   if (! file.open(QIODevice::ReadOnly)) {
+      ++m_misses;
+      return false;
+   }
+
+   QDataStream stream(&file);
+
+   QByteArray magic;
+   qint32 format;
+
+   stream >> magic >> format;
+
+   if (magic != cacheMagic || format != cacheFormat) {
+      ++m_misses;
+      return false;
+   }
+
+   QSharedPointer<Entry> tmpRoot = QMakeShared<Entry>();
+   readEntry(stream, tmpRoot);
+
+   if (stream.status() != QDataStream::Ok) {
+      warn_uncond("Entry cache file %s is corrupt, file will be parsed\n", csPrintable(file.fileName()));
+
+      ++m_misses;
+      return false;
+   }
+
+   registerAnchors(tmpRoot);
+
+   for (const auto &child : tmpRoot->children()) {
+      root->addSubEntry(child);
+   }
+
+   m_usedKeys.insert(key);
+   ++m_hits;
+   return true;
+}
+
+void EntryCache::store(const QByteArray &key, QSharedPointer<Entry> root, const Snapshot &before)
+{
+   Snapshot after = snapshot();
+
+   if (after.formulaCount != before.formulaCount || after.memberGroupCount != before.memberGroupCount ||
+         after.namespaceAliasCount != before.namespaceAliasCount || usesParserState(root)) {
+      return;
+   }
+
+   // write to a temporary file so an interrupted run never leaves a partial cache entry
+   QString fileName = cacheFileName(key);
+   QFile file(fileName + ".tmp");
+
+   if (! file.open(QIODevice::WriteOnly)) {
+      err("Unable to open file %s for writing, OS Error #: %d\n", csPrintable(file.fileName()), file.error());
+      return;
+   }
+
+   QDataStream stream(&file);
+   stream << QByteArray(cacheMagic) << cacheFormat;
+
+   writeEntry(stream, root);
+   file.close();
+
+   QFile::remove(fileName);
+
+   if (file.rename(fileName)) {
+      m_usedKeys.insert(key);
+   }
+}
+
+void EntryCache::prune()
+{
+   // other projects or configurations may share the directory, their files are kept for a while
+   static const qint64 maxAge = 7 * 24 * 60 * 60;
+
+   const QDateTime now = QDateTime::currentDateTime();
+   const QFileInfoList fileList = QDir(m_dirName).entryInfoList(QStringList() << "*.entry" << "*.entry.tmp", QDir::Files);
+
+   for (const auto &fi : fileList) {
+      if (m_usedKeys.contains(fi.baseName().toLatin1())) {
+         continue;
+      }
+
+      if (fi.lastModified().secsTo(now) > maxAge) {
+         QFile::remove(fi.absoluteFilePath());
+      }
+   }
+}
@@ -0,0 +1,94 @@
+/************************************************************************
+*
+* Copyright (c) 2014-2025 Barbara Geller & Ansel Sermersheim
+*
+* Copyright (c) 1997-2014 Dimitri van Heesch
+*
+* DoxyPress is free software. You can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* version 2 as published by the Free Software Foundation.
+*
+* DoxyPress is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+*
+* Documents produced by DoxyPress are derivative works derived from the
+* input used in their production; they are not affected by this license.
+*
+* https://www.gnu.org/licenses/
+*
+*************************************************************************/
+
+#ifndef ENTRYCACHE_H
+#define ENTRYCACHE_H
+
+#include <entry.h>
+
+#include <QByteArray>
+#include <QSet>
+#include <QSharedPointer>
+#include <QString>
+
+/** On disk cache of the entry tree produced for each input file
+ *
+ *  A cache entry is keyed by the file name, the text passed to the parser and a hash of the settings
+ *  which affect parsing. Since the key is computed after preprocessing, changes to included headers
+ *  which alter the expanded text are detected as well. Files whose parse registered global
+ *  state which can not be restored from the tree (xref items, formulas, citations, member groups,
+ *  namespace aliases) are never stored.
+ */
+class EntryCache
+{
+ public:
+   // global state which is checked to decide if a parsed file can be stored
+   struct Snapshot {
+      int formulaCount;
+      int memberGroupCount;
+      int namespaceAliasCount;
+   };
+
+   static EntryCache &instance();
+
+   void setDirectory(const QString &dirName);
+
+   bool isEnabled() const {
+      return ! m_dirName.isEmpty();
+   }
+
+   QByteArray key(const QString &fileName, const QString &buffer) const;
+
+   // adds the cached entries as children of root, returns false if the cache has no valid entry for key
+   bool load(const QByteArray &key, QSharedPointer<Entry> root);
+
+   // stores the children of root, does nothing if the parse changed state which is not part of the tree
+   void store(const QByteArray &key, QSharedPointer<Entry> root, const Snapshot &before);
+
+   Snapshot snapshot() const;
+
+   // removes cache files which were not used by this run and were not written in the last week
+   void prune();
+
+   int hitCount() const {
+      return m_hits;
+   }
+
+   int missCount() const {
+      return m_misses;
+   }
+
+ private:
+   EntryCache();
+
+   QString cacheFileName(const QByteArray &key) const;
+
+   QString    m_dirName;
+   QByteArray m_configHash;
+
+   // keys loaded or stored by this run
+   QSet<QByteArray> m_usedKeys;
+
+   int m_hits;
+   int m_misses;
+};
+
+#endif
@@ -0,0 +1,253 @@
+/************************************************************************
+*
+* Copyright (c) 2014-2025 Barbara Geller & Ansel Sermersheim
+*
+* Copyright (c) 1997-2014 Dimitri van Heesch
+*
+* DoxyPress is free software. You can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* version 2 as published by the Free Software Foundation.
+*
+* DoxyPress is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+*
+* Documents produced by DoxyPress are derivative works derived from the
+* input used in their production; they are not affected by this license.
+*
+* https://www.gnu.org/licenses/
+*
+*************************************************************************/
+
+#include <QCryptographicHash>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QMutexLocker>
+#include <QProcess>
+#include <QSaveFile>
+#include <QStandardPaths>
+
+#include <filtercache.h>
+
+#include <message.h>
+
+// maximum size of the filter output kept in memory in KB
+static const int maxCacheCost = 64 * 1024;
+
+// maximum size of the filter-cache-dir in bytes
+static const qint64 maxDiskSize = 512 * 1024 * 1024;
+
+// splits a filter command into the program and its arguments, double quotes group words
+static QStringList splitCommand(const QString &command)
+{
+   QStringList retval;
+   QString word;
+
+   bool inQuotes = false;
+   bool hasWord  = false;
+
+   for (QChar c : command) {
+      if (c == '"') {
+         inQuotes = ! inQuotes;
+         hasWord  = true;
+
+      } else if (c.isSpace() && ! inQuotes) {
+         if (hasWord) {
+            retval.append(word);
+            word.clear();
+            hasWord = false;
+         }
+
+      } else {
+         word   += c;
+         hasWord = true;
+      }
+   }
+
+   if (hasWord) {
+      retval.append(word);
+   }
+
+   return retval;
+}
+
+static void addFileIdentity(QCryptographicHash &hash, const QFileInfo &fi)
+{
+   if (fi.isFile()) {
+      hash.addData(fi.absoluteFilePath().toUtf8());
+      hash.addData(QByteArray(1, '\0'));
+      hash.addData(QByteArray::number(fi.size()));
+      hash.addData(QByteArray(1, '\0'));
+      hash.addData(QByteArray::number(fi.lastModified().toMSecsSinceEpoch()));
+      hash.addData(QByteArray(1, '\0'));
+   }
+}
+
+FilterCache &FilterCache::instance()
+{
+   static FilterCache retval;
+   return retval;
+}
+
+FilterCache::FilterCache()
+   : m_cache(maxCacheCost), m_hits(0), m_misses(0)
+{
+}
+
+void FilterCache::setDirectory(const QString &dirName)
+{
+   m_dirName = dirName;
+}
+
+QString FilterCache::cacheFileName(const QByteArray &key) const
+{
+   return m_dirName + "/" + QString::fromLatin1(key) + ".filter";
+}
+
+bool FilterCache::filter(const QString &filterName, const QString &fileName, QByteArray &output)
+{
+   QFile f(fileName);
+
+   if (! f.open(QIODevice::ReadOnly)) {
+      err("Unable to open file %s for reading, OS Error #: %d\n", csPrintable(fileName), f.error());
+      return false;
+   }
+
+   QString program;
+   QStringList args;
+
+   if (QFileInfo(filterName).isFile()) {
+      // path of the filter may contain spaces
+      program = filterName;
+
+   } else {
+      args = splitCommand(filterName);
+
+      if (! args.isEmpty()) {
+         program = args.takeFirst();
+      }
+   }
+
+   QCryptographicHash hash(QCryptographicHash::Md5);
+   hash.addData(filterName.toUtf8());
+   hash.addData(QByteArray(1, '\0'));
+
+   // the filter program and arguments which are files, for example a script passed to an
+   // interpreter, are identified by their location, size, and modification time
+   QFileInfo programInfo(program);
+
+   if (! programInfo.isFile()) {
+      programInfo = QFileInfo(QStandardPaths::findExecutable(program));
+   }
+
+   addFileIdentity(hash, programInfo);
+
+   for (const auto &item : args) {
+      addFileIdentity(hash, QFileInfo(item));
+   }
+
+   hash.addData(QFileInfo(fileName).absoluteFilePath().toUtf8());
+   hash.addData(QByteArray(1, '\0'));
+   hash.addData(f.readAll());
+   f.close();
+
+   QByteArray key = hash.result().toHex();
+
+   {
+      QMutexLocker lock(&m_mutex);
+      QByteArray *item = m_cache.object(key);
+
+      if (item != nullptr) {
+         output = *item;
+         m_usedKeys.insert(key);
+         ++m_hits;
+
+         return true;
+      }
+   }
+
+   if (! m_dirName.isEmpty()) {
+      QFile cacheFile(cacheFileName(key));
+
+      if (cacheFile.open(QIODevice::ReadOnly)) {
+         output = cacheFile.readAll();
+         cacheFile.close();
+
+         QMutexLocker lock(&m_mutex);
+         m_cache.insert(key, new QByteArray(output), output.size() / 1024 + 1);
+         m_usedKeys.insert(key);
+         ++m_hits;
+
+         return true;
+      }
+   }
+
+   // filter the file, the lock is not held since the filter may take a while
+   args.append(fileName);
+
+   QProcess filterProcess;
+   filterProcess.start(program, args);
+   filterProcess.waitForFinished(-1);
+
+   if (filterProcess.exitStatus() != QProcess::NormalExit) {
+      err("Unable to execute command:  %s \"%s\"\n", csPrintable(filterName), csPrintable(fileName));
+      return false;
+   }
+
+   output = filterProcess.readAllStandardOutput();
+
+   QByteArray errorMsg = filterProcess.readAllStandardError();
+   if (! errorMsg.isEmpty()) {
+      err("Possible filter problem: %s\n", errorMsg.constData());
+   }
+
+   {
+      QMutexLocker lock(&m_mutex);
+      m_cache.insert(key, new QByteArray(output), output.size() / 1024 + 1);
+      m_usedKeys.insert(key);
+      ++m_misses;
+   }
+
+   if (! m_dirName.isEmpty()) {
+      // each writer uses its own temporary file, two threads may filter files with the same contents
+      QSaveFile cacheFile(cacheFileName(key));
+
+      if (! cacheFile.open(QIODevice::WriteOnly)) {
+         err("Unable to open file %s for writing, OS Error #: %d\n", csPrintable(cacheFile.fileName()), cacheFile.error());
+
+      } else {
+         cacheFile.write(output);
+         cacheFile.commit();
+      }
+   }
+
+   return true;
+}
+
+void FilterCache::prune()
+{
+   if (m_dirName.isEmpty()) {
+      return;
+   }
+
+   QMutexLocker lock(&m_mutex);
+
+   // oldest first
+   const QFileInfoList fileList = QDir(m_dirName).entryInfoList(QStringList() << "*.filter", QDir::Files, QDir::Time | QDir::Reversed);
+   qint64 totalSize = 0;
+
+   for (const auto &fi : fileList) {
+      totalSize += fi.size();
+   }
+
+   for (const auto &fi : fileList) {
+      if (totalSize <= maxDiskSize) {
+         break;
+      }
+
+      if (! m_usedKeys.contains(fi.baseName().toLatin1()) && QFile::remove(fi.absoluteFilePath())) {
+         totalSize -= fi.size();
+      }
+   }
+}
@@ -0,0 +1,76 @@
+/************************************************************************
+*
+* Copyright (c) 2014-2025 Barbara Geller & Ansel Sermersheim
+*
+* Copyright (c) 1997-2014 Dimitri van Heesch
+*
+* DoxyPress is free software. You can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* version 2 as published by the Free Software Foundation.
+*
+* DoxyPress is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+*
+* Documents produced by DoxyPress are derivative works derived from the
+* input used in their production; they are not affected by this license.
+*
+* https://www.gnu.org/licenses/
+*
+*************************************************************************/
+
+#ifndef FILTERCACHE_H
+#define FILTERCACHE_H
+
+#include <QByteArray>
+#include <QCache>
+#include <QMutex>
+#include <QSet>
+#include <QString>
+
+/** Cache of the output produced by input filters
+ *
+ *  The output is keyed by the filter command, the location, size, and modification time of the
+ *  filter program and of arguments which are files, the absolute path of the file, and the file
+ *  contents. A file is filtered again when the file or the filter changes. Results are kept in
+ *  memory and, when filter-cache-dir is set, stored on disk so later runs can reuse them. The
+ *  directory is limited in size, files not used by the current run are removed oldest first.
+ */
+class FilterCache
+{
+ public:
+   static FilterCache &instance();
+
+   void setDirectory(const QString &dirName);
+
+   // runs filterName on the given file, returns false if the file could not be read or the filter failed
+   bool filter(const QString &filterName, const QString &fileName, QByteArray &output);
+
+   // removes unused files from the cache directory until it is below the size limit
+   void prune();
+
+   int hitCount() const {
+      return m_hits;
+   }
+
+   int missCount() const {
+      return m_misses;
+   }
+
+ private:
+   FilterCache();
+
+   QString cacheFileName(const QByteArray &key) const;
+
+   QCache<QByteArray, QByteArray> m_cache;
+   QMutex  m_mutex;
+   QString m_dirName;
+
+   // keys read or written by this run
+   QSet<QByteArray> m_usedKeys;
+
+   int m_hits;
+   int m_misses;
+};
+
+#endif
@@ -32,14 +32,8 @@
 #define yypush_buffer_state preYYpush_buffer_state
 #define yypop_buffer_state preYYpop_buffer_state
 #define yyensure_buffer_stack preYYensure_buffer_stack
-#define yy_flex_debug preYY_flex_debug
-#define yyin preYYin
-#define yyleng preYYleng
 #define yylex preYYlex
-#define yylineno preYYlineno
-#define yyout preYYout
 #define yyrestart preYYrestart
-#define yytext preYYtext
 #define yywrap preYYwrap
 #define yyalloc preYYalloc
 #define yyrealloc preYYrealloc
@@ -227,6 +221,18 @@
 #define yyset_lineno preYYset_lineno
 #endif
 
+#ifdef yyget_column
+#define preYYget_column_ALREADY_DEFINED
+#else
+#define yyget_column preYYget_column
+#endif
+
+#ifdef yyset_column
+#define preYYset_column_ALREADY_DEFINED
+#else
+#define yyset_column preYYset_column
+#endif
+
 #ifdef yywrap
 #define preYYwrap_ALREADY_DEFINED
 #else
@@ -251,42 +257,6 @@
 #define yyfree preYYfree
 #endif
 
-#ifdef yytext
-#define preYYtext_ALREADY_DEFINED
-#else
-#define yytext preYYtext
-#endif
-
-#ifdef yyleng
-#define preYYleng_ALREADY_DEFINED
-#else
-#define yyleng preYYleng
-#endif
-
-#ifdef yyin
-#define preYYin_ALREADY_DEFINED
-#else
-#define yyin preYYin
-#endif
-
-#ifdef yyout
-#define preYYout_ALREADY_DEFINED
-#else
-#define yyout preYYout
-#endif
-
-#ifdef yy_flex_debug
-#define preYY_flex_debug_ALREADY_DEFINED
-#else
-#define yy_flex_debug preYY_flex_debug
-#endif
-
-#ifdef yylineno
-#define preYYlineno_ALREADY_DEFINED
-#else
-#define yylineno preYYlineno
-#endif
-
 /* First, we deal with  platform-specific or compiler-specific issues. */
 
 /* begin standard C headers. */
@@ -384,21 +354,38 @@ typedef unsigned int flex_uint32_t;
  */
 #define YY_SC_TO_UI(c) ((YY_CHAR) (c))
 
+/* An opaque pointer. */
+#ifndef YY_TYPEDEF_YY_SCANNER_T
+#define YY_TYPEDEF_YY_SCANNER_T
+typedef void* yyscan_t;
+#endif
+
+/* For convenience, these vars (plus the bison vars far below)
+   are macros in the reentrant scanner. */
+#define yyin yyg->yyin_r
+#define yyout yyg->yyout_r
+#define yyextra yyg->yyextra_r
+#define yyleng yyg->yyleng_r
+#define yytext yyg->yytext_r
+#define yylineno (YY_CURRENT_BUFFER_LVALUE->yy_bs_lineno)
+#define yycolumn (YY_CURRENT_BUFFER_LVALUE->yy_bs_column)
+#define yy_flex_debug yyg->yy_flex_debug_r
+
 /* Enter a start condition.  This macro really ought to take a parameter,
  * but we do it the disgusting crufty way forced on us by the ()-less
  * definition of BEGIN.
  */
-#define BEGIN (yy_start) = 1 + 2 *
+#define BEGIN yyg->yy_start = 1 + 2 *
 /* Translate the current start state into a value that can be later handed
  * to BEGIN to return to the state.  The YYSTATE alias is for lex
  * compatibility.
  */
-#define YY_START (((yy_start) - 1) / 2)
+#define YY_START ((yyg->yy_start - 1) / 2)
 #define YYSTATE YY_START
 /* Action number for EOF rule of a given start state. */
 #define YY_STATE_EOF(state) (YY_END_OF_BUFFER + state + 1)
 /* Special action meaning "start processing a new file". */
-#define YY_NEW_FILE yyrestart( yyin  )
+#define YY_NEW_FILE yyrestart( yyin , yyscanner )
 #define YY_END_OF_BUFFER_CHAR 0
 
 /* Size of default input buffer. */
@@ -428,10 +415,6 @@ typedef struct yy_buffer_state *YY_BUFFER_STATE;
 typedef size_t yy_size_t;
 #endif
 
-extern int yyleng;
-
-extern FILE *yyin, *yyout;
-
 #define EOB_ACT_CONTINUE_SCAN 0
 #define EOB_ACT_END_OF_FILE 1
 #define EOB_ACT_LAST_MATCH 2
@@ -446,13 +429,13 @@ extern FILE *yyin, *yyout;
 		/* Undo effects of setting up yytext. */ \
         int yyless_macro_arg = (n); \
         YY_LESS_LINENO(yyless_macro_arg);\
-		*yy_cp = (yy_hold_char); \
+		*yy_cp = yyg->yy_hold_char; \
 		YY_RESTORE_YY_MORE_OFFSET \
-		(yy_c_buf_p) = yy_cp = yy_bp + yyless_macro_arg - YY_MORE_ADJ; \
+		yyg->yy_c_buf_p = yy_cp = yy_bp + yyless_macro_arg - YY_MORE_ADJ; \
 		YY_DO_BEFORE_ACTION; /* set up yytext again */ \
 		} \
 	while ( 0 )
-#define unput(c) yyunput( c, (yytext_ptr)  )
+#define unput(c) yyunput( c, yyg->yytext_ptr , yyscanner )
 
 #ifndef YY_STRUCT_YY_BUFFER_STATE
 #define YY_STRUCT_YY_BUFFER_STATE
@@ -519,77 +502,57 @@ struct yy_buffer_state
 	};
 #endif /* !YY_STRUCT_YY_BUFFER_STATE */
 
-/* Stack of input buffers. */
-static size_t yy_buffer_stack_top = 0; /**< index of top of stack. */
-static size_t yy_buffer_stack_max = 0; /**< capacity of stack. */
-static YY_BUFFER_STATE * yy_buffer_stack = nullptr; /**< Stack as an array. */
-
 /* We provide macros for accessing buffer states in case in the
  * future we want to put the buffer states in a more general
  * "scanner state".
  *
  * Returns the top of the stack, or nullptr.
  */
-#define YY_CURRENT_BUFFER ( (yy_buffer_stack) \
-                          ? (yy_buffer_stack)[(yy_buffer_stack_top)] \
+#define YY_CURRENT_BUFFER ( yyg->yy_buffer_stack \
+                          ? yyg->yy_buffer_stack[yyg->yy_buffer_stack_top] \
                           : nullptr)
 /* Same as previous macro, but useful when we know that the buffer stack is not
  * nullptr or when we need an lvalue. For internal use only.
  */
-#define YY_CURRENT_BUFFER_LVALUE (yy_buffer_stack)[(yy_buffer_stack_top)]
-
-/* yy_hold_char holds the character lost when yytext is formed. */
-static char yy_hold_char;
-static int yy_n_chars;		/* number of characters read into yy_ch_buf */
-int yyleng;
+#define YY_CURRENT_BUFFER_LVALUE yyg->yy_buffer_stack[yyg->yy_buffer_stack_top]
 
-/* Points to current character in buffer. */
-static char *yy_c_buf_p = nullptr;
-static int yy_init = 0;		/* whether we need to initialize */
-static int yy_start = 0;	/* start state number */
+void yyrestart ( FILE *input_file , yyscan_t yyscanner );
+void yy_switch_to_buffer ( YY_BUFFER_STATE new_buffer , yyscan_t yyscanner );
+YY_BUFFER_STATE yy_create_buffer ( FILE *file, int size , yyscan_t yyscanner );
+void yy_delete_buffer ( YY_BUFFER_STATE b , yyscan_t yyscanner );
+void yy_flush_buffer ( YY_BUFFER_STATE b , yyscan_t yyscanner );
+void yypush_buffer_state ( YY_BUFFER_STATE new_buffer , yyscan_t yyscanner );
+void yypop_buffer_state ( yyscan_t yyscanner );
 
-/* Flag which is used to allow yywrap()'s to do buffer switches
- * instead of setting up a fresh yyin.  A bit of a hack ...
- */
-static int yy_did_buffer_switch_on_eof;
+static void yyensure_buffer_stack ( yyscan_t yyscanner );
+static void yy_load_buffer_state ( yyscan_t yyscanner );
+static void yy_init_buffer ( YY_BUFFER_STATE b, FILE *file , yyscan_t yyscanner );
+#define YY_FLUSH_BUFFER yy_flush_buffer( YY_CURRENT_BUFFER , yyscanner)
 
-void yyrestart ( FILE *input_file  );
-void yy_switch_to_buffer ( YY_BUFFER_STATE new_buffer  );
-YY_BUFFER_STATE yy_create_buffer ( FILE *file, int size  );
-void yy_delete_buffer ( YY_BUFFER_STATE b  );
-void yy_flush_buffer ( YY_BUFFER_STATE b  );
-void yypush_buffer_state ( YY_BUFFER_STATE new_buffer  );
-void yypop_buffer_state ( void );
+YY_BUFFER_STATE yy_scan_buffer ( char *base, yy_size_t size , yyscan_t yyscanner );
+YY_BUFFER_STATE yy_scan_string ( const char *yy_str , yyscan_t yyscanner );
+YY_BUFFER_STATE yy_scan_bytes ( const char *bytes, int len , yyscan_t yyscanner );
 
-static void yyensure_buffer_stack ( void );
-static void yy_load_buffer_state ( void );
-static void yy_init_buffer ( YY_BUFFER_STATE b, FILE *file  );
-#define YY_FLUSH_BUFFER yy_flush_buffer( YY_CURRENT_BUFFER )
-
-YY_BUFFER_STATE yy_scan_buffer ( char *base, yy_size_t size  );
-YY_BUFFER_STATE yy_scan_string ( const char *yy_str  );
-YY_BUFFER_STATE yy_scan_bytes ( const char *bytes, int len  );
-
-void *yyalloc ( yy_size_t  );
-void *yyrealloc ( void *, yy_size_t  );
-void yyfree ( void *  );
+void *yyalloc ( yy_size_t , yyscan_t yyscanner );
+void *yyrealloc ( void *, yy_size_t , yyscan_t yyscanner );
+void yyfree ( void * , yyscan_t yyscanner );
 
 #define yy_new_buffer yy_create_buffer
 #define yy_set_interactive(is_interactive) \
 	{ \
 	if ( ! YY_CURRENT_BUFFER ){ \
-        yyensure_buffer_stack (); \
+        yyensure_buffer_stack (yyscanner); \
 		YY_CURRENT_BUFFER_LVALUE =    \
-            yy_create_buffer( yyin, YY_BUF_SIZE ); \
+            yy_create_buffer( yyin, YY_BUF_SIZE , yyscanner); \
 	} \
 	YY_CURRENT_BUFFER_LVALUE->yy_is_interactive = is_interactive; \
 	}
 #define yy_set_bol(at_bol) \
 	{ \
 	if ( ! YY_CURRENT_BUFFER ){\
-        yyensure_buffer_stack (); \
+        yyensure_buffer_stack (yyscanner); \
 		YY_CURRENT_BUFFER_LVALUE =    \
-            yy_create_buffer( yyin, YY_BUF_SIZE ); \
+            yy_create_buffer( yyin, YY_BUF_SIZE , yyscanner); \
 	} \
 	YY_CURRENT_BUFFER_LVALUE->yy_at_bol = at_bol; \
 	}
@@ -597,37 +560,28 @@ void yyfree ( void *  );
 
 /* Begin user sect3 */
 
-#define preYYwrap() (/*CONSTCOND*/1)
+#define preYYwrap(yyscanner) (/*CONSTCOND*/1)
 #define YY_SKIP_YYWRAP
 typedef flex_uint8_t YY_CHAR;
 
-FILE *yyin = nullptr, *yyout = nullptr;
-
 typedef int yy_state_type;
 
-extern int yylineno;
-int yylineno = 1;
+#define yytext_ptr yytext_r
 
-extern char *yytext;
-#ifdef yytext_ptr
-#undef yytext_ptr
-#endif
-#define yytext_ptr yytext
-
-static yy_state_type yy_get_previous_state ( void );
-static yy_state_type yy_try_NUL_trans ( yy_state_type current_state  );
-static int yy_get_next_buffer ( void );
-static void yynoreturn yy_fatal_error ( const char* msg  );
+static yy_state_type yy_get_previous_state ( yyscan_t yyscanner );
+static yy_state_type yy_try_NUL_trans ( yy_state_type current_state  , yyscan_t yyscanner);
+static int yy_get_next_buffer ( yyscan_t yyscanner );
+static void yynoreturn yy_fatal_error ( const char* msg , yyscan_t yyscanner );
 
 /* Done after the current pattern has been matched and before the
  * corresponding action - sets up yytext.
  */
 #define YY_DO_BEFORE_ACTION \
-	(yytext_ptr) = yy_bp; \
+	yyg->yytext_ptr = yy_bp; \
 	yyleng = (int) (yy_cp - yy_bp); \
-	(yy_hold_char) = *yy_cp; \
+	yyg->yy_hold_char = *yy_cp; \
 	*yy_cp = '\0'; \
-	(yy_c_buf_p) = yy_cp;
+	yyg->yy_c_buf_p = yy_cp;
 #define YY_NUM_RULES 217
 #define YY_END_OF_BUFFER 218
 /* This struct is not used in this scanner,
@@ -3316,32 +3270,22 @@ static const flex_int16_t yy_chk[8557] =
      1443, 1443, 1443, 1443, 1443, 1443
     } ;
 
-extern int yy_flex_debug;
-int yy_flex_debug = 0;
-
-static yy_state_type *yy_state_buf=0, *yy_state_ptr=0;
-static char *yy_full_match;
-static int yy_lp;
-static int yy_looking_for_trail_begin = 0;
-static int yy_full_lp;
-static int *yy_full_state;
 #define YY_TRAILING_MASK 0x2000
 #define YY_TRAILING_HEAD_MASK 0x4000
 #define REJECT \
 { \
-*yy_cp = (yy_hold_char); /* undo effects of setting up yytext */ \
-yy_cp = (yy_full_match); /* restore poss. backed-over text */ \
-(yy_lp) = (yy_full_lp); /* restore orig. accepting pos. */ \
-(yy_state_ptr) = (yy_full_state); /* restore orig. state */ \
-yy_current_state = *(yy_state_ptr); /* restore curr. state */ \
-++(yy_lp); \
+*yy_cp = yyg->yy_hold_char; /* undo effects of setting up yytext */ \
+yy_cp = yyg->yy_full_match; /* restore poss. backed-over text */ \
+yyg->yy_lp = yyg->yy_full_lp; /* restore orig. accepting pos. */ \
+yyg->yy_state_ptr = yyg->yy_full_state; /* restore orig. state */ \
+yy_current_state = *yyg->yy_state_ptr; /* restore curr. state */ \
+++yyg->yy_lp; \
 goto find_rule; \
 }
 
 #define yymore() yymore_used_but_not_detected
 #define YY_MORE_ADJ 0
 #define YY_RESTORE_YY_MORE_OFFSET
-char *yytext;
 /*************************************************************************
  *
  * Copyright (c) 2014-2024 Barbara Geller & Ansel Sermersheim
@@ -3367,6 +3311,7 @@ char *yytext;
 #include <QFile>
 #include <QFileInfo>
 #include <QHash>
+#include <QMutex>
 #include <QRegularExpression>
 #include <QStack>
 #include <QStringList>
@@ -3444,11 +3389,22 @@ class DefineManager
          m_includedFiles.insert(fileName);
       }
 
-      void collectDefines(DefineDict &dict, QSet<QString> &includeStack);
+      void collectDefines(DefineDict &dict, QSet<QString> &includeStack, bool &complete);
+
+      /** Returns true if the file was scanned up to its end
+       */
+      bool isComplete() const {
+         return m_complete;
+      }
+
+      void setComplete(bool complete) {
+         m_complete = complete;
+      }
 
     private:
       DefineDict m_defines;
       QSet<QString> m_includedFiles;
+      bool m_complete = false;
    };
 
  public:
@@ -3472,11 +3428,12 @@ class DefineManager
     *  @param fileName the name of the file to process.
     */
    void startContext(const QString &fileName) {
-      m_contextDefines.clear();
       if (fileName.isEmpty()) {
          return;
       }
 
+      QMutexLocker lock(&m_mutex);
+
       QSharedPointer<DefinesPerFile> dpf = m_fileMap.value(fileName);
 
       if (dpf == nullptr) {
@@ -3486,22 +3443,18 @@ class DefineManager
       }
    }
 
-   /** Ends the context started with startContext() freeing any
-    *  defines collected within in this context.
-    */
-   void endContext() {
-      m_contextDefines.clear();
-   }
-
    /** Add an included file to the current context.
     *  If the file has been pre-processed already, all defines are added to the context.
+    *  @param contextDefines The defines of the current context.
     *  @param fileName The name of the include file to add to the context.
     */
-   void addFileToContext(const QString &fileName) {
+   void addFileToContext(DefineDict &contextDefines, const QString &fileName) {
       if (fileName.isEmpty()) {
          return;
       }
 
+      QMutexLocker lock(&m_mutex);
+
       QSharedPointer<DefinesPerFile> dpf = m_fileMap.value(fileName);
 
       if (dpf == nullptr) {
@@ -3511,36 +3464,72 @@ class DefineManager
 
       } else {
          // existing file
+         QSharedPointer<DefineDict> collected = m_collectedDefines.value(fileName);
 
-         QSet<QString> includeStack;
-         dpf->collectDefines(m_contextDefines, includeStack);
+         if (collected == nullptr) {
+            QSet<QString> includeStack;
+            bool complete = dpf->isComplete();
+
+            collected = QMakeShared<DefineDict>();
+            dpf->collectDefines(*collected, includeStack, complete);
+
+            if (complete) {
+               // file and all of its includes are done, the result will not change
+               m_collectedDefines.insert(fileName, collected);
+            }
+         }
+
+         for (const auto &def : *collected) {
+            contextDefines.insert(def->m_name, def);
+         }
+      }
+   }
+
+   /** Called when the scanner reaches the end of a file.
+    *  Once a file and all files it includes are complete, the defines collected for
+    *  the file are cached and reused each time the file is included again.
+    *  @param fileName The name of the file which was scanned.
+    */
+   void fileFinished(const QString &fileName) {
+      QMutexLocker lock(&m_mutex);
+
+      QSharedPointer<DefinesPerFile> dpf = m_fileMap.value(fileName);
+
+      if (dpf != nullptr) {
+         dpf->setComplete(true);
       }
    }
 
    /** Add a define to the manager object.
+    *  @param contextDefines The defines of the current context.
     *  @param fileName The file in which the define was found
     *  @param def The Define object to add.
     */
-   void addDefine(const QString &fileName, QSharedPointer<A_Define> def) {
+   void addDefine(DefineDict &contextDefines, const QString &fileName, QSharedPointer<A_Define> def) {
       if (fileName.isEmpty()) {
          return;
       }
 
-      QSharedPointer<A_Define> d = m_contextDefines.value(def->m_name);
+      QSharedPointer<A_Define> d = contextDefines.value(def->m_name);
 
       if (d != nullptr) {
          // redefine
-         m_contextDefines.remove(d->m_name);
+         contextDefines.remove(d->m_name);
       }
 
-      m_contextDefines.insert(def->m_name, def);
+      contextDefines.insert(def->m_name, def);
 
-      //
+      QMutexLocker lock(&m_mutex);
       QSharedPointer<DefinesPerFile> dpf = m_fileMap.value(fileName);
 
       if (dpf == nullptr) {
          dpf = QMakeShared<DefinesPerFile>();
          m_fileMap.insert(fileName, dpf);
+
+      } else if (dpf->isComplete()) {
+         // file is scanned again, for example an #include inside { ... }
+         dpf->setComplete(false);
+         m_collectedDefines.clear();
       }
 
       dpf->addDefine(std::move(def));
@@ -3555,11 +3544,17 @@ class DefineManager
          return;
       }
 
+      QMutexLocker lock(&m_mutex);
+
       QSharedPointer<DefinesPerFile> dpf = m_fileMap.value(fromFileName);
 
       if (dpf == nullptr) {
          dpf = QMakeShared<DefinesPerFile>();
          m_fileMap.insert(fromFileName, dpf);
+
+      } else if (dpf->isComplete()) {
+         dpf->setComplete(false);
+         m_collectedDefines.clear();
       }
 
       dpf->addInclude(toFileName);
@@ -3567,8 +3562,8 @@ class DefineManager
 
    /** Returns a Define object given its name or 0 if the Define does not exist.
    */
-   QSharedPointer<A_Define> isDefined(const QString &name) const {
-      QSharedPointer<A_Define> d = m_contextDefines.value(name);
+   QSharedPointer<A_Define> isDefined(const DefineDict &contextDefines, const QString &name) const {
+      QSharedPointer<A_Define> d = contextDefines.value(name);
 
       if (d && d->undef) {
          d = QSharedPointer<A_Define>();
@@ -3577,11 +3572,6 @@ class DefineManager
       return d;
    }
 
-   /** Returns a reference to the defines found in the current context. */
-   const DefineDict &defineContext() const {
-      return m_contextDefines;
-   }
-
  private:
    static DefineManager *theInstance;
 
@@ -3614,8 +3604,13 @@ class DefineManager
    virtual ~DefineManager() {
    }
 
+   // the context defines are owned by the caller, the per file map is shared by all threads
+   QMutex m_mutex;
+
    QHash<QString, QSharedPointer<DefinesPerFile>> m_fileMap;
-   DefineDict m_contextDefines;
+
+   // flattened defines of a file and everything it includes, only for complete files
+   QHash<QString, QSharedPointer<DefineDict>> m_collectedDefines;
 };
 
 DefineManager *DefineManager::theInstance = nullptr;
@@ -3626,8 +3621,10 @@ DefineManager *DefineManager::theInstance = nullptr;
  *         replace a previous definition.
  *  @param includeStack The stack of includes, used to stop recursion in
  *         case there is a cyclic include dependency.
+ *  @param complete Set to false if any of the visited files has not been
+ *         scanned up to its end.
  */
-void DefineManager::DefinesPerFile::collectDefines(DefineDict &dict, QSet<QString> &includeStack)
+void DefineManager::DefinesPerFile::collectDefines(DefineDict &dict, QSet<QString> &includeStack, bool &complete)
 {
    {
       for (const auto &incFile : m_includedFiles) {
@@ -3635,7 +3632,12 @@ void DefineManager::DefinesPerFile::collectDefines(DefineDict &dict, QSet<QStrin
 
          if (dpf != nullptr && ! includeStack.contains(incFile)) {
             includeStack.insert(incFile);
-            dpf->collectDefines(dict, includeStack);
+
+            if (! dpf->isComplete()) {
+               complete = false;
+            }
+
+            dpf->collectDefines(dict, includeStack, complete);
          }
       }
    }
@@ -3655,70 +3657,93 @@ void DefineManager::DefinesPerFile::collectDefines(DefineDict &dict, QSet<QStrin
 }
 
 static QStringList              s_pathList;
-static QString                  s_yyFileName;
-static QSharedPointer<FileDef>  s_yyFileDef;
-static QSharedPointer<FileDef>  s_inputFileDef;
-
-static QSharedPointer<QHash<QString, int>> s_argDict;
-static QStack<QSharedPointer<FileState>>   s_includeStack;
-static QStack<QSharedPointer<CondCtx>>     s_condStack;
-static QSharedPointer<DefineDict>          s_expandedDict;
-
-static int          s_yyLineNr   = 1;
-static int          s_yyMLines   = 1;
-static int          s_yyColNr    = 1;
-static int          s_ifcount    = 0;
-static int          s_defArgs    = -1;
-
-static QString      s_defName;
-static QString      s_defText;
-static QString      s_defLitText;
-static QString      s_defArgsStr;
-static QString      s_defExtraSpacing;
-static bool         s_defVarArgs;
-
-static int          s_lastCContext;
-static int          s_lastCPPContext;
-static QStack<int>  s_levelGuard;
-
-static QString      s_outputString;
-static QString      s_inputString;
-static int          s_inputPosition;
-
-static int          s_roundCount;
-static bool         s_quoteArg;
-static bool         s_idStart;
-
-static int          s_findDefArgContext;
-static bool         s_expectGuard;
-static QString      s_guardName;
-static QString      s_lastGuardName;
-static QString      s_incName;
-static QString      s_guardExpr;
-static int          s_curlyCount;
-static bool         s_nospaces;          // add extra spaces during macro expansion
-
-static bool         s_macroExpansion;    // from the configuration
-static bool         s_expandOnlyPredef;  // from the configuration
-static int          s_commentCount;
-static bool         s_insideComment;
-static bool         s_isImported;
-static QString      s_blockName;
-static int          s_condCtx;
-static bool         s_skip;
-
-static bool         s_insideCS;          // C# has simpler preprocessor
-static bool         s_insideFortran;
-static bool         s_isSource;
-
-static bool         s_lexInit   = false;
-static int          s_fenceSize = 0;
-static bool         s_ccomment;
-
-QString             s_delimiter;
-
-static QSet<QString> s_allIncludes;
-static QSet<QString> s_expansionDict;
+
+/** @brief State of a single run of the preprocessor
+ *
+ *  Every call to preprocessFile() owns one of these objects along with its own reentrant scanner,
+ *  the context is the scanner's yyextra. The active context of the calling thread is s_ctx, so
+ *  several threads can each preprocess a file at the same time.
+ */
+struct PreprocessorContext {
+   yyscan_t                 yyscanner = nullptr;
+
+   QString                  yyFileName;
+   QSharedPointer<FileDef>  yyFileDef;
+   QSharedPointer<FileDef>  inputFileDef;
+
+   QSharedPointer<QHash<QString, int>> argDict;
+   QStack<QSharedPointer<FileState>>   includeStack;
+   QStack<QSharedPointer<CondCtx>>     condStack;
+   QSharedPointer<DefineDict>          expandedDict = QMakeShared<DefineDict>();
+
+   DefineDict   contextDefines;      // defines visible in the file being processed
+
+   int          yyLineNr   = 1;
+   int          yyMLines   = 1;
+   int          yyColNr    = 1;
+   int          ifcount    = 0;
+   int          defArgs    = -1;
+
+   QString      defName;
+   QString      defText;
+   QString      defLitText;
+   QString      defArgsStr;
+   QString      defExtraSpacing;
+   bool         defVarArgs = false;
+
+   int          lastCContext   = 0;
+   int          lastCPPContext = 0;
+   QStack<int>  levelGuard;
+
+   QString      outputString;
+   QString      inputString;
+   int          inputPosition = 0;
+
+   int          roundCount = 0;
+   bool         quoteArg   = false;
+   bool         idStart    = false;
+
+   int          findDefArgContext = 0;
+   bool         expectGuard       = false;
+   QString      guardName;
+   QString      lastGuardName;
+   QString      incName;
+   QString      guardExpr;
+   int          curlyCount = 0;
+   bool         nospaces   = false;        // add extra spaces during macro expansion
+
+   bool         macroExpansion   = false;  // from the configuration
+   bool         expandOnlyPredef = false;  // from the configuration
+   int          commentCount     = 0;
+   bool         insideComment    = false;
+   bool         isImported       = false;
+   QString      blockName;
+   int          condCtx = 0;
+   bool         skip    = false;
+
+   bool         insideCS      = false;     // C# has simpler preprocessor
+   bool         insideFortran = false;
+   bool         isSource      = false;
+
+   int          fenceSize = 0;
+   bool         ccomment  = false;
+
+   QString      delimiter;
+
+   QSet<QString> expansionDict;
+};
+
+static thread_local PreprocessorContext *s_ctx = nullptr;
+
+// shared by all threads, s_pathList is only written before preprocessing starts
+static QMutex        s_includeMutex;      // protects s_allIncludes and s_includeNameCache
+static QSet<QString> s_allIncludes;       // include guard shared by all files
+
+static QHash<QString, QString> s_includeNameCache;   // directory + include name, maps to the absolute name
+
+// serializes calls into the non-reentrant constexp and argument list scanners and
+// updates of the global symbol tables and file dependencies
+static QMutex        s_globalMutex;
 
 #define MAX_EXPANSION_DEPTH 50
 
@@ -3727,55 +3752,55 @@ static void setFileName(const QString &name)
    bool ambig;
    QFileInfo fi(name);
 
-   s_yyFileName = fi.absoluteFilePath();
-   s_yyFileDef  = findFileDef(&Doxy_Globals::inputNameDict, s_yyFileName, ambig);
+   s_ctx->yyFileName = fi.absoluteFilePath();
+   s_ctx->yyFileDef  = findFileDef(&Doxy_Globals::inputNameDict, s_ctx->yyFileName, ambig);
 
-   if (s_yyFileDef == nullptr) {
+   if (s_ctx->yyFileDef == nullptr) {
       // if this is not an input file check if it is an include file
-      s_yyFileDef = findFileDef(&Doxy_Globals::includeNameDict, s_yyFileName, ambig);
+      s_ctx->yyFileDef = findFileDef(&Doxy_Globals::includeNameDict, s_ctx->yyFileName, ambig);
    }
 
-   if (s_yyFileDef && s_yyFileDef->isReference()) {
-      s_yyFileDef = QSharedPointer<FileDef>();
+   if (s_ctx->yyFileDef && s_ctx->yyFileDef->isReference()) {
+      s_ctx->yyFileDef = QSharedPointer<FileDef>();
    }
 
-   s_insideCS      = getLanguageFromFileName(s_yyFileName) == SrcLangExt_CSharp;
-   s_insideFortran = getLanguageFromFileName(s_yyFileName) == SrcLangExt_Fortran;
+   s_ctx->insideCS      = getLanguageFromFileName(s_ctx->yyFileName) == SrcLangExt_CSharp;
+   s_ctx->insideFortran = getLanguageFromFileName(s_ctx->yyFileName) == SrcLangExt_Fortran;
 
-   s_isSource = determineSection(s_yyFileName);
+   s_ctx->isSource = determineSection(s_ctx->yyFileName);
 }
 
 static void incrLevel()
 {
-   s_levelGuard.push(0);
+   s_ctx->levelGuard.push(0);
 }
 
 static void decrLevel()
 {
-   if (s_levelGuard.size() > 0) {
-      s_levelGuard.pop();
+   if (s_ctx->levelGuard.size() > 0) {
+      s_ctx->levelGuard.pop();
 
    } else {
-      warn(s_yyFileName, s_yyLineNr, "More #endif's than #if's found\n");
+      warn(s_ctx->yyFileName, s_ctx->yyLineNr, "More #endif's than #if's found\n");
 
    }
 }
 
 static bool otherCaseDone()
 {
-   if (s_levelGuard.size() == 0) {
-      warn(s_yyFileName, s_yyLineNr, "Found an #else without a preceding #if\n");
+   if (s_ctx->levelGuard.size() == 0) {
+      warn(s_ctx->yyFileName, s_ctx->yyLineNr, "Found an #else without a preceding #if\n");
       return true;
 
    } else {
-      return s_levelGuard.top();
+      return s_ctx->levelGuard.top();
 
    }
 }
 
 static void setCaseDone(bool value)
 {
-   s_levelGuard.top() = value;
+   s_ctx->levelGuard.top() = value;
 }
 
 static QSharedPointer<FileState> checkAndOpenFile(const QString &fileName, bool &alreadyIncluded)
@@ -3795,9 +3820,11 @@ static QSharedPointer<FileState> checkAndOpenFile(const QString &fileName, bool
       QString absName = fi.absoluteFilePath();
 
       // global guard
-      if (s_curlyCount == 0) {
+      if (s_ctx->curlyCount == 0) {
          // not #include inside { ... }
 
+         QMutexLocker lock(&s_includeMutex);
+
          if (s_allIncludes.contains(absName)) {
             alreadyIncluded = true;
             return QSharedPointer<FileState>();
@@ -3809,8 +3836,8 @@ static QSharedPointer<FileState> checkAndOpenFile(const QString &fileName, bool
       // check include stack for absName
       QStack<QSharedPointer<FileState>> tmpStack;
 
-      while (! s_includeStack.isEmpty()) {
-         fs = s_includeStack.pop();
+      while (! s_ctx->includeStack.isEmpty()) {
+         fs = s_ctx->includeStack.pop();
 
          if (fs->fileName == absName) {
             alreadyIncluded = true;
@@ -3822,7 +3849,7 @@ static QSharedPointer<FileState> checkAndOpenFile(const QString &fileName, bool
       while (! tmpStack.isEmpty()) {
          fs = tmpStack.pop();
 
-         s_includeStack.push(fs);
+         s_ctx->includeStack.push(fs);
       }
 
       if (alreadyIncluded) {
@@ -3837,8 +3864,8 @@ static QSharedPointer<FileState> checkAndOpenFile(const QString &fileName, bool
          fs = QSharedPointer<FileState>();
 
       } else {
-         fs->oldFileBuf    = s_inputString;
-         fs->oldFileBufPos = s_inputPosition;
+         fs->oldFileBuf    = s_ctx->inputString;
+         fs->oldFileBufPos = s_ctx->inputPosition;
       }
    }
 
@@ -3852,7 +3879,7 @@ static QSharedPointer<FileState> findFile(const QString &fileName, bool localInc
 
       if (fs) {
          setFileName(fileName);
-         s_yyLineNr = 1;
+         s_ctx->yyLineNr = 1;
          return fs;
 
       } else if (alreadyIncluded) {
@@ -3860,8 +3887,8 @@ static QSharedPointer<FileState> findFile(const QString &fileName, bool localInc
       }
    }
 
-   if (localInclude && ! s_yyFileName.isEmpty()) {
-      QFileInfo fi(s_yyFileName);
+   if (localInclude && ! s_ctx->yyFileName.isEmpty()) {
+      QFileInfo fi(s_ctx->yyFileName);
 
       if (fi.exists()) {
          QString absName = fi.absolutePath() + "/" + fileName;
@@ -3869,7 +3896,7 @@ static QSharedPointer<FileState> findFile(const QString &fileName, bool localInc
 
          if (fs) {
             setFileName(absName);
-            s_yyLineNr = 1;
+            s_ctx->yyLineNr = 1;
             return fs;
 
          } else if (alreadyIncluded) {
@@ -3889,7 +3916,7 @@ static QSharedPointer<FileState> findFile(const QString &fileName, bool localInc
 
       if (fs) {
          setFileName(absName);
-         s_yyLineNr = 1;
+         s_ctx->yyLineNr = 1;
          return fs;
 
       } else if (alreadyIncluded) {
@@ -4071,11 +4098,9 @@ static void processConcatOperators(QString &str)
    }
 }
 
-static void yyunput (int c,char *buf_ptr);
-static void returnCharToStream(char c)
-{
-  unput(c);
-}
+static void returnCharToStream(char c);
+static YY_BUFFER_STATE getCurrentBuffer();
+static void startNewBuffer();
 
 static inline void addTillEndOfString(const QString &expr, QString *rest, uint &pos, char term, QString &arg)
 {
@@ -4362,7 +4387,7 @@ static bool replaceFunctionMacro(const QString &expr, QString *rest, int pos, in
                         // empty argument will be remove later on
                         resExpr += "@E";
 
-                     } else if (s_nospaces) {
+                     } else if (s_ctx->nospaces) {
                         resExpr += substArg;
 
                      } else {
@@ -4477,12 +4502,12 @@ static bool expandExpression(QString &expr, QString *rest, int pos, int level)
      return true;
    }
 
-   if (s_expansionDict.contains(expr) && level > MAX_EXPANSION_DEPTH) {
+   if (s_ctx->expansionDict.contains(expr) && level > MAX_EXPANSION_DEPTH) {
       // check for too deep recursive expansions
       return false;
 
    } else {
-      s_expansionDict.insert(expr);
+      s_ctx->expansionDict.insert(expr);
    }
 
    QString macroName;
@@ -4506,10 +4531,10 @@ static bool expandExpression(QString &expr, QString *rest, int pos, int level)
       if (p < 2 || ! (expr.at(p - 2) == '@' && expr.at(p - 1) == '-')) {
          // no-rescan marker?
 
-         if (! s_expandedDict->contains(macroName)) {
+         if (! s_ctx->expandedDict->contains(macroName)) {
 
             // expand macro
-            QSharedPointer<A_Define> def = DefineManager::instance().isDefined(macroName);
+            QSharedPointer<A_Define> def = DefineManager::instance().isDefined(s_ctx->contextDefines, macroName);
 
             if (macroName == "defined") {
                definedTest = true;
@@ -4531,7 +4556,7 @@ static bool expandExpression(QString &expr, QString *rest, int pos, int level)
                // simple macro
                // substitute the definition of the macro
 
-               if (s_nospaces) {
+               if (s_ctx->nospaces) {
                   expMacro = def->m_definition.trimmed();
                } else {
                   expMacro = " " + def->m_definition.trimmed() + " ";
@@ -4557,9 +4582,9 @@ static bool expandExpression(QString &expr, QString *rest, int pos, int level)
                bool isExpanded = false;
 
                if (def && ! def->nonRecursive) {
-                  s_expandedDict->insert(macroName, def);
+                  s_ctx->expandedDict->insert(macroName, def);
                   isExpanded = expandExpression(resultExpr, &restExpr, 0, level + 1);
-                  s_expandedDict->remove(macroName);
+                  s_ctx->expandedDict->remove(macroName);
                } else if (def && def->nonRecursive) {
                   isExpanded = true;
 
@@ -4939,7 +4964,7 @@ bool computeExpression(const QString &expr)
 {
    QString e = expr;
 
-   s_expansionDict.clear();
+   s_ctx->expansionDict.clear();
    expandExpression(e, nullptr, 0, 0);
 
    e = removeIdsAndMarkers(e);
@@ -4948,7 +4973,8 @@ bool computeExpression(const QString &expr)
       return false;
    }
 
-   bool retval = parseconstexp(s_yyFileName, s_yyLineNr, e);
+   QMutexLocker lock(&s_globalMutex);
+   bool retval = parseconstexp(s_ctx->yyFileName, s_ctx->yyLineNr, e);
 
    return retval;
 }
@@ -4961,7 +4987,7 @@ QString expandMacro(const QString &name)
 {
    QString n = name;
 
-   s_expansionDict.clear();
+   s_ctx->expansionDict.clear();
    expandExpression(n, nullptr, 0, 0);
 
    n = removeMarkers(n);
@@ -4973,14 +4999,14 @@ QSharedPointer<A_Define> newDefine()
 {
    QSharedPointer<A_Define> def = QMakeShared<A_Define>();
 
-   def->m_name       = s_defName;
-   def->m_definition = s_defText.trimmed();
-   def->nargs        = s_defArgs;
-   def->m_fileName   = s_yyFileName;
-   def->fileDef      = s_yyFileDef;
-   def->lineNr       = s_yyLineNr - s_yyMLines;
-   def->columnNr     = s_yyColNr;
-   def->varArgs      = s_defVarArgs;
+   def->m_name       = s_ctx->defName;
+   def->m_definition = s_ctx->defText.trimmed();
+   def->nargs        = s_ctx->defArgs;
+   def->m_fileName   = s_ctx->yyFileName;
+   def->fileDef      = s_ctx->yyFileDef;
+   def->lineNr       = s_ctx->yyLineNr - s_ctx->yyMLines;
+   def->columnNr     = s_ctx->yyColNr;
+   def->varArgs      = s_ctx->defVarArgs;
 
    if (! def->m_name.isEmpty() && Doxy_Globals::expandAsDefinedDict.contains(def->m_name)) {
       def->isPredefined = true;
@@ -4991,39 +5017,41 @@ QSharedPointer<A_Define> newDefine()
 
 static void addDefine()
 {
-   if (s_skip) {
+   if (s_ctx->skip) {
       // do not add this define as it is inside a
       // conditional section (cond command) that is disabled
 
       return;
    }
 
-   QSharedPointer<MemberDef> md = QMakeShared<MemberDef>(s_yyFileName, s_yyLineNr - s_yyMLines, s_yyColNr,
-               "#define", s_defName, s_defArgsStr, "", Protection::Public, Specifier::Normal, false,
+   QMutexLocker lock(&s_globalMutex);
+
+   QSharedPointer<MemberDef> md = QMakeShared<MemberDef>(s_ctx->yyFileName, s_ctx->yyLineNr - s_ctx->yyMLines, s_ctx->yyColNr,
+               "#define", s_ctx->defName, s_ctx->defArgsStr, "", Protection::Public, Specifier::Normal, false,
                Relationship::Member, MemberDefType::Define, ArgumentList(), ArgumentList());
 
-   if (! s_defArgsStr.isEmpty()) {
+   if (! s_ctx->defArgsStr.isEmpty()) {
       ArgumentList argList;
 
       QString dummy;
-      argList = stringToArgumentList(SrcLangExt_Cpp, dummy, s_defArgsStr);
+      argList = stringToArgumentList(SrcLangExt_Cpp, dummy, s_ctx->defArgsStr);
 
       md->setArgumentList(argList);
    }
 
-   int len = s_defLitText.indexOf('\n');
+   int len = s_ctx->defLitText.indexOf('\n');
 
-   if (len > 0 && s_defLitText.left(len).trimmed() == "\\") {
+   if (len > 0 && s_ctx->defLitText.left(len).trimmed() == "\\") {
       // strip first line if it only contains a slash
-      s_defLitText = s_defLitText.right(s_defLitText.length() - len - 1);
+      s_ctx->defLitText = s_ctx->defLitText.right(s_ctx->defLitText.length() - len - 1);
 
    } else if (len > 0) {
       // align the items on the first line with the items on the second line
       int k = len + 1;
 
-      QString::const_iterator iter = s_defLitText.constBegin() + k;
+      QString::const_iterator iter = s_ctx->defLitText.constBegin() + k;
 
-      while (iter !=  s_defLitText.constEnd())  {
+      while (iter !=  s_ctx->defLitText.constEnd())  {
          QChar c = *iter;
          ++iter;
 
@@ -5036,38 +5064,38 @@ static void addDefine()
          }
       }
 
-      s_defLitText = s_defLitText.mid(len + 1, k - len - 1) + s_defLitText.trimmed();
+      s_ctx->defLitText = s_ctx->defLitText.mid(len + 1, k - len - 1) + s_ctx->defLitText.trimmed();
    }
 
-   md->setInitializer(s_defLitText.trimmed());
-   md->setFileDef(s_inputFileDef);
-   md->setDefinition("#define " + s_defName);
+   md->setInitializer(s_ctx->defLitText.trimmed());
+   md->setFileDef(s_ctx->inputFileDef);
+   md->setDefinition("#define " + s_ctx->defName);
 
-   QSharedPointer<MemberName> mn = Doxy_Globals::functionNameSDict.find(s_defName);
+   QSharedPointer<MemberName> mn = Doxy_Globals::functionNameSDict.find(s_ctx->defName);
 
    if (! mn) {
-      mn = QMakeShared<MemberName>(s_defName);
-      Doxy_Globals::functionNameSDict.insert(s_defName, mn);
+      mn = QMakeShared<MemberName>(s_ctx->defName);
+      Doxy_Globals::functionNameSDict.insert(s_ctx->defName, mn);
    }
 
    mn->append(md);
 
-   if (s_yyFileDef) {
-      s_yyFileDef->insertMember(md);
+   if (s_ctx->yyFileDef) {
+      s_ctx->yyFileDef->insertMember(md);
    }
 }
 
 static inline void outputChar(QChar c)
 {
-   if (s_includeStack.isEmpty() || s_curlyCount > 0) {
-      s_outputString += c;
+   if (s_ctx->includeStack.isEmpty() || s_ctx->curlyCount > 0) {
+      s_ctx->outputString += c;
    }
 }
 
 static inline void outputArray(const QString &a, int len)
 {
-   if (s_includeStack.isEmpty() || s_curlyCount > 0) {
-      s_outputString += a.mid(0, len);
+   if (s_ctx->includeStack.isEmpty() || s_ctx->curlyCount > 0) {
+      s_ctx->outputString += a.mid(0, len);
    }
 }
 
@@ -5102,16 +5130,30 @@ static void readIncludeFile(const QString &inc)
          return;
       }
 
-      QString oldFileName = s_yyFileName;
+      QString oldFileName = s_ctx->yyFileName;
 
-      QSharedPointer<FileDef> oldFileDef = s_yyFileDef;
-      int oldLineNr = s_yyLineNr;
+      QSharedPointer<FileDef> oldFileDef = s_ctx->yyFileDef;
+      int oldLineNr = s_ctx->yyLineNr;
 
       // absIncFileName avoids difficulties for incFileName starting with "../"
       QString absIncFileName = incFileName;
 
+      // the result only depends on the directory of the including file
+      QString cacheKey = s_ctx->yyFileName.left(s_ctx->yyFileName.lastIndexOf('/') + 1) + incFileName;
+      bool isCached = false;
+
       {
-         QFileInfo fi1(s_yyFileName);
+         QMutexLocker lock(&s_includeMutex);
+         auto iter = s_includeNameCache.constFind(cacheKey);
+
+         if (iter != s_includeNameCache.constEnd()) {
+            absIncFileName = iter.value();
+            isCached = true;
+         }
+      }
+
+      if (! isCached) {
+         QFileInfo fi1(s_ctx->yyFileName);
 
          if (fi1.exists()) {
             QString absName_1 = fi1.absolutePath() + "/" + incFileName;
@@ -5140,12 +5182,15 @@ static void readIncludeFile(const QString &inc)
             }
 
          }
+
+         QMutexLocker lock(&s_includeMutex);
+         s_includeNameCache.insert(cacheKey, absIncFileName);
       }
 
-      DefineManager::instance().addInclude(s_yyFileName, absIncFileName);
-      DefineManager::instance().addFileToContext(absIncFileName);
+      DefineManager::instance().addInclude(s_ctx->yyFileName, absIncFileName);
+      DefineManager::instance().addFileToContext(s_ctx->contextDefines, absIncFileName);
 
-      // findFile will overwrite s_yyFileDef if found
+      // findFile will overwrite s_ctx->yyFileDef if found
       QSharedPointer<FileState> fs;
       bool alreadyIncluded = false;
 
@@ -5154,6 +5199,7 @@ static void readIncludeFile(const QString &inc)
 
          if (oldFileDef) {
             // add include dependency to the file in which the #include was found
+            QMutexLocker lock(&s_globalMutex);
             bool ambig;
 
             // change to absolute name
@@ -5166,61 +5212,64 @@ static void readIncludeFile(const QString &inc)
                temp = incFd;
             }
 
-            oldFileDef->addIncludeDependency(temp, incFileName, localInclude, s_isImported, false);
+            oldFileDef->addIncludeDependency(temp, incFileName, localInclude, s_ctx->isImported, false);
 
             // add included by dependency
-            if (s_yyFileDef) {
-               s_yyFileDef->addIncludedByDependency(oldFileDef, oldFileDef->docName(), localInclude, s_isImported);
+            if (s_ctx->yyFileDef) {
+               s_ctx->yyFileDef->addIncludedByDependency(oldFileDef, oldFileDef->docName(), localInclude, s_ctx->isImported);
             }
 
-         } else if (s_inputFileDef) {
-            s_inputFileDef->addIncludeDependency(QSharedPointer<FileDef>(), absIncFileName, localInclude, s_isImported, true);
+         } else if (s_ctx->inputFileDef) {
+            QMutexLocker lock(&s_globalMutex);
+            s_ctx->inputFileDef->addIncludeDependency(QSharedPointer<FileDef>(), absIncFileName, localInclude, s_ctx->isImported, true);
 
          }
 
-         fs->bufState   = YY_CURRENT_BUFFER;
+         fs->bufState   = getCurrentBuffer();
          fs->lineNr     = oldLineNr;
          fs->fileName   = oldFileName;
-         fs->curlyCount = s_curlyCount;
+         fs->curlyCount = s_ctx->curlyCount;
 
-         s_curlyCount   = 0;
+         s_ctx->curlyCount   = 0;
 
          // push the state on the stack
-         s_includeStack.push(fs);
+         s_ctx->includeStack.push(fs);
 
          // set the scanner to the include file
 
          // Deal with file changes due to
          // #include's within { .. } blocks
 
-         QString lineStr = QString("# 1 \"%1\" 1\n").formatArg(QString(s_yyFileName));
+         QString lineStr = QString("# 1 \"%1\" 1\n").formatArg(QString(s_ctx->yyFileName));
          outputArray(lineStr, lineStr.length());
 
          DBG_CTX((stderr, "Switching to include file %s\n", csPrintable(incFileName)));
-         s_expectGuard = true;
-         s_inputString    = fs->fileBuf;
-         s_inputPosition = 0;
+         s_ctx->expectGuard = true;
+         s_ctx->inputString    = fs->fileBuf;
+         s_ctx->inputPosition = 0;
 
-         preYY_switch_to_buffer(preYY_create_buffer(0, YY_BUF_SIZE));
+         startNewBuffer();
 
       } else {
 
          if (oldFileDef) {
+            QMutexLocker lock(&s_globalMutex);
             bool ambig;
 
             // change to absolute name for bug 641336
             QSharedPointer<FileDef> fd = findFileDef(&Doxy_Globals::inputNameDict, absIncFileName, ambig);
 
             // add include dependency to the file in which the #include was found
-            oldFileDef->addIncludeDependency(ambig ? QSharedPointer<FileDef>() : fd, incFileName, localInclude, s_isImported, false);
+            oldFileDef->addIncludeDependency(ambig ? QSharedPointer<FileDef>() : fd, incFileName, localInclude, s_ctx->isImported, false);
 
             // add included by dependency
             if (fd) {
-               fd->addIncludedByDependency(oldFileDef, oldFileDef->docName(), localInclude, s_isImported);
+               fd->addIncludedByDependency(oldFileDef, oldFileDef->docName(), localInclude, s_ctx->isImported);
             }
 
-         } else if (s_inputFileDef) {
-            s_inputFileDef->addIncludeDependency(QSharedPointer<FileDef>(), absIncFileName, localInclude, s_isImported, true);
+         } else if (s_ctx->inputFileDef) {
+            QMutexLocker lock(&s_globalMutex);
+            s_ctx->inputFileDef->addIncludeDependency(QSharedPointer<FileDef>(), absIncFileName, localInclude, s_ctx->isImported, true);
          }
 
          if (Debug::isFlagSet(Debug::Preprocessor)) {
@@ -5231,8 +5280,8 @@ static void readIncludeFile(const QString &inc)
             }
          }
 
-         if (s_curlyCount > 0 && !alreadyIncluded) { // failed to find #include inside { ... }
-            warn(s_yyFileName, s_yyLineNr, "include file %s was not found, check the value of INCLUDE_PATH", csPrintable(incFileName));
+         if (s_ctx->curlyCount > 0 && !alreadyIncluded) { // failed to find #include inside { ... }
+            warn(s_ctx->yyFileName, s_ctx->yyLineNr, "include file %s was not found, check the value of INCLUDE_PATH", csPrintable(incFileName));
          }
       }
    }
@@ -5242,32 +5291,32 @@ static void startCondSection(const QString &sectId)
 {
    CondParser prs;
 
-   bool expResult = prs.parse(s_yyFileName, s_yyLineNr, sectId);
-   s_condStack.push( QMakeShared<CondCtx>(s_yyLineNr, sectId, s_skip) );
+   bool expResult = prs.parse(s_ctx->yyFileName, s_ctx->yyLineNr, sectId);
+   s_ctx->condStack.push( QMakeShared<CondCtx>(s_ctx->yyLineNr, sectId, s_ctx->skip) );
 
    if (! expResult) {
-      s_skip = true;
+      s_ctx->skip = true;
    }
 }
 
 static void endCondSection()
 {
-   if (s_condStack.isEmpty()) {
-      s_skip = false;
+   if (s_ctx->condStack.isEmpty()) {
+      s_ctx->skip = false;
 
    } else {
-      QSharedPointer<CondCtx> ctx = s_condStack.pop();
-      s_skip = ctx->skip;
+      QSharedPointer<CondCtx> ctx = s_ctx->condStack.pop();
+      s_ctx->skip = ctx->skip;
    }
 }
 
 static void forceEndCondSection()
 {
-   while (! s_condStack.isEmpty()) {
-      s_condStack.pop();
+   while (! s_ctx->condStack.isEmpty()) {
+      s_ctx->condStack.pop();
    }
 
-   s_skip = false;
+   s_ctx->skip = false;
 }
 
 static QString escapeAt(const QString &text)
@@ -5327,14 +5376,14 @@ static int yyread(char *buf, int max_size)
 {
    int len = max_size;
 
-   const char *src = s_inputString.constData() + s_inputPosition;
+   const char *src = s_ctx->inputString.constData() + s_ctx->inputPosition;
 
-   if (s_inputPosition + len >= s_inputString.size_storage()) {
-      len = s_inputString.size_storage() - s_inputPosition;
+   if (s_ctx->inputPosition + len >= s_ctx->inputString.size_storage()) {
+      len = s_ctx->inputString.size_storage() - s_ctx->inputPosition;
    }
 
    memcpy(buf, src, len);
-   s_inputPosition += len;
+   s_ctx->inputPosition += len;
 
    return len;
 }
@@ -5390,40 +5439,91 @@ static int yyread(char *buf, int max_size)
 #include <unistd.h>
 #endif
     
-#ifndef YY_EXTRA_TYPE
-#define YY_EXTRA_TYPE void *
-#endif
-
-static int yy_init_globals ( void );
+#define YY_EXTRA_TYPE PreprocessorContext *
+
+/* Holds the entire state of the reentrant scanner. */
+struct yyguts_t
+    {
+
+    /* User-defined. Not touched by flex. */
+    YY_EXTRA_TYPE yyextra_r;
+
+    /* The rest are the same as the globals declared in the non-reentrant scanner. */
+    FILE *yyin_r, *yyout_r;
+    size_t yy_buffer_stack_top; /**< index of top of stack. */
+    size_t yy_buffer_stack_max; /**< capacity of stack. */
+    YY_BUFFER_STATE * yy_buffer_stack; /**< Stack as an array. */
+    char yy_hold_char;
+    int yy_n_chars;
+    int yyleng_r;
+    char *yy_c_buf_p;
+    int yy_init;
+    int yy_start;
+    int yy_did_buffer_switch_on_eof;
+    int yy_start_stack_ptr;
+    int yy_start_stack_depth;
+    int *yy_start_stack;
+    yy_state_type yy_last_accepting_state;
+    char* yy_last_accepting_cpos;
+
+    int yylineno_r;
+    int yy_flex_debug_r;
+
+    yy_state_type *yy_state_buf;
+    yy_state_type *yy_state_ptr;
+    char *yy_full_match;
+    int yy_lp;
+
+    /* These are only needed for trailing context rules,
+     * but there's no conditional variable for that yet. */
+    int yy_looking_for_trail_begin;
+    int yy_full_lp;
+    int *yy_full_state;
+
+    char *yytext_r;
+    int yy_more_flag;
+    int yy_more_len;
+
+    }; /* end struct yyguts_t */
+
+static int yy_init_globals ( yyscan_t yyscanner );
+
+int yylex_init (yyscan_t* scanner);
+
+int yylex_init_extra ( YY_EXTRA_TYPE user_defined, yyscan_t* scanner);
 
 /* Accessor methods to globals.
    These are made visible to non-reentrant scanners for convenience. */
 
-int yylex_destroy ( void );
+int yylex_destroy ( yyscan_t yyscanner );
 
-int yyget_debug ( void );
+int yyget_debug ( yyscan_t yyscanner );
 
-void yyset_debug ( int debug_flag  );
+void yyset_debug ( int debug_flag , yyscan_t yyscanner );
 
-YY_EXTRA_TYPE yyget_extra ( void );
+YY_EXTRA_TYPE yyget_extra ( yyscan_t yyscanner );
 
-void yyset_extra ( YY_EXTRA_TYPE user_defined  );
+void yyset_extra ( YY_EXTRA_TYPE user_defined , yyscan_t yyscanner );
 
-FILE *yyget_in ( void );
+FILE *yyget_in ( yyscan_t yyscanner );
 
-void yyset_in  ( FILE * _in_str  );
+void yyset_in  ( FILE * _in_str , yyscan_t yyscanner );
 
-FILE *yyget_out ( void );
+FILE *yyget_out ( yyscan_t yyscanner );
 
-void yyset_out  ( FILE * _out_str  );
+void yyset_out  ( FILE * _out_str , yyscan_t yyscanner );
 
-			int yyget_leng ( void );
+			int yyget_leng ( yyscan_t yyscanner );
 
-char *yyget_text ( void );
+char *yyget_text ( yyscan_t yyscanner );
 
-int yyget_lineno ( void );
+int yyget_lineno ( yyscan_t yyscanner );
 
-void yyset_lineno ( int _line_number  );
+void yyset_lineno ( int _line_number , yyscan_t yyscanner );
+
+int yyget_column  ( yyscan_t yyscanner );
+
+void yyset_column ( int _column_no , yyscan_t yyscanner );
 
 /* Macros after this point can all be overridden by user definitions in
  * section 1.
@@ -5431,31 +5531,31 @@ void yyset_lineno ( int _line_number  );
 
 #ifndef YY_SKIP_YYWRAP
 #ifdef __cplusplus
-extern "C" int yywrap ( void );
+extern "C" int yywrap ( yyscan_t yyscanner );
 #else
-extern int yywrap ( void );
+extern int yywrap ( yyscan_t yyscanner );
 #endif
 #endif
 
 #ifndef YY_NO_UNPUT
     
-    static void yyunput ( int c, char *buf_ptr  );
+    static void yyunput ( int c, char *buf_ptr  , yyscan_t yyscanner);
     
 #endif
 
 #ifndef yytext_ptr
-static void yy_flex_strncpy ( char *, const char *, int );
+static void yy_flex_strncpy ( char *, const char *, int , yyscan_t yyscanner);
 #endif
 
 #ifdef YY_NEED_STRLEN
-static int yy_flex_strlen ( const char * );
+static int yy_flex_strlen ( const char * , yyscan_t yyscanner);
 #endif
 
 #ifndef YY_NO_INPUT
 #ifdef __cplusplus
-static int yyinput ( void );
+static int yyinput ( yyscan_t yyscanner );
 #else
-static int input ( void );
+static int input ( yyscan_t yyscanner );
 #endif
 
 #endif
@@ -5529,7 +5629,7 @@ static int input ( void );
 
 /* Report a fatal error. */
 #ifndef YY_FATAL_ERROR
-#define YY_FATAL_ERROR(msg) yy_fatal_error( msg )
+#define YY_FATAL_ERROR(msg) yy_fatal_error( msg , yyscanner)
 #endif
 
 /* end tables serialization structures and prototypes */
@@ -5540,9 +5640,9 @@ static int input ( void );
 #ifndef YY_DECL
 #define YY_DECL_IS_OURS 1
 
-extern int yylex (void);
+extern int yylex (yyscan_t yyscanner);
 
-#define YY_DECL int yylex (void)
+#define YY_DECL int yylex (yyscan_t yyscanner)
 #endif /* !YY_DECL */
 
 /* Code executed at the beginning of each rule, after yytext and yyleng
@@ -5570,23 +5670,24 @@ YY_DECL
 	yy_state_type yy_current_state;
 	char *yy_cp, *yy_bp;
 	int yy_act;
-    
-	if ( !(yy_init) )
+    struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
+
+	if ( !yyg->yy_init )
 		{
-		(yy_init) = 1;
+		yyg->yy_init = 1;
 
 #ifdef YY_USER_INIT
 		YY_USER_INIT;
 #endif
 
         /* Create the reject buffer large enough to save one state per allowed character. */
-        if ( ! (yy_state_buf) )
-            (yy_state_buf) = (yy_state_type *)yyalloc(YY_STATE_BUF_SIZE  );
-            if ( ! (yy_state_buf) )
+        if ( ! yyg->yy_state_buf )
+            yyg->yy_state_buf = (yy_state_type *)yyalloc(YY_STATE_BUF_SIZE  , yyscanner);
+            if ( ! yyg->yy_state_buf )
                 YY_FATAL_ERROR( "out of dynamic memory in yylex()" );
 
-		if ( ! (yy_start) )
-			(yy_start) = 1;	/* first start state */
+		if ( ! yyg->yy_start )
+			yyg->yy_start = 1;	/* first start state */
 
 		if ( ! yyin )
 			yyin = stdin;
@@ -5595,33 +5696,33 @@ YY_DECL
 			yyout = stdout;
 
 		if ( ! YY_CURRENT_BUFFER ) {
-			yyensure_buffer_stack ();
+			yyensure_buffer_stack (yyscanner);
 			YY_CURRENT_BUFFER_LVALUE =
-				yy_create_buffer( yyin, YY_BUF_SIZE );
+				yy_create_buffer( yyin, YY_BUF_SIZE , yyscanner);
 		}
 
-		yy_load_buffer_state(  );
+		yy_load_buffer_state( yyscanner );
 		}
 
 	{
 
 	while ( /*CONSTCOND*/1 )		/* loops until end-of-file is reached */
 		{
-		yy_cp = (yy_c_buf_p);
+		yy_cp = yyg->yy_c_buf_p;
 
 		/* Support of yytext. */
-		*yy_cp = (yy_hold_char);
+		*yy_cp = yyg->yy_hold_char;
 
 		/* yy_bp points to the position in yy_ch_buf of the start of
 		 * the current run.
 		 */
 		yy_bp = yy_cp;
 
-		yy_current_state = (yy_start);
+		yy_current_state = yyg->yy_start;
 		yy_current_state += YY_AT_BOL();
 
-		(yy_state_ptr) = (yy_state_buf);
-		*(yy_state_ptr)++ = yy_current_state;
+		yyg->yy_state_ptr = yyg->yy_state_buf;
+		*yyg->yy_state_ptr++ = yy_current_state;
 
 yy_match:
 		do
@@ -5634,51 +5735,51 @@ yy_match:
 					yy_c = yy_meta[yy_c];
 				}
 			yy_current_state = yy_nxt[yy_base[yy_current_state] + yy_c];
-			*(yy_state_ptr)++ = yy_current_state;
+			*yyg->yy_state_ptr++ = yy_current_state;
 			++yy_cp;
 			}
 		while ( yy_current_state != 1443 );
 
 yy_find_action:
-		yy_current_state = *--(yy_state_ptr);
-		(yy_lp) = yy_accept[yy_current_state];
+		yy_current_state = *--yyg->yy_state_ptr;
+		yyg->yy_lp = yy_accept[yy_current_state];
 find_rule: /* we branch to this label when backing up */
 		for ( ; ; ) /* until we find what rule we matched */
 			{
-			if ( (yy_lp) && (yy_lp) < yy_accept[yy_current_state + 1] )
+			if ( yyg->yy_lp && yyg->yy_lp < yy_accept[yy_current_state + 1] )
 				{
-				yy_act = yy_acclist[(yy_lp)];
+				yy_act = yy_acclist[yyg->yy_lp];
 				if ( yy_act & YY_TRAILING_HEAD_MASK ||
-				     (yy_looking_for_trail_begin) )
+				     yyg->yy_looking_for_trail_begin )
 					{
-					if ( yy_act == (yy_looking_for_trail_begin) )
+					if ( yy_act == yyg->yy_looking_for_trail_begin )
 						{
-						(yy_looking_for_trail_begin) = 0;
+						yyg->yy_looking_for_trail_begin = 0;
 						yy_act &= ~YY_TRAILING_HEAD_MASK;
 						break;
 						}
 					}
 				else if ( yy_act & YY_TRAILING_MASK )
 					{
-					(yy_looking_for_trail_begin) = yy_act & ~YY_TRAILING_MASK;
-					(yy_looking_for_trail_begin) |= YY_TRAILING_HEAD_MASK;
-					(yy_full_match) = yy_cp;
-					(yy_full_state) = (yy_state_ptr);
-					(yy_full_lp) = (yy_lp);
+					yyg->yy_looking_for_trail_begin = yy_act & ~YY_TRAILING_MASK;
+					yyg->yy_looking_for_trail_begin |= YY_TRAILING_HEAD_MASK;
+					yyg->yy_full_match = yy_cp;
+					yyg->yy_full_state = yyg->yy_state_ptr;
+					yyg->yy_full_lp = yyg->yy_lp;
 					}
 				else
 					{
-					(yy_full_match) = yy_cp;
-					(yy_full_state) = (yy_state_ptr);
-					(yy_full_lp) = (yy_lp);
+					yyg->yy_full_match = yy_cp;
+					yyg->yy_full_state = yyg->yy_state_ptr;
+					yyg->yy_full_lp = yyg->yy_lp;
 					break;
 					}
-				++(yy_lp);
+				++yyg->yy_lp;
 				goto find_rule;
 				}
 			--yy_cp;
-			yy_current_state = *--(yy_state_ptr);
-			(yy_lp) = yy_accept[yy_current_state];
+			yy_current_state = *--yyg->yy_state_ptr;
+			yyg->yy_lp = yy_accept[yy_current_state];
 			}
 
 		YY_DO_BEFORE_ACTION;
@@ -5710,15 +5811,15 @@ case 5:
 YY_RULE_SETUP
 {
       BEGIN(Command);
-      s_yyColNr  += yyleng;
-      s_yyMLines = 0;
+      s_ctx->yyColNr  += yyleng;
+      s_ctx->yyMLines = 0;
    }
 	YY_BREAK
 case 6:
 /* rule 6 can match eol */
-*yy_cp = (yy_hold_char); /* undo effects of setting up yytext */
+*yy_cp = yyg->yy_hold_char; /* undo effects of setting up yytext */
 YY_LINENO_REWIND_TO(yy_cp - 1);
-(yy_c_buf_p) = yy_cp -= 1;
+yyg->yy_c_buf_p = yy_cp -= 1;
 YY_DO_BEFORE_ACTION; /* set up yytext again */
 YY_RULE_SETUP
 {
@@ -5759,11 +5860,11 @@ YY_RULE_SETUP
 
       QSharedPointer<A_Define> def;
 
-      if (skipFuncMacros && ! s_insideFortran && name != "Q_PROPERTY" && ! ( (s_includeStack.isEmpty() || s_curlyCount > 0) && s_macroExpansion &&
-                  (def = DefineManager::instance().isDefined(name)) && (! s_expandOnlyPredef || def->isPredefined)) ) {
+      if (skipFuncMacros && ! s_ctx->insideFortran && name != "Q_PROPERTY" && ! ( (s_ctx->includeStack.isEmpty() || s_ctx->curlyCount > 0) && s_ctx->macroExpansion &&
+                  (def = DefineManager::instance().isDefined(s_ctx->contextDefines, name)) && (! s_ctx->expandOnlyPredef || def->isPredefined)) ) {
 
          outputChar('\n');
-         ++s_yyLineNr;
+         ++s_ctx->yyLineNr;
 
       } else {
          // do not skip
@@ -5782,7 +5883,7 @@ YY_RULE_SETUP
 {
       QString text = QString::fromUtf8(yytext);
 
-      s_yyLineNr += text.count('\n');
+      s_ctx->yyLineNr += text.count('\n');
       outputArray(text, text.length());
    }
 	YY_BREAK
@@ -5792,8 +5893,8 @@ YY_RULE_SETUP
 {
       QString text = QString::fromUtf8(yytext);
 
-      s_delimiter = text.mid(2);
-      s_delimiter.chop(1);
+      s_ctx->delimiter = text.mid(2);
+      s_ctx->delimiter.chop(1);
 
       outputArray(text, text.length());
       BEGIN(CopyRawString);
@@ -5805,8 +5906,8 @@ YY_RULE_SETUP
       // count brackets inside the main file
       QString text = QString::fromUtf8(yytext);
 
-      if (s_includeStack.isEmpty())  {
-         ++s_curlyCount;
+      if (s_ctx->includeStack.isEmpty())  {
+         ++s_ctx->curlyCount;
       }
 
       outputChar(text[0]);
@@ -5818,8 +5919,8 @@ YY_RULE_SETUP
       // count brackets inside the main file
       QString text = QString::fromUtf8(yytext);
 
-      if (s_includeStack.isEmpty() && s_curlyCount > 0)  {
-         --s_curlyCount;
+      if (s_ctx->includeStack.isEmpty() && s_ctx->curlyCount > 0)  {
+         --s_ctx->curlyCount;
       }
 
       outputChar(text[0]);
@@ -5849,7 +5950,7 @@ YY_RULE_SETUP
 case 17:
 YY_RULE_SETUP
 {
-      if (getLanguageFromFileName(s_yyFileName) != SrcLangExt_CSharp) {
+      if (getLanguageFromFileName(s_ctx->yyFileName) != SrcLangExt_CSharp) {
          REJECT;
       }
 
@@ -5865,7 +5966,7 @@ YY_RULE_SETUP
       QString text = QString::fromUtf8(yytext);
       outputChar(text[0]);
 
-      if (getLanguageFromFileName(s_yyFileName) != SrcLangExt_Fortran) {
+      if (getLanguageFromFileName(s_ctx->yyFileName) != SrcLangExt_Fortran) {
          BEGIN(CopyString);
       } else {
          BEGIN(CopyStringFtnDouble);
@@ -5875,7 +5976,7 @@ YY_RULE_SETUP
 case 19:
 YY_RULE_SETUP
 {
-      if (getLanguageFromFileName(s_yyFileName) != SrcLangExt_Fortran) {
+      if (getLanguageFromFileName(s_ctx->yyFileName) != SrcLangExt_Fortran) {
          REJECT;
       }
 
@@ -5968,7 +6069,7 @@ YY_RULE_SETUP
       QString tmp = text.mid(1);
       tmp.chop(1);
 
-      if (tmp == s_delimiter) {
+      if (tmp == s_ctx->delimiter) {
          BEGIN( CopyLine );
       }
    }
@@ -5994,27 +6095,27 @@ YY_RULE_SETUP
 {
       QString text = QString::fromUtf8(yytext);
 
-      s_expectGuard = false;
+      s_ctx->expectGuard = false;
       QSharedPointer<A_Define> def;
 
-      if ((s_includeStack.isEmpty() || s_curlyCount > 0) && s_macroExpansion &&
-                  (def = DefineManager::instance().isDefined(text)) &&
-                  (! s_expandOnlyPredef || def->isPredefined)) {
+      if ((s_ctx->includeStack.isEmpty() || s_ctx->curlyCount > 0) && s_ctx->macroExpansion &&
+                  (def = DefineManager::instance().isDefined(s_ctx->contextDefines, text)) &&
+                  (! s_ctx->expandOnlyPredef || def->isPredefined)) {
 
          // found it
-         s_roundCount = 0;
-         s_defArgsStr = text;
+         s_ctx->roundCount = 0;
+         s_ctx->defArgsStr = text;
 
          if (def->nargs == -1) {
             // no function macro
 
-            QString result = def->isPredefined ? def->m_definition : expandMacro(s_defArgsStr);
+            QString result = def->isPredefined ? def->m_definition : expandMacro(s_ctx->defArgsStr);
             outputArray(result, result.length());
 
          } else {
             // zero or more arguments
 
-            s_findDefArgContext = CopyLine;
+            s_ctx->findDefArgContext = CopyLine;
             BEGIN(FindDefineArgs);
 
          }
@@ -6031,9 +6132,9 @@ YY_RULE_SETUP
 
       QSharedPointer<A_Define> def;
 
-      if ((s_includeStack.isEmpty() || s_curlyCount > 0) && s_macroExpansion &&
-                  (def = DefineManager::instance().isDefined(text)) &&
-                   def->nargs == -1 && (! s_expandOnlyPredef || def->isPredefined)) {
+      if ((s_ctx->includeStack.isEmpty() || s_ctx->curlyCount > 0) && s_ctx->macroExpansion &&
+                  (def = DefineManager::instance().isDefined(s_ctx->contextDefines, text)) &&
+                   def->nargs == -1 && (! s_ctx->expandOnlyPredef || def->isPredefined)) {
 
             QString result = def->isPredefined ? def->m_definition : expandMacro(text);
             outputArray(result, result.length());
@@ -6045,15 +6146,15 @@ YY_RULE_SETUP
 	YY_BREAK
 case 35:
 /* rule 35 can match eol */
-*yy_cp = (yy_hold_char); /* undo effects of setting up yytext */
+*yy_cp = yyg->yy_hold_char; /* undo effects of setting up yytext */
 YY_LINENO_REWIND_TO(yy_cp - 1);
-(yy_c_buf_p) = yy_cp -= 1;
+yyg->yy_c_buf_p = yy_cp -= 1;
 YY_DO_BEFORE_ACTION; /* set up yytext again */
 YY_RULE_SETUP
 {
       //  strip line continuation characters
 
-      if (getLanguageFromFileName(s_yyFileName) == SrcLangExt_Fortran)  {
+      if (getLanguageFromFileName(s_ctx->yyFileName) == SrcLangExt_Fortran)  {
          QString text = QString::fromUtf8(yytext);
          outputChar(text[0]);
       }
@@ -6079,33 +6180,33 @@ YY_RULE_SETUP
 {
       outputChar('\n');
       BEGIN(Start);
-      ++s_yyLineNr;
-      s_yyColNr = 1;
+      ++s_ctx->yyLineNr;
+      s_ctx->yyColNr = 1;
    }
 	YY_BREAK
 case 39:
 YY_RULE_SETUP
 {
-      s_defArgsStr += '(';
-      ++s_roundCount;
+      s_ctx->defArgsStr += '(';
+      ++s_ctx->roundCount;
    }
 	YY_BREAK
 case 40:
 YY_RULE_SETUP
 {
-      s_defArgsStr += ')';
-      --s_roundCount;
+      s_ctx->defArgsStr += ')';
+      --s_ctx->roundCount;
 
-      if (s_roundCount == 0) {
-         QString result = expandMacro(s_defArgsStr);
+      if (s_ctx->roundCount == 0) {
+         QString result = expandMacro(s_ctx->defArgsStr);
 
-         if (s_findDefArgContext == CopyLine) {
+         if (s_ctx->findDefArgContext == CopyLine) {
             outputArray(result, result.length());
-            BEGIN(s_findDefArgContext);
+            BEGIN(s_ctx->findDefArgContext);
 
          } else {
             readIncludeFile(result);
-            s_nospaces = false;
+            s_ctx->nospaces = false;
             BEGIN(Start);
          }
       }
@@ -6114,14 +6215,14 @@ YY_RULE_SETUP
 /*
 <FindDefineArgs>")"{B}*"("       {
       QString text = QString::fromUtf8(yytext);
-      s_defArgsStr += text;
+      s_ctx->defArgsStr += text;
    }
   */
 case 41:
 YY_RULE_SETUP
 {
       QString text = QString::fromUtf8(yytext);
-      s_defArgsStr += text;
+      s_ctx->defArgsStr += text;
     }
 	YY_BREAK
 case 42:
@@ -6129,7 +6230,7 @@ YY_RULE_SETUP
 {
       // */ (editor syntax fix)
       QString text = QString::fromUtf8(yytext);
-      s_defArgsStr += text;
+      s_ctx->defArgsStr += text;
       BEGIN(ArgCopyCComment);
    }
 	YY_BREAK
@@ -6137,7 +6238,7 @@ case 43:
 YY_RULE_SETUP
 {
       QString text = QString::fromUtf8(yytext);
-      s_defArgsStr += text[0];
+      s_ctx->defArgsStr += text[0];
       BEGIN(ReadString);
    }
 	YY_BREAK
@@ -6146,11 +6247,11 @@ YY_RULE_SETUP
 {
       QString text = QString::fromUtf8(yytext);
 
-      if (getLanguageFromFileName(s_yyFileName) != SrcLangExt_Fortran) {
+      if (getLanguageFromFileName(s_ctx->yyFileName) != SrcLangExt_Fortran) {
          REJECT;
       }
 
-      s_defArgsStr += text[0];
+      s_ctx->defArgsStr += text[0];
       BEGIN(ReadString);
    }
 	YY_BREAK
@@ -6158,34 +6259,34 @@ case 45:
 /* rule 45 can match eol */
 YY_RULE_SETUP
 {
-      s_defArgsStr += ' ';
-      ++s_yyLineNr;
+      s_ctx->defArgsStr += ' ';
+      ++s_ctx->yyLineNr;
       outputChar('\n');
    }
 	YY_BREAK
 case 46:
 YY_RULE_SETUP
 {
-      s_defArgsStr += "@@";
+      s_ctx->defArgsStr += "@@";
    }
 	YY_BREAK
 case 47:
 YY_RULE_SETUP
 {
       QString text = QString::fromUtf8(yytext);
-      s_defArgsStr += text[0];
+      s_ctx->defArgsStr += text[0];
    }
 	YY_BREAK
 case 48:
 YY_RULE_SETUP
 {
-      s_defArgsStr += QString::fromUtf8(yytext);
+      s_ctx->defArgsStr += QString::fromUtf8(yytext);
    }
 	YY_BREAK
 case 49:
 YY_RULE_SETUP
 {
-      s_defArgsStr += QString::fromUtf8(yytext);
+      s_ctx->defArgsStr += QString::fromUtf8(yytext);
       BEGIN(FindDefineArgs);
    }
 	YY_BREAK
@@ -6193,22 +6294,22 @@ case 50:
 /* rule 50 can match eol */
 YY_RULE_SETUP
 {
-      s_defArgsStr += ' ';
-      ++s_yyLineNr;
+      s_ctx->defArgsStr += ' ';
+      ++s_ctx->yyLineNr;
       outputChar('\n');
    }
 	YY_BREAK
 case 51:
 YY_RULE_SETUP
 {
-      s_defArgsStr += QString::fromUtf8(yytext);
+      s_ctx->defArgsStr += QString::fromUtf8(yytext);
    }
 	YY_BREAK
 case 52:
 YY_RULE_SETUP
 {
       QString text = QString::fromUtf8(yytext);
-      s_defArgsStr += text[0];
+      s_ctx->defArgsStr += text[0];
       BEGIN(FindDefineArgs);
    }
 	YY_BREAK
@@ -6217,11 +6318,11 @@ YY_RULE_SETUP
 {
       QString text = QString::fromUtf8(yytext);
 
-      if (getLanguageFromFileName(s_yyFileName) != SrcLangExt_Fortran) {
+      if (getLanguageFromFileName(s_ctx->yyFileName) != SrcLangExt_Fortran) {
          REJECT;
       }
 
-      s_defArgsStr += text[0];
+      s_ctx->defArgsStr += text[0];
       BEGIN(FindDefineArgs);
    }
 	YY_BREAK
@@ -6229,14 +6330,14 @@ case 54:
 YY_RULE_SETUP
 {
       // */ (editor syntax fix)
-      s_defArgsStr += QString::fromUtf8(yytext);
+      s_ctx->defArgsStr += QString::fromUtf8(yytext);
    }
 	YY_BREAK
 case 55:
 /* rule 55 can match eol */
-*yy_cp = (yy_hold_char); /* undo effects of setting up yytext */
+*yy_cp = yyg->yy_hold_char; /* undo effects of setting up yytext */
 YY_LINENO_REWIND_TO(yy_bp + 1);
-(yy_c_buf_p) = yy_cp = yy_bp + 1;
+yyg->yy_c_buf_p = yy_cp = yy_bp + 1;
 YY_DO_BEFORE_ACTION; /* set up yytext again */
 YY_RULE_SETUP
 {
@@ -6246,23 +6347,23 @@ YY_RULE_SETUP
 case 56:
 YY_RULE_SETUP
 {
-      s_defArgsStr += QString::fromUtf8(yytext);
+      s_ctx->defArgsStr += QString::fromUtf8(yytext);
    }
 	YY_BREAK
 case 57:
 YY_RULE_SETUP
 {
       QString text = QString::fromUtf8(yytext);
-      s_defArgsStr += text[0];
+      s_ctx->defArgsStr += text[0];
    }
 	YY_BREAK
 case 58:
 YY_RULE_SETUP
 {
       QString text = QString::fromUtf8(yytext);
-      s_isImported = text[1] == 'm';
+      s_ctx->isImported = text[1] == 'm';
 
-      if (s_macroExpansion) {
+      if (s_ctx->macroExpansion) {
          BEGIN(IncludeID);
       }
    }
@@ -6271,100 +6372,100 @@ case 59:
 YY_RULE_SETUP
 {
       QString text = QString::fromUtf8(yytext);
-      s_isImported = text[1] == 'm';
-      s_incName = text[text.length() - 1];
+      s_ctx->isImported = text[1] == 'm';
+      s_ctx->incName = text[text.length() - 1];
       BEGIN(Include);
    }
 	YY_BREAK
 case 60:
 YY_RULE_SETUP
 {
-      s_yyColNr += yyleng;
+      s_ctx->yyColNr += yyleng;
       BEGIN(DefName);
    }
 	YY_BREAK
 case 61:
-*yy_cp = (yy_hold_char); /* undo effects of setting up yytext */
-(yy_c_buf_p) = yy_cp = yy_bp + 5;
+*yy_cp = yyg->yy_hold_char; /* undo effects of setting up yytext */
+yyg->yy_c_buf_p = yy_cp = yy_bp + 5;
 YY_DO_BEFORE_ACTION; /* set up yytext again */
 YY_RULE_SETUP
 {
       incrLevel();
-      s_guardExpr.resize(0);
+      s_ctx->guardExpr.resize(0);
       BEGIN(DefinedExpr2);
    }
 	YY_BREAK
 case 62:
-*yy_cp = (yy_hold_char); /* undo effects of setting up yytext */
-(yy_c_buf_p) = yy_cp = yy_bp + 5;
+*yy_cp = yyg->yy_hold_char; /* undo effects of setting up yytext */
+yyg->yy_c_buf_p = yy_cp = yy_bp + 5;
 YY_DO_BEFORE_ACTION; /* set up yytext again */
 YY_RULE_SETUP
 {
       incrLevel();
-      s_guardExpr.resize(0);
+      s_ctx->guardExpr.resize(0);
       BEGIN(DefinedExpr1);
    }
 	YY_BREAK
 case 63:
-*yy_cp = (yy_hold_char); /* undo effects of setting up yytext */
-(yy_c_buf_p) = yy_cp = yy_bp + 6;
+*yy_cp = yyg->yy_hold_char; /* undo effects of setting up yytext */
+yyg->yy_c_buf_p = yy_cp = yy_bp + 6;
 YY_DO_BEFORE_ACTION; /* set up yytext again */
 YY_RULE_SETUP
 {
       incrLevel();
-      s_guardExpr = "! ";
+      s_ctx->guardExpr = "! ";
       BEGIN(DefinedExpr2);
    }
 	YY_BREAK
 case 64:
-*yy_cp = (yy_hold_char); /* undo effects of setting up yytext */
-(yy_c_buf_p) = yy_cp = yy_bp + 6;
+*yy_cp = yyg->yy_hold_char; /* undo effects of setting up yytext */
+yyg->yy_c_buf_p = yy_cp = yy_bp + 6;
 YY_DO_BEFORE_ACTION; /* set up yytext again */
 YY_RULE_SETUP
 {
       incrLevel();
-      s_guardExpr = "! ";
+      s_ctx->guardExpr = "! ";
       BEGIN(DefinedExpr1);
    }
 	YY_BREAK
 case 65:
-*yy_cp = (yy_hold_char); /* undo effects of setting up yytext */
-(yy_c_buf_p) = yy_cp = yy_bp + 2;
+*yy_cp = yyg->yy_hold_char; /* undo effects of setting up yytext */
+yyg->yy_c_buf_p = yy_cp = yy_bp + 2;
 YY_DO_BEFORE_ACTION; /* set up yytext again */
 YY_RULE_SETUP
 {
       incrLevel();
-      s_guardExpr.resize(0);
+      s_ctx->guardExpr.resize(0);
       BEGIN(Guard);
    }
 	YY_BREAK
 case 66:
-*yy_cp = (yy_hold_char); /* undo effects of setting up yytext */
-(yy_c_buf_p) = yy_cp -= 1;
+*yy_cp = yyg->yy_hold_char; /* undo effects of setting up yytext */
+yyg->yy_c_buf_p = yy_cp -= 1;
 YY_DO_BEFORE_ACTION; /* set up yytext again */
 YY_RULE_SETUP
 {
       if (! otherCaseDone()) {
-         s_guardExpr.resize(0);
+         s_ctx->guardExpr.resize(0);
          BEGIN(Guard);
 
       } else {
-         s_ifcount = 0;
+         s_ctx->ifcount = 0;
          BEGIN(SkipCPPBlock);
       }
    }
 	YY_BREAK
 case 67:
 /* rule 67 can match eol */
-*yy_cp = (yy_hold_char); /* undo effects of setting up yytext */
+*yy_cp = yyg->yy_hold_char; /* undo effects of setting up yytext */
 YY_LINENO_REWIND_TO(yy_bp + 4);
-(yy_c_buf_p) = yy_cp = yy_bp + 4;
+yyg->yy_c_buf_p = yy_cp = yy_bp + 4;
 YY_DO_BEFORE_ACTION; /* set up yytext again */
 YY_RULE_SETUP
 {
 
       if (otherCaseDone()) {
-         s_ifcount = 0;
+         s_ctx->ifcount = 0;
          BEGIN(SkipCPPBlock);
 
       } else {
@@ -6379,22 +6480,22 @@ YY_RULE_SETUP
    }
 	YY_BREAK
 case 69:
-*yy_cp = (yy_hold_char); /* undo effects of setting up yytext */
-(yy_c_buf_p) = yy_cp -= 1;
+*yy_cp = yyg->yy_hold_char; /* undo effects of setting up yytext */
+yyg->yy_c_buf_p = yy_cp -= 1;
 YY_DO_BEFORE_ACTION; /* set up yytext again */
 YY_RULE_SETUP
 {
       if (! otherCaseDone()) {
-         s_guardExpr.resize(0);
+         s_ctx->guardExpr.resize(0);
          BEGIN(Guard);
       }
    }
 	YY_BREAK
 case 70:
 /* rule 70 can match eol */
-*yy_cp = (yy_hold_char); /* undo effects of setting up yytext */
+*yy_cp = yyg->yy_hold_char; /* undo effects of setting up yytext */
 YY_LINENO_REWIND_TO(yy_bp + 5);
-(yy_c_buf_p) = yy_cp = yy_bp + 5;
+yyg->yy_c_buf_p = yy_cp = yy_bp + 5;
 YY_DO_BEFORE_ACTION; /* set up yytext again */
 YY_RULE_SETUP
 {
@@ -6407,13 +6508,13 @@ YY_RULE_SETUP
 {
       outputChar('\n');
       BEGIN(Start);
-      ++s_yyLineNr;
+      ++s_ctx->yyLineNr;
    }
 	YY_BREAK
 case 72:
 YY_RULE_SETUP
 {
-      s_expectGuard = false;
+      s_ctx->expectGuard = false;
    }
 	YY_BREAK
 case 73:
@@ -6428,7 +6529,7 @@ case 74:
 YY_RULE_SETUP
 {
       outputChar('\n');
-      ++s_yyLineNr;
+      ++s_ctx->yyLineNr;
    }
 	YY_BREAK
 case 75:
@@ -6438,7 +6539,7 @@ YY_RULE_SETUP
 case 76:
 YY_RULE_SETUP
 {
-      s_yyColNr += yyleng;
+      s_ctx->yyColNr += yyleng;
    }
 	YY_BREAK
 case 77:
@@ -6448,7 +6549,7 @@ YY_RULE_SETUP
 
       QSharedPointer<A_Define> def;
 
-      if ((def = DefineManager::instance().isDefined(text)) && ! def->nonRecursive) {
+      if ((def = DefineManager::instance().isDefined(s_ctx->contextDefines, text)) && ! def->nonRecursive) {
          def->undef = true;
       }
       BEGIN(Start);
@@ -6459,13 +6560,13 @@ case 78:
 YY_RULE_SETUP
 {
       outputChar('\n');
-      s_guardExpr += ' ';
-      ++s_yyLineNr;
+      s_ctx->guardExpr += ' ';
+      ++s_ctx->yyLineNr;
    }
 	YY_BREAK
 case 79:
-*yy_cp = (yy_hold_char); /* undo effects of setting up yytext */
-(yy_c_buf_p) = yy_cp = yy_bp + 7;
+*yy_cp = yyg->yy_hold_char; /* undo effects of setting up yytext */
+yyg->yy_c_buf_p = yy_cp = yy_bp + 7;
 YY_DO_BEFORE_ACTION; /* set up yytext again */
 YY_RULE_SETUP
 {
@@ -6473,8 +6574,8 @@ YY_RULE_SETUP
    }
 	YY_BREAK
 case 80:
-*yy_cp = (yy_hold_char); /* undo effects of setting up yytext */
-(yy_c_buf_p) = yy_cp = yy_bp + 7;
+*yy_cp = yyg->yy_hold_char; /* undo effects of setting up yytext */
+yyg->yy_c_buf_p = yy_cp = yy_bp + 7;
 YY_DO_BEFORE_ACTION; /* set up yytext again */
 YY_RULE_SETUP
 {
@@ -6483,115 +6584,115 @@ YY_RULE_SETUP
 	YY_BREAK
 case 81:
 /* rule 81 can match eol */
-*yy_cp = (yy_hold_char); /* undo effects of setting up yytext */
+*yy_cp = yyg->yy_hold_char; /* undo effects of setting up yytext */
 YY_LINENO_REWIND_TO(yy_bp + 4);
-(yy_c_buf_p) = yy_cp = yy_bp + 4;
+yyg->yy_c_buf_p = yy_cp = yy_bp + 4;
 YY_DO_BEFORE_ACTION; /* set up yytext again */
 YY_RULE_SETUP
 {
-      s_guardExpr += "1L";
+      s_ctx->guardExpr += "1L";
    }
 	YY_BREAK
 case 82:
 /* rule 82 can match eol */
-*yy_cp = (yy_hold_char); /* undo effects of setting up yytext */
+*yy_cp = yyg->yy_hold_char; /* undo effects of setting up yytext */
 YY_LINENO_REWIND_TO(yy_bp + 5);
-(yy_c_buf_p) = yy_cp = yy_bp + 5;
+yyg->yy_c_buf_p = yy_cp = yy_bp + 5;
 YY_DO_BEFORE_ACTION; /* set up yytext again */
 YY_RULE_SETUP
 {
-      s_guardExpr += "0L";
+      s_ctx->guardExpr += "0L";
    }
 	YY_BREAK
 case 83:
-*yy_cp = (yy_hold_char); /* undo effects of setting up yytext */
-(yy_c_buf_p) = yy_cp = yy_bp + 3;
+*yy_cp = yyg->yy_hold_char; /* undo effects of setting up yytext */
+yyg->yy_c_buf_p = yy_cp = yy_bp + 3;
 YY_DO_BEFORE_ACTION; /* set up yytext again */
 YY_RULE_SETUP
 {
-      s_guardExpr += '!';
+      s_ctx->guardExpr += '!';
    }
 	YY_BREAK
 case 84:
-*yy_cp = (yy_hold_char); /* undo effects of setting up yytext */
-(yy_c_buf_p) = yy_cp = yy_bp + 6;
+*yy_cp = yyg->yy_hold_char; /* undo effects of setting up yytext */
+yyg->yy_c_buf_p = yy_cp = yy_bp + 6;
 YY_DO_BEFORE_ACTION; /* set up yytext again */
 YY_RULE_SETUP
 {
-      s_guardExpr += "!=";
+      s_ctx->guardExpr += "!=";
    }
 	YY_BREAK
 case 85:
-*yy_cp = (yy_hold_char); /* undo effects of setting up yytext */
-(yy_c_buf_p) = yy_cp = yy_bp + 3;
+*yy_cp = yyg->yy_hold_char; /* undo effects of setting up yytext */
+yyg->yy_c_buf_p = yy_cp = yy_bp + 3;
 YY_DO_BEFORE_ACTION; /* set up yytext again */
 YY_RULE_SETUP
 {
-      s_guardExpr += "&&";
+      s_ctx->guardExpr += "&&";
    }
 	YY_BREAK
 case 86:
-*yy_cp = (yy_hold_char); /* undo effects of setting up yytext */
-(yy_c_buf_p) = yy_cp = yy_bp + 2;
+*yy_cp = yyg->yy_hold_char; /* undo effects of setting up yytext */
+yyg->yy_c_buf_p = yy_cp = yy_bp + 2;
 YY_DO_BEFORE_ACTION; /* set up yytext again */
 YY_RULE_SETUP
 {
-      s_guardExpr+="||";
+      s_ctx->guardExpr+="||";
    }
 	YY_BREAK
 case 87:
-*yy_cp = (yy_hold_char); /* undo effects of setting up yytext */
-(yy_c_buf_p) = yy_cp = yy_bp + 6;
+*yy_cp = yyg->yy_hold_char; /* undo effects of setting up yytext */
+yyg->yy_c_buf_p = yy_cp = yy_bp + 6;
 YY_DO_BEFORE_ACTION; /* set up yytext again */
 YY_RULE_SETUP
 {
-      s_guardExpr += "&";
+      s_ctx->guardExpr += "&";
    }
 	YY_BREAK
 case 88:
-*yy_cp = (yy_hold_char); /* undo effects of setting up yytext */
-(yy_c_buf_p) = yy_cp = yy_bp + 5;
+*yy_cp = yyg->yy_hold_char; /* undo effects of setting up yytext */
+yyg->yy_c_buf_p = yy_cp = yy_bp + 5;
 YY_DO_BEFORE_ACTION; /* set up yytext again */
 YY_RULE_SETUP
 {
-      s_guardExpr += "|";
+      s_ctx->guardExpr += "|";
    }
 	YY_BREAK
 case 89:
-*yy_cp = (yy_hold_char); /* undo effects of setting up yytext */
-(yy_c_buf_p) = yy_cp = yy_bp + 3;
+*yy_cp = yyg->yy_hold_char; /* undo effects of setting up yytext */
+yyg->yy_c_buf_p = yy_cp = yy_bp + 3;
 YY_DO_BEFORE_ACTION; /* set up yytext again */
 YY_RULE_SETUP
 {
-      s_guardExpr += "^";
+      s_ctx->guardExpr += "^";
    }
 	YY_BREAK
 case 90:
-*yy_cp = (yy_hold_char); /* undo effects of setting up yytext */
-(yy_c_buf_p) = yy_cp = yy_bp + 5;
+*yy_cp = yyg->yy_hold_char; /* undo effects of setting up yytext */
+yyg->yy_c_buf_p = yy_cp = yy_bp + 5;
 YY_DO_BEFORE_ACTION; /* set up yytext again */
 YY_RULE_SETUP
 {
-      s_guardExpr += "~";
+      s_ctx->guardExpr += "~";
    }
 	YY_BREAK
 case 91:
 YY_RULE_SETUP
 {
-      s_guardExpr += QString::fromUtf8(yytext);
+      s_ctx->guardExpr += QString::fromUtf8(yytext);
    }
 	YY_BREAK
 case 92:
 YY_RULE_SETUP
 {
-      s_guardExpr += "@@";
+      s_ctx->guardExpr += "@@";
    }
 	YY_BREAK
 case 93:
 YY_RULE_SETUP
 {
       QString text = QString::fromUtf8(yytext);
-      s_guardExpr += text[0];
+      s_ctx->guardExpr += text[0];
    }
 	YY_BREAK
 case 94:
@@ -6600,14 +6701,14 @@ YY_RULE_SETUP
 {
       unput('\n');
 
-      bool guard = computeExpression(s_guardExpr);
+      bool guard = computeExpression(s_ctx->guardExpr);
       setCaseDone(guard);
 
       if (guard) {
          BEGIN(Start);
 
       } else {
-         s_ifcount = 0;
+         s_ctx->ifcount = 0;
          BEGIN(SkipCPPBlock);
       }
    }
@@ -6616,7 +6717,7 @@ case 95:
 /* rule 95 can match eol */
 YY_RULE_SETUP
 {
-      ++s_yyLineNr;
+      ++s_ctx->yyLineNr;
       outputChar('\n');
    }
 	YY_BREAK
@@ -6625,13 +6726,13 @@ YY_RULE_SETUP
 {
       QString text = QString::fromUtf8(yytext);
 
-      if (DefineManager::instance().isDefined(text) || s_guardName == text) {
-         s_guardExpr+=" 1L ";
+      if (DefineManager::instance().isDefined(s_ctx->contextDefines, text) || s_ctx->guardName == text) {
+         s_ctx->guardExpr+=" 1L ";
       } else {
-         s_guardExpr+=" 0L ";
+         s_ctx->guardExpr+=" 0L ";
       }
 
-      s_lastGuardName = text;
+      s_ctx->lastGuardName = text;
       BEGIN(Guard);
    }
 	YY_BREAK
@@ -6640,13 +6741,13 @@ YY_RULE_SETUP
 {
       QString text = QString::fromUtf8(yytext);
 
-      if (DefineManager::instance().isDefined(text) || s_guardName == text){
-         s_guardExpr+=" 1L ";
+      if (DefineManager::instance().isDefined(s_ctx->contextDefines, text) || s_ctx->guardName == text){
+         s_ctx->guardExpr+=" 1L ";
       } else {
-         s_guardExpr+=" 0L ";
+         s_ctx->guardExpr+=" 0L ";
       }
 
-      s_lastGuardName = text;
+      s_ctx->lastGuardName = text;
    }
 	YY_BREAK
 case 98:
@@ -6655,8 +6756,8 @@ YY_RULE_SETUP
 {
       // should not happen, handle anyway
 
-      ++s_yyLineNr;
-      s_ifcount = 0;
+      ++s_ctx->yyLineNr;
+      s_ctx->ifcount = 0;
       BEGIN(SkipCPPBlock);
    }
 	YY_BREAK
@@ -6678,9 +6779,9 @@ YY_RULE_SETUP
 	YY_BREAK
 case 102:
 /* rule 102 can match eol */
-*yy_cp = (yy_hold_char); /* undo effects of setting up yytext */
+*yy_cp = yyg->yy_hold_char; /* undo effects of setting up yytext */
 YY_LINENO_REWIND_TO(yy_cp - 1);
-(yy_c_buf_p) = yy_cp -= 1;
+yyg->yy_c_buf_p = yy_cp -= 1;
 YY_DO_BEFORE_ACTION; /* set up yytext again */
 YY_RULE_SETUP
 {
@@ -6691,7 +6792,7 @@ case 103:
 /* rule 103 can match eol */
 YY_RULE_SETUP
 {
-      ++s_yyLineNr;
+      ++s_ctx->yyLineNr;
       outputChar('\n');
    }
 	YY_BREAK
@@ -6700,35 +6801,35 @@ YY_RULE_SETUP
 
 	YY_BREAK
 case 105:
-*yy_cp = (yy_hold_char); /* undo effects of setting up yytext */
-(yy_c_buf_p) = yy_cp -= 1;
+*yy_cp = yyg->yy_hold_char; /* undo effects of setting up yytext */
+yyg->yy_c_buf_p = yy_cp -= 1;
 YY_DO_BEFORE_ACTION; /* set up yytext again */
 YY_RULE_SETUP
 {
       incrLevel();
-      ++s_ifcount;
+      ++s_ctx->ifcount;
    }
 	YY_BREAK
 case 106:
 YY_RULE_SETUP
 {
-      if (s_ifcount == 0 && ! otherCaseDone()) {
+      if (s_ctx->ifcount == 0 && ! otherCaseDone()) {
          setCaseDone(true);
          BEGIN(Start);
       }
    }
 	YY_BREAK
 case 107:
-*yy_cp = (yy_hold_char); /* undo effects of setting up yytext */
-(yy_c_buf_p) = yy_cp -= 1;
+*yy_cp = yyg->yy_hold_char; /* undo effects of setting up yytext */
+yyg->yy_c_buf_p = yy_cp -= 1;
 YY_DO_BEFORE_ACTION; /* set up yytext again */
 YY_RULE_SETUP
 {
-      if (s_ifcount == 0)  {
+      if (s_ctx->ifcount == 0)  {
 
          if (! otherCaseDone()) {
-            s_guardExpr.resize(0);
-            s_lastGuardName.resize(0);
+            s_ctx->guardExpr.resize(0);
+            s_ctx->lastGuardName.resize(0);
             BEGIN(Guard);
 
          } else {
@@ -6740,10 +6841,10 @@ YY_RULE_SETUP
 case 108:
 YY_RULE_SETUP
 {
-      s_expectGuard = false;
+      s_ctx->expectGuard = false;
       decrLevel();
 
-      if (--s_ifcount < 0) {
+      if (--s_ctx->ifcount < 0) {
          BEGIN(Start);
       }
    }
@@ -6753,7 +6854,7 @@ case 109:
 YY_RULE_SETUP
 {
       outputChar('\n');
-      ++s_yyLineNr;
+      ++s_ctx->yyLineNr;
       BEGIN(SkipCPPBlock);
    }
 	YY_BREAK
@@ -6788,8 +6889,8 @@ YY_RULE_SETUP
 
 	YY_BREAK
 case 116:
-*yy_cp = (yy_hold_char); /* undo effects of setting up yytext */
-(yy_c_buf_p) = yy_cp = yy_bp + 2;
+*yy_cp = yyg->yy_hold_char; /* undo effects of setting up yytext */
+yyg->yy_c_buf_p = yy_cp = yy_bp + 2;
 YY_DO_BEFORE_ACTION; /* set up yytext again */
 YY_RULE_SETUP
 {
@@ -6798,13 +6899,13 @@ YY_RULE_SETUP
 case 117:
 YY_RULE_SETUP
 {
-      s_lastCPPContext = YY_START;
+      s_ctx->lastCPPContext = YY_START;
       BEGIN(RemoveCPPComment);
    }
 	YY_BREAK
 case 118:
-*yy_cp = (yy_hold_char); /* undo effects of setting up yytext */
-(yy_c_buf_p) = yy_cp = yy_bp + 2;
+*yy_cp = yyg->yy_hold_char; /* undo effects of setting up yytext */
+yyg->yy_c_buf_p = yy_cp = yy_bp + 2;
 YY_DO_BEFORE_ACTION; /* set up yytext again */
 YY_RULE_SETUP
 {
@@ -6812,14 +6913,14 @@ YY_RULE_SETUP
    }
 	YY_BREAK
 case 119:
-*yy_cp = (yy_hold_char); /* undo effects of setting up yytext */
-(yy_c_buf_p) = yy_cp = yy_bp + 2;
+*yy_cp = yyg->yy_hold_char; /* undo effects of setting up yytext */
+yyg->yy_c_buf_p = yy_cp = yy_bp + 2;
 YY_DO_BEFORE_ACTION; /* set up yytext again */
 YY_RULE_SETUP
 {
       // */ (editor syntax fix)
 
-      s_lastCContext=YY_START;
+      s_ctx->lastCContext=YY_START;
       BEGIN(RemoveCComment);
    }
 	YY_BREAK
@@ -6828,7 +6929,7 @@ case 120:
 YY_RULE_SETUP
 {
       outputChar('\n');
-      ++s_yyLineNr;
+      ++s_ctx->yyLineNr;
       BEGIN(SkipCPPBlock);
    }
 	YY_BREAK
@@ -6854,17 +6955,17 @@ YY_RULE_SETUP
    }
 	YY_BREAK
 case 125:
-*yy_cp = (yy_hold_char); /* undo effects of setting up yytext */
-(yy_c_buf_p) = yy_cp -= 1;
+*yy_cp = yyg->yy_hold_char; /* undo effects of setting up yytext */
+yyg->yy_c_buf_p = yy_cp -= 1;
 YY_DO_BEFORE_ACTION; /* set up yytext again */
 YY_RULE_SETUP
 {
       QString text = QString::fromUtf8(yytext);
 
-      s_nospaces   = true;
-      s_roundCount = 0;
-      s_defArgsStr = text;
-      s_findDefArgContext = IncludeID;
+      s_ctx->nospaces   = true;
+      s_ctx->roundCount = 0;
+      s_ctx->defArgsStr = text;
+      s_ctx->findDefArgContext = IncludeID;
       BEGIN(FindDefineArgs);
    }
 	YY_BREAK
@@ -6873,7 +6974,7 @@ YY_RULE_SETUP
 {
       QString text = QString::fromUtf8(yytext);
 
-      s_nospaces = true;
+      s_ctx->nospaces = true;
       readIncludeFile(expandMacro(text));
       BEGIN(Start);
    }
@@ -6883,10 +6984,10 @@ YY_RULE_SETUP
 {
       QString text = QString::fromUtf8(yytext);
 
-      s_incName += text;
-      readIncludeFile(s_incName);
+      s_ctx->incName += text;
+      readIncludeFile(s_ctx->incName);
 
-      if (s_isImported) {
+      if (s_ctx->isImported) {
          BEGIN(EndImport);
       } else {
          BEGIN(Start);
@@ -6895,9 +6996,9 @@ YY_RULE_SETUP
 	YY_BREAK
 case 128:
 /* rule 128 can match eol */
-*yy_cp = (yy_hold_char); /* undo effects of setting up yytext */
+*yy_cp = yyg->yy_hold_char; /* undo effects of setting up yytext */
 YY_LINENO_REWIND_TO(yy_cp - 1);
-(yy_c_buf_p) = yy_cp -= 1;
+yyg->yy_c_buf_p = yy_cp -= 1;
 YY_DO_BEFORE_ACTION; /* set up yytext again */
 YY_RULE_SETUP
 {
@@ -6909,7 +7010,7 @@ case 129:
 YY_RULE_SETUP
 {
       outputChar('\n');
-      ++s_yyLineNr;
+      ++s_ctx->yyLineNr;
    }
 	YY_BREAK
 case 130:
@@ -6923,59 +7024,59 @@ YY_RULE_SETUP
 {
       // define with argument
 
-      s_argDict = QMakeShared<QHash<QString, int>>();
+      s_ctx->argDict = QMakeShared<QHash<QString, int>>();
 
-      s_defArgs = 0;
-      s_defArgsStr.resize(0);
-      s_defText.resize(0);
-      s_defLitText.resize(0);
+      s_ctx->defArgs = 0;
+      s_ctx->defArgsStr.resize(0);
+      s_ctx->defText.resize(0);
+      s_ctx->defLitText.resize(0);
 
-      s_defName    = QString::fromUtf8(yytext);
-      s_defVarArgs = false;
-      s_defExtraSpacing.resize(0);
+      s_ctx->defName    = QString::fromUtf8(yytext);
+      s_ctx->defVarArgs = false;
+      s_ctx->defExtraSpacing.resize(0);
       BEGIN(DefineArg);
    }
 	YY_BREAK
 case 132:
 /* rule 132 can match eol */
-*yy_cp = (yy_hold_char); /* undo effects of setting up yytext */
+*yy_cp = yyg->yy_hold_char; /* undo effects of setting up yytext */
 YY_LINENO_REWIND_TO(yy_cp - 1);
-(yy_c_buf_p) = yy_cp -= 1;
+yyg->yy_c_buf_p = yy_cp -= 1;
 YY_DO_BEFORE_ACTION; /* set up yytext again */
 YY_RULE_SETUP
 {
       // special case: define with 1 -> can be "guard"
 
-      s_argDict = QSharedPointer<QHash<QString, int>>();
+      s_ctx->argDict = QSharedPointer<QHash<QString, int>>();
 
-      s_defArgs = -1;
-      s_defArgsStr.resize(0);
+      s_ctx->defArgs = -1;
+      s_ctx->defArgsStr.resize(0);
 
-      s_defName = QString::fromUtf8(yytext);
-      s_defName = s_defName.left(s_defName.length() - 1).trimmed();
-      s_defVarArgs = false;
+      s_ctx->defName = QString::fromUtf8(yytext);
+      s_ctx->defName = s_ctx->defName.left(s_ctx->defName.length() - 1).trimmed();
+      s_ctx->defVarArgs = false;
 
-      if (s_curlyCount > 0 || s_defName != s_lastGuardName || ! s_expectGuard) {
+      if (s_ctx->curlyCount > 0 || s_ctx->defName != s_ctx->lastGuardName || ! s_ctx->expectGuard) {
          // define may appear in the output
-         QString tmp = "#define " + s_defName;
+         QString tmp = "#define " + s_ctx->defName;
          outputArray(tmp, tmp.length());
 
-         s_quoteArg      = false;
-         s_insideComment = false;
-         s_lastGuardName.resize(0);
-         s_defText    = "1";
-         s_defLitText = "1";
+         s_ctx->quoteArg      = false;
+         s_ctx->insideComment = false;
+         s_ctx->lastGuardName.resize(0);
+         s_ctx->defText    = "1";
+         s_ctx->defLitText = "1";
          BEGIN(DefineText);
 
       } else  {
          // define is a guard => hide
 
-         s_defText.resize(0);
-         s_defLitText.resize(0);
+         s_ctx->defText.resize(0);
+         s_ctx->defLitText.resize(0);
          BEGIN(Start);
       }
 
-      s_expectGuard = false;
+      s_ctx->expectGuard = false;
    }
 	YY_BREAK
 case 133:
@@ -6985,26 +7086,26 @@ YY_RULE_SETUP
       // empty define
       QString text = QString::fromUtf8(yytext);
 
-      s_argDict = QSharedPointer<QHash<QString, int>>();
+      s_ctx->argDict = QSharedPointer<QHash<QString, int>>();
 
-      s_defArgs = -1;
-      s_defName = text;
+      s_ctx->defArgs = -1;
+      s_ctx->defName = text;
 
-      s_defArgsStr.resize(0);
-      s_defText.resize(0);
-      s_defLitText.resize(0);
-      s_defVarArgs = false;
+      s_ctx->defArgsStr.resize(0);
+      s_ctx->defText.resize(0);
+      s_ctx->defLitText.resize(0);
+      s_ctx->defVarArgs = false;
 
-      if (s_curlyCount > 0 || s_defName != s_lastGuardName || ! s_expectGuard) {
+      if (s_ctx->curlyCount > 0 || s_ctx->defName != s_ctx->lastGuardName || ! s_ctx->expectGuard) {
          // define may appear in the output
-         QString tmp = "#define " + s_defName;
+         QString tmp = "#define " + s_ctx->defName;
          outputArray(tmp, tmp.length());
 
-         s_quoteArg      = false;
-         s_insideComment = false;
+         s_ctx->quoteArg      = false;
+         s_ctx->insideComment = false;
 
-         if (s_insideCS) {
-            s_defText="1"; // for C#, use "1" as define text
+         if (s_ctx->insideCS) {
+            s_ctx->defText="1"; // for C#, use "1" as define text
          }
 
          BEGIN(DefineText);
@@ -7012,12 +7113,12 @@ YY_RULE_SETUP
       } else  {
          // define is a guard => hide
 
-         s_guardName = text;
-         s_lastGuardName.resize(0);
+         s_ctx->guardName = text;
+         s_ctx->lastGuardName.resize(0);
          BEGIN(Start);
       }
 
-      s_expectGuard = false;
+      s_ctx->expectGuard = false;
    }
 	YY_BREAK
 case 134:
@@ -7026,21 +7127,21 @@ YY_RULE_SETUP
       // define with content
       QString text = QString::fromUtf8(yytext);
 
-      s_argDict = QSharedPointer<QHash<QString, int>>();
+      s_ctx->argDict = QSharedPointer<QHash<QString, int>>();
 
-      s_defArgs = -1;
-      s_defArgsStr.resize(0);
+      s_ctx->defArgs = -1;
+      s_ctx->defArgsStr.resize(0);
 
-      s_defText.resize(0);
-      s_defLitText.resize(0);
-      s_defName    = text;
-      s_defVarArgs = false;
+      s_ctx->defText.resize(0);
+      s_ctx->defLitText.resize(0);
+      s_ctx->defName    = text;
+      s_ctx->defVarArgs = false;
 
-      QString tmp = "#define " + s_defName + s_defArgsStr;
+      QString tmp = "#define " + s_ctx->defName + s_ctx->defArgsStr;
       outputArray(tmp, tmp.length());
 
-      s_quoteArg      = false;
-      s_insideComment = false;
+      s_ctx->quoteArg      = false;
+      s_ctx->insideComment = false;
       BEGIN(DefineText);
    }
 	YY_BREAK
@@ -7048,35 +7149,35 @@ case 135:
 /* rule 135 can match eol */
 YY_RULE_SETUP
 {
-      s_defExtraSpacing += "\n";
-      ++s_yyLineNr;
+      s_ctx->defExtraSpacing += "\n";
+      ++s_ctx->yyLineNr;
    }
 	YY_BREAK
 case 136:
 YY_RULE_SETUP
 {
       QString text = QString::fromUtf8(yytext);
-      s_defArgsStr += text;
+      s_ctx->defArgsStr += text;
    }
 	YY_BREAK
 case 137:
 YY_RULE_SETUP
 {
       QString text = QString::fromUtf8(yytext);
-      s_defArgsStr += text;
+      s_ctx->defArgsStr += text;
    }
 	YY_BREAK
 case 138:
 YY_RULE_SETUP
 {
       QString text = QString::fromUtf8(yytext);
-      s_defArgsStr += text;
+      s_ctx->defArgsStr += text;
 
-      QString tmp = "#define " + s_defName + s_defArgsStr + s_defExtraSpacing;
+      QString tmp = "#define " + s_ctx->defName + s_ctx->defArgsStr + s_ctx->defExtraSpacing;
       outputArray(tmp, tmp.length());
 
-      s_quoteArg      = false;
-      s_insideComment = false;
+      s_ctx->quoteArg      = false;
+      s_ctx->insideComment = false;
       BEGIN(DefineText);
    }
 	YY_BREAK
@@ -7084,43 +7185,43 @@ case 139:
 YY_RULE_SETUP
 {
       // Variadic macro
-      s_defVarArgs = true;
-      s_defArgsStr +=  QString::fromUtf8(yytext);
+      s_ctx->defVarArgs = true;
+      s_ctx->defArgsStr +=  QString::fromUtf8(yytext);
 
-      s_argDict->insert("__VA_ARGS__", s_defArgs);
-      ++s_defArgs;
+      s_ctx->argDict->insert("__VA_ARGS__", s_ctx->defArgs);
+      ++s_ctx->defArgs;
    }
 	YY_BREAK
 case 140:
 YY_RULE_SETUP
 {
       QString text = QString::fromUtf8(yytext);
-      s_defArgsStr += text;
+      s_ctx->defArgsStr += text;
 
-      s_defVarArgs = text.endsWith("...");
+      s_ctx->defVarArgs = text.endsWith("...");
 
-      if (s_defVarArgs)  {
+      if (s_ctx->defVarArgs)  {
          // strip ellipsis
          text = text.left(text.length() - 3);
       }
 
       text = text.trimmed();
 
-      s_argDict->insert(text, s_defArgs);
-      ++s_defArgs;
+      s_ctx->argDict->insert(text, s_ctx->defArgs);
+      ++s_ctx->defArgs;
    }
 	YY_BREAK
 /*
 <DefineText>"/ **"|"/ *!"  {
-      s_defText+=yytext;
-      s_defLitText+=yytext;
-      s_insideComment=true;
+      s_ctx->defText+=yytext;
+      s_ctx->defLitText+=yytext;
+      s_ctx->insideComment=true;
    }
 
 <DefineText>"* /"          {
-      s_defText+=yytext;
-      s_defLitText+=yytext;
-      s_insideComment=false;
+      s_ctx->defText+=yytext;
+      s_ctx->defLitText+=yytext;
+      s_ctx->insideComment=false;
    }
   */
 case 141:
@@ -7129,10 +7230,10 @@ YY_RULE_SETUP
       // */ (editor syntax fix)
        QString text = QString::fromUtf8(yytext);
 
-      s_defText   += text;
-      s_defLitText+= text;
-      s_lastCContext = YY_START;
-      s_commentCount = 1;
+      s_ctx->defText   += text;
+      s_ctx->defLitText+= text;
+      s_ctx->lastCContext = YY_START;
+      s_ctx->commentCount = 1;
       BEGIN(CopyCComment);
    }
 	YY_BREAK
@@ -7142,8 +7243,8 @@ YY_RULE_SETUP
       QString text = QString::fromUtf8(yytext);
       outputArray(text, text.length());
 
-      s_lastCPPContext  = YY_START;
-      s_defLitText     += ' ';
+      s_ctx->lastCPPContext  = YY_START;
+      s_ctx->defLitText     += ' ';
       BEGIN(SkipCPPComment);
    }
 	YY_BREAK
@@ -7159,16 +7260,16 @@ YY_RULE_SETUP
       outputChar('*');
       outputChar('/');
 
-      if (--s_commentCount <= 0) {
+      if (--s_ctx->commentCount <= 0) {
 
-         if (s_lastCContext == Start) {
+         if (s_ctx->lastCContext == Start) {
             // small hack to make sure that ^... rule will
             // match when going to Start... Example: "/*...*/ some stuff..."
 
             YY_CURRENT_BUFFER->yy_at_bol = 1;
          }
 
-         BEGIN(s_lastCContext);
+         BEGIN(s_ctx->lastCContext);
       }
    }
 	YY_BREAK
@@ -7186,7 +7287,7 @@ YY_RULE_SETUP
       outputChar('/');
       outputChar('*');
 
-      // ++s_commentCount;
+      // ++s_ctx->commentCount;
    }
 	YY_BREAK
 case 146:
@@ -7208,7 +7309,7 @@ YY_RULE_SETUP
          QString text = QString::fromUtf8(yytext);
          outputArray(text, text.length());
 
-         s_fenceSize = yyleng;
+         s_ctx->fenceSize = yyleng;
          BEGIN(SkipVerbatim);
       }
    }
@@ -7225,7 +7326,7 @@ YY_RULE_SETUP
          QString text = QString::fromUtf8(yytext);
          outputArray(text, text.length());
 
-         s_fenceSize = yyleng;
+         s_ctx->fenceSize = yyleng;
          BEGIN(SkipVerbatim);
       }
    }
@@ -7237,7 +7338,7 @@ YY_RULE_SETUP
       QString text = QString::fromUtf8(yytext);
 
       outputArray(text, text.length());
-      s_yyLineNr += text.count('\n');
+      s_ctx->yyLineNr += text.count('\n');
    }
 	YY_BREAK
 case 150:
@@ -7248,11 +7349,11 @@ YY_RULE_SETUP
 
       outputArray(text, text.length());
 
-      s_yyLineNr += text.count('\n');
-      s_fenceSize = 0;
+      s_ctx->yyLineNr += text.count('\n');
+      s_ctx->fenceSize = 0;
 
       if (text[1] == 'f') {
-         s_blockName = "f";
+         s_ctx->blockName = "f";
 
       } else {
          QString bn = text.mid(1);
@@ -7263,7 +7364,7 @@ YY_RULE_SETUP
             bn = bn.left(i);
          }
 
-         s_blockName = bn.trimmed();
+         s_ctx->blockName = bn.trimmed();
       }
       BEGIN(SkipVerbatim);
    }
@@ -7280,8 +7381,8 @@ case 152:
 YY_RULE_SETUP
 {
       // conditional section
-      s_ccomment = true;
-      s_condCtx  = YY_START;
+      s_ctx->ccomment = true;
+      s_ctx->condCtx  = YY_START;
       BEGIN(CondLineCpp);
    }
 	YY_BREAK
@@ -7289,8 +7390,8 @@ case 153:
 YY_RULE_SETUP
 {
       // conditional section
-      s_ccomment = false;
-      s_condCtx  = YY_START;
+      s_ctx->ccomment = false;
+      s_ctx->condCtx  = YY_START;
       BEGIN(CondLineC);
    }
 	YY_BREAK
@@ -7300,20 +7401,20 @@ YY_RULE_SETUP
       QString text = QString::fromUtf8(yytext);
       startCondSection(text);
 
-      if (s_skip) {
+      if (s_ctx->skip) {
          if (YY_START == CondLineC) {
             // end C comment
             outputArray("*/", 2);
-            s_ccomment = true;
+            s_ctx->ccomment = true;
 
          } else {
-            s_ccomment = false;
+            s_ctx->ccomment = false;
          }
 
          BEGIN(SkipCond);
 
       } else {
-         BEGIN(s_condCtx);
+         BEGIN(s_ctx->condCtx);
 
       }
    }
@@ -7325,42 +7426,42 @@ YY_RULE_SETUP
       unput(*yytext);
       startCondSection(" ");
 
-      if (s_skip) {
+      if (s_ctx->skip) {
          if (YY_START == CondLineC) {
             // end C comment
             outputArray("*/",2);
-            s_ccomment = true;
+            s_ctx->ccomment = true;
 
          } else {
-            s_ccomment = false;
+            s_ctx->ccomment = false;
          }
 
          BEGIN(SkipCond);
 
       } else {
-         BEGIN(s_condCtx);
+         BEGIN(s_ctx->condCtx);
       }
    }
 	YY_BREAK
 case 156:
 /* rule 156 can match eol */
-*yy_cp = (yy_hold_char); /* undo effects of setting up yytext */
+*yy_cp = yyg->yy_hold_char; /* undo effects of setting up yytext */
 YY_LINENO_REWIND_TO(yy_cp - 1);
-(yy_c_buf_p) = yy_cp -= 1;
+yyg->yy_c_buf_p = yy_cp -= 1;
 YY_DO_BEFORE_ACTION; /* set up yytext again */
 YY_RULE_SETUP
 {
       // no guard
       if (YY_START == SkipCComment) {
-         s_ccomment=true;
+         s_ctx->ccomment=true;
          // end C comment
          outputArray("*/",2);
 
       } else {
-         s_ccomment = false;
+         s_ctx->ccomment = false;
       }
 
-      s_condCtx = YY_START;
+      s_ctx->condCtx = YY_START;
       startCondSection(" ");
       BEGIN(SkipCond);
    }
@@ -7369,7 +7470,7 @@ case 157:
 /* rule 157 can match eol */
 YY_RULE_SETUP
 {
-      ++s_yyLineNr;
+      ++s_ctx->yyLineNr;
       outputChar('\n');
    }
 	YY_BREAK
@@ -7386,25 +7487,25 @@ YY_RULE_SETUP
 case 160:
 YY_RULE_SETUP
 {
-      s_ccomment = false;
+      s_ctx->ccomment = false;
    }
 	YY_BREAK
 case 161:
 YY_RULE_SETUP
 {
       // */ (editor syntax fix)
-      s_ccomment = true;
+      s_ctx->ccomment = true;
    }
 	YY_BREAK
 case 162:
 /* rule 162 can match eol */
-*yy_cp = (yy_hold_char); /* undo effects of setting up yytext */
+*yy_cp = yyg->yy_hold_char; /* undo effects of setting up yytext */
 YY_LINENO_REWIND_TO(yy_bp + 9);
-(yy_c_buf_p) = yy_cp = yy_bp + 9;
+yyg->yy_c_buf_p = yy_cp = yy_bp + 9;
 YY_DO_BEFORE_ACTION; /* set up yytext again */
 YY_RULE_SETUP
 {
-      if (! s_skip) {
+      if (! s_ctx->skip) {
          QString text = QString::fromUtf8(yytext);
          outputArray(text, text.length());
       }
@@ -7412,40 +7513,40 @@ YY_RULE_SETUP
 	YY_BREAK
 case 163:
 /* rule 163 can match eol */
-*yy_cp = (yy_hold_char); /* undo effects of setting up yytext */
+*yy_cp = yyg->yy_hold_char; /* undo effects of setting up yytext */
 YY_LINENO_REWIND_TO(yy_bp + 8);
-(yy_c_buf_p) = yy_cp = yy_bp + 8;
+yyg->yy_c_buf_p = yy_cp = yy_bp + 8;
 YY_DO_BEFORE_ACTION; /* set up yytext again */
 YY_RULE_SETUP
 {
-      bool oldSkip = s_skip;
+      bool oldSkip = s_ctx->skip;
       endCondSection();
 
-      if (oldSkip && ! s_skip) {
-         if (s_ccomment) {
+      if (oldSkip && ! s_ctx->skip) {
+         if (s_ctx->ccomment) {
             outputArray("/** ",4);
 
             // */ (editor syntax fix)
          }
 
-         BEGIN(s_condCtx);
+         BEGIN(s_ctx->condCtx);
       }
    }
 	YY_BREAK
 case 164:
 /* rule 164 can match eol */
-*yy_cp = (yy_hold_char); /* undo effects of setting up yytext */
+*yy_cp = yyg->yy_hold_char; /* undo effects of setting up yytext */
 YY_LINENO_REWIND_TO(yy_bp + 8);
-(yy_c_buf_p) = yy_cp = yy_bp + 8;
+yyg->yy_c_buf_p = yy_cp = yy_bp + 8;
 YY_DO_BEFORE_ACTION; /* set up yytext again */
 YY_RULE_SETUP
 {
       // */ (editor syntax fix)
-      bool oldSkip = s_skip;
+      bool oldSkip = s_ctx->skip;
       endCondSection();
 
-      if (oldSkip && ! s_skip)  {
-         BEGIN(s_condCtx);
+      if (oldSkip && ! s_ctx->skip)  {
+         BEGIN(s_ctx->condCtx);
       }
    }
 	YY_BREAK
@@ -7457,10 +7558,10 @@ YY_RULE_SETUP
       QString text = QString::fromUtf8(yytext);
       outputArray(text, text.length());
 
-      if (text[1] == 'f' && s_blockName == "f") {
+      if (text[1] == 'f' && s_ctx->blockName == "f") {
          BEGIN(SkipCComment);
 
-      } else if (text.mid(4) == s_blockName) {
+      } else if (text.mid(4) == s_ctx->blockName) {
          BEGIN(SkipCComment);
       }
    }
@@ -7471,7 +7572,7 @@ YY_RULE_SETUP
       QString text = QString::fromUtf8(yytext);
       outputArray(text, text.length());
 
-      if (s_fenceSize == yyleng) {
+      if (s_ctx->fenceSize == yyleng) {
          BEGIN(SkipCComment);
       }
    }
@@ -7482,7 +7583,7 @@ YY_RULE_SETUP
       QString text = QString::fromUtf8(yytext);
       outputArray(text, text.length());
 
-      if (s_fenceSize == yyleng) {
+      if (s_ctx->fenceSize == yyleng) {
          BEGIN(SkipCComment);
       }
    }
@@ -7506,7 +7607,7 @@ case 170:
 /* rule 170 can match eol */
 YY_RULE_SETUP
 {
-      ++s_yyLineNr;
+      ++s_ctx->yyLineNr;
       outputChar('\n');
    }
 	YY_BREAK
@@ -7522,8 +7623,8 @@ YY_RULE_SETUP
 {
       QString text = QString::fromUtf8(yytext);
 
-      s_defLitText += text;
-      s_defText    += escapeAt(text);
+      s_ctx->defLitText += text;
+      s_ctx->defText    += escapeAt(text);
    }
 	YY_BREAK
 case 173:
@@ -7531,11 +7632,11 @@ case 173:
 YY_RULE_SETUP
 {
       QString text = QString::fromUtf8(yytext);
-      s_defLitText += text;
+      s_ctx->defLitText += text;
 
-      s_defText += " ";
-      ++s_yyLineNr;
-      ++s_yyMLines;
+      s_ctx->defText += " ";
+      ++s_ctx->yyLineNr;
+      ++s_ctx->yyMLines;
    }
 	YY_BREAK
 case 174:
@@ -7543,9 +7644,9 @@ YY_RULE_SETUP
 {
       QString text = QString::fromUtf8(yytext);
 
-      s_defLitText += text;
-      s_defText    += text;
-      BEGIN(s_lastCContext);
+      s_ctx->defLitText += text;
+      s_ctx->defText    += text;
+      BEGIN(s_ctx->lastCContext);
    }
 	YY_BREAK
 case 175:
@@ -7554,10 +7655,10 @@ YY_RULE_SETUP
 {
       QString text = QString::fromUtf8(yytext);
 
-      ++s_yyLineNr;
+      ++s_ctx->yyLineNr;
 
-      s_defLitText += text;
-      s_defText    += ' ';
+      s_ctx->defLitText += text;
+      s_ctx->defText    += ' ';
 
       outputChar('\n');
    }
@@ -7566,7 +7667,7 @@ case 176:
 YY_RULE_SETUP
 {
       // see bug 594021 for a usecase for this rule
-      if (s_lastCContext == SkipCPPBlock) {
+      if (s_ctx->lastCContext == SkipCPPBlock) {
          BEGIN(SkipCommand);
 
       } else {
@@ -7577,7 +7678,7 @@ YY_RULE_SETUP
 case 177:
 YY_RULE_SETUP
 {
-      BEGIN(s_lastCContext);
+      BEGIN(s_ctx->lastCContext);
    }
 	YY_BREAK
 case 178:
@@ -7598,7 +7699,7 @@ YY_RULE_SETUP
 {
       // */ (editor syntax fix)
 
-      ++s_yyLineNr;
+      ++s_ctx->yyLineNr;
       outputChar('\n');
    }
 	YY_BREAK
@@ -7618,7 +7719,7 @@ case 184:
 YY_RULE_SETUP
 {
       unput(*yytext);
-      BEGIN(s_lastCPPContext);
+      BEGIN(s_ctx->lastCPPContext);
    }
 	YY_BREAK
 case 185:
@@ -7666,60 +7767,60 @@ YY_RULE_SETUP
 
 	YY_BREAK
 case 193:
-*yy_cp = (yy_hold_char); /* undo effects of setting up yytext */
-(yy_c_buf_p) = yy_cp = yy_bp + 1;
+*yy_cp = yyg->yy_hold_char; /* undo effects of setting up yytext */
+yyg->yy_c_buf_p = yy_cp = yy_bp + 1;
 YY_DO_BEFORE_ACTION; /* set up yytext again */
 YY_RULE_SETUP
 {
       // */ (editor syntax fix)
 
-      s_quoteArg   = true;
-      s_idStart    = true;
-      s_defLitText += QString::fromUtf8(yytext);
+      s_ctx->quoteArg   = true;
+      s_ctx->idStart    = true;
+      s_ctx->defLitText += QString::fromUtf8(yytext);
    }
 	YY_BREAK
 case 194:
 YY_RULE_SETUP
 {
       QString text = QString::fromUtf8(yytext);
-      s_defLitText += text;
+      s_ctx->defLitText += text;
 
-      if (s_quoteArg) {
-         s_defText+="\"";
+      if (s_ctx->quoteArg) {
+         s_ctx->defText+="\"";
       }
 
-      if (s_defArgs > 0) {
-         auto iter = s_argDict->find(text);
+      if (s_ctx->defArgs > 0) {
+         auto iter = s_ctx->argDict->find(text);
 
-         if (iter != s_argDict->end()) {
+         if (iter != s_ctx->argDict->end()) {
             int n = iter.value();
 
-            s_defText += '@';
+            s_ctx->defText += '@';
 
             QString numStr = QString("%1").formatArg(n);
-            s_defText += numStr;
+            s_ctx->defText += numStr;
 
          } else {
 
-            if (s_idStart) {
-               warn(s_yyFileName, s_yyLineNr, "# character must appear before a macro parameter %s: %s",
-                  csPrintable(s_defName), csPrintable(s_defLitText.trimmed()));
+            if (s_ctx->idStart) {
+               warn(s_ctx->yyFileName, s_ctx->yyLineNr, "# character must appear before a macro parameter %s: %s",
+                  csPrintable(s_ctx->defName), csPrintable(s_ctx->defLitText.trimmed()));
             }
 
-            s_defText += text;
+            s_ctx->defText += text;
 
          }
 
       } else {
-         s_defText += text;
+         s_ctx->defText += text;
       }
 
-      if (s_quoteArg) {
-         s_defText += "\"";
+      if (s_ctx->quoteArg) {
+         s_ctx->defText += "\"";
       }
 
-      s_quoteArg = false;
-      s_idStart  = false;
+      s_ctx->quoteArg = false;
+      s_ctx->idStart  = false;
    }
 	YY_BREAK
 case 195:
@@ -7727,8 +7828,8 @@ YY_RULE_SETUP
 {
       QString text = QString::fromUtf8(yytext);
 
-      s_defLitText += text;
-      s_defText    += text;
+      s_ctx->defLitText += text;
+      s_ctx->defText    += text;
    }
 	YY_BREAK
 case 196:
@@ -7737,11 +7838,11 @@ YY_RULE_SETUP
 {
       QString text = QString::fromUtf8(yytext);
 
-      s_defLitText += text;
+      s_ctx->defLitText += text;
       outputChar('\n');
-      s_defText += ' ';
-      ++s_yyLineNr;
-      ++s_yyMLines;
+      s_ctx->defText += ' ';
+      ++s_ctx->yyLineNr;
+      ++s_ctx->yyMLines;
    }
 	YY_BREAK
 case 197:
@@ -7750,43 +7851,43 @@ YY_RULE_SETUP
 {
       QString text = QString::fromUtf8(yytext);
 
-      QString comment = extractTrailingComment(s_defLitText);
-      s_defText = s_defText.trimmed();
+      QString comment = extractTrailingComment(s_ctx->defLitText);
+      s_ctx->defText = s_ctx->defText.trimmed();
 
-      if (s_defText.startsWith("##")) {
-         warn(s_yyFileName, s_yyLineNr, "## characters can not occur at the beginning of a macro definition %s: %s",
-             csPrintable(s_defName), csPrintable(s_defLitText.trimmed()));
+      if (s_ctx->defText.startsWith("##")) {
+         warn(s_ctx->yyFileName, s_ctx->yyLineNr, "## characters can not occur at the beginning of a macro definition %s: %s",
+             csPrintable(s_ctx->defName), csPrintable(s_ctx->defLitText.trimmed()));
 
-      } else if (s_defText.endsWith("##")) {
-         warn(s_yyFileName, s_yyLineNr, "## characters can not occur at the end of a macro definition %s: %s",
-             csPrintable(s_defName), csPrintable(s_defLitText.trimmed()));
+      } else if (s_ctx->defText.endsWith("##")) {
+         warn(s_ctx->yyFileName, s_ctx->yyLineNr, "## characters can not occur at the end of a macro definition %s: %s",
+             csPrintable(s_ctx->defName), csPrintable(s_ctx->defLitText.trimmed()));
 
-      } else if (s_defText.endsWith("#")) {
-         warn(s_yyFileName, s_yyLineNr, "Expected formal parameter after # character in macro definition %s: %s",
-             csPrintable(s_defName), csPrintable(s_defLitText.trimmed()));
+      } else if (s_ctx->defText.endsWith("#")) {
+         warn(s_ctx->yyFileName, s_ctx->yyLineNr, "Expected formal parameter after # character in macro definition %s: %s",
+             csPrintable(s_ctx->defName), csPrintable(s_ctx->defLitText.trimmed()));
       }
-      s_defLitText += text;
+      s_ctx->defLitText += text;
 
       if (! comment.isEmpty()) {
          outputArray(comment, comment.length());
-         s_defLitText = s_defLitText.left(s_defLitText.length() - comment.length() - 1);
+         s_ctx->defLitText = s_ctx->defLitText.left(s_ctx->defLitText.length() - comment.length() - 1);
       }
 
       outputChar('\n');
 
       QSharedPointer<A_Define> def;
 
-      if (s_includeStack.isEmpty() || s_curlyCount > 0) {
+      if (s_ctx->includeStack.isEmpty() || s_ctx->curlyCount > 0) {
          addDefine();
       }
 
-      def = DefineManager::instance().isDefined(s_defName);
+      def = DefineManager::instance().isDefined(s_ctx->contextDefines, s_ctx->defName);
 
       if (def == nullptr)  {
          // new define
 
          QSharedPointer<A_Define> nd = newDefine();
-         DefineManager::instance().addDefine(s_yyFileName, nd);
+         DefineManager::instance().addDefine(s_ctx->contextDefines, s_ctx->yyFileName, nd);
 
       } else if (def) {
          // name already exists
@@ -7794,20 +7895,20 @@ YY_RULE_SETUP
          if (def->undef) {
             // undefined name
             def->undef        = false;
-            def->m_name       = s_defName;
-            def->m_definition = s_defText.trimmed();
-            def->nargs        = s_defArgs;
-            def->m_fileName   = s_yyFileName;
-            def->lineNr       = s_yyLineNr - s_yyMLines;
-            def->columnNr     = s_yyColNr;
+            def->m_name       = s_ctx->defName;
+            def->m_definition = s_ctx->defText.trimmed();
+            def->nargs        = s_ctx->defArgs;
+            def->m_fileName   = s_ctx->yyFileName;
+            def->lineNr       = s_ctx->yyLineNr - s_ctx->yyMLines;
+            def->columnNr     = s_ctx->yyColNr;
          }
       }
 
-      s_argDict = QSharedPointer<QHash<QString, int>>();
+      s_ctx->argDict = QSharedPointer<QHash<QString, int>>();
 
-      ++s_yyLineNr;
-      s_yyColNr = 1;
-      s_lastGuardName.resize(0);
+      ++s_ctx->yyLineNr;
+      s_ctx->yyColNr = 1;
+      s_ctx->lastGuardName.resize(0);
       BEGIN(Start);
    }
 	YY_BREAK
@@ -7815,24 +7916,24 @@ case 198:
 YY_RULE_SETUP
 {
       QString text = QString::fromUtf8(yytext);
-      s_defText    += ' ';
-      s_defLitText += text;
+      s_ctx->defText    += ' ';
+      s_ctx->defLitText += text;
    }
 	YY_BREAK
 case 199:
 YY_RULE_SETUP
 {
       QString text = QString::fromUtf8(yytext);
-      s_defText    += "##";
-      s_defLitText += text;
+      s_ctx->defText    += "##";
+      s_ctx->defLitText += text;
    }
 	YY_BREAK
 case 200:
 YY_RULE_SETUP
 {
       QString text = QString::fromUtf8(yytext);
-      s_defText     += "@@";
-      s_defLitText  += text;
+      s_ctx->defText     += "@@";
+      s_ctx->defLitText  += text;
    }
 	YY_BREAK
 case 201:
@@ -7840,10 +7941,10 @@ YY_RULE_SETUP
 {
       QString text = QString::fromUtf8(yytext);
 
-      s_defText    += text[0];
-      s_defLitText += text;
+      s_ctx->defText    += text[0];
+      s_ctx->defLitText += text;
 
-      if (! s_insideComment) {
+      if (! s_ctx->insideComment) {
          BEGIN(SkipDoubleQuote);
       }
    }
@@ -7853,10 +7954,10 @@ YY_RULE_SETUP
 {
       QString text = QString::fromUtf8(yytext);
 
-      s_defText    += text[0];
-      s_defLitText += text;
+      s_ctx->defText    += text[0];
+      s_ctx->defLitText += text;
 
-      if (! s_insideComment) {
+      if (! s_ctx->insideComment) {
          BEGIN(SkipSingleQuote);
       }
    }
@@ -7866,8 +7967,8 @@ YY_RULE_SETUP
 {
       QString text = QString::fromUtf8(yytext);
 
-      s_defText    += text;
-      s_defLitText += text;
+      s_ctx->defText    += text;
+      s_ctx->defLitText += text;
    }
 	YY_BREAK
 case 204:
@@ -7876,8 +7977,8 @@ YY_RULE_SETUP
       // */ (editor syntax fix)
       QString text = QString::fromUtf8(yytext);
 
-      s_defText    += text;
-      s_defLitText += text;
+      s_ctx->defText    += text;
+      s_ctx->defLitText += text;
    }
 	YY_BREAK
 case 205:
@@ -7885,8 +7986,8 @@ YY_RULE_SETUP
 {
       QString text = QString::fromUtf8(yytext);
 
-      s_defText    += text[0];
-      s_defLitText += text;
+      s_ctx->defText    += text[0];
+      s_ctx->defLitText += text;
       BEGIN(DefineText);
    }
 	YY_BREAK
@@ -7895,8 +7996,8 @@ YY_RULE_SETUP
 {
      QString text = QString::fromUtf8(yytext);
 
-      s_defText    += text;
-      s_defLitText += text;
+      s_ctx->defText    += text;
+      s_ctx->defLitText += text;
    }
 	YY_BREAK
 case 207:
@@ -7904,8 +8005,8 @@ YY_RULE_SETUP
 {
       QString text = QString::fromUtf8(yytext);
 
-      s_defText    += text[0];
-      s_defLitText += text;
+      s_ctx->defText    += text[0];
+      s_ctx->defLitText += text;
       BEGIN(DefineText);
    }
 	YY_BREAK
@@ -7914,8 +8015,8 @@ YY_RULE_SETUP
 {
       QString text = QString::fromUtf8(yytext);
 
-      s_defText    += text[0];
-      s_defLitText += text;
+      s_ctx->defText    += text[0];
+      s_ctx->defLitText += text;
    }
 	YY_BREAK
 case 209:
@@ -7923,8 +8024,8 @@ YY_RULE_SETUP
 {
       QString text = QString::fromUtf8(yytext);
 
-      s_defText    += text[0];
-      s_defLitText += text;
+      s_ctx->defText    += text[0];
+      s_ctx->defLitText += text;
    }
 	YY_BREAK
 case 210:
@@ -7932,8 +8033,8 @@ YY_RULE_SETUP
 {
       QString text = QString::fromUtf8(yytext);
 
-      s_defText    += text[0];
-      s_defLitText += text;
+      s_ctx->defText    += text[0];
+      s_ctx->defLitText += text;
    }
 	YY_BREAK
 case YY_STATE_EOF(INITIAL):
@@ -7979,36 +8080,38 @@ case YY_STATE_EOF(SkipCond):
 {
       DBG_CTX((stderr, "End of include file\n"));
 
-      if (s_includeStack.isEmpty()) {
+      DefineManager::instance().fileFinished(s_ctx->yyFileName);
+
+      if (s_ctx->includeStack.isEmpty()) {
          DBG_CTX((stderr, "Terminating scanner\n"));
          yyterminate();
 
       } else {
-         QSharedPointer<FileState> fs = s_includeStack.pop();
+         QSharedPointer<FileState> fs = s_ctx->includeStack.pop();
 
          YY_BUFFER_STATE oldBuf = YY_CURRENT_BUFFER;
-         preYY_switch_to_buffer(fs->bufState );
-         preYY_delete_buffer(oldBuf );
+         preYY_switch_to_buffer(fs->bufState, yyscanner);
+         preYY_delete_buffer(oldBuf, yyscanner);
 
-         s_yyLineNr      = fs->lineNr;
-         s_inputString   = fs->oldFileBuf;
-         s_inputPosition = fs->oldFileBufPos;
-         s_curlyCount    = fs->curlyCount;
+         s_ctx->yyLineNr      = fs->lineNr;
+         s_ctx->inputString   = fs->oldFileBuf;
+         s_ctx->inputPosition = fs->oldFileBufPos;
+         s_ctx->curlyCount    = fs->curlyCount;
          setFileName(fs->fileName);
 
-         DBG_CTX((stderr, "######## FileName %s\n", csPrintable(s_yyFileName)));
+         DBG_CTX((stderr, "######## FileName %s\n", csPrintable(s_ctx->yyFileName)));
 
          // deal with file changes due to
          // #include's within { .. } blocks
 
-         QString lineStr = QString("# %1 \"%2\" 2").formatArg(s_yyLineNr).formatArg(QString(s_yyFileName));
+         QString lineStr = QString("# %1 \"%2\" 2").formatArg(s_ctx->yyLineNr).formatArg(QString(s_ctx->yyFileName));
          outputArray(lineStr, lineStr.length());
       }
    }
 	YY_BREAK
 case 211:
-*yy_cp = (yy_hold_char); /* undo effects of setting up yytext */
-(yy_c_buf_p) = yy_cp = yy_bp + 2;
+*yy_cp = yyg->yy_hold_char; /* undo effects of setting up yytext */
+yyg->yy_c_buf_p = yy_cp = yy_bp + 2;
 YY_DO_BEFORE_ACTION; /* set up yytext again */
 case 212:
 YY_RULE_SETUP
@@ -8022,11 +8125,11 @@ YY_RULE_SETUP
          QString text = QString::fromUtf8(yytext);
          outputArray(text, text.length());
 
-         s_lastCContext = YY_START;
-         s_commentCount = 1;
+         s_ctx->lastCContext = YY_START;
+         s_ctx->commentCount = 1;
 
          if (yyleng == 3) {
-            s_lastGuardName.resize(0); // reset guard in case the #define is documented
+            s_ctx->lastGuardName.resize(0); // reset guard in case the #define is documented
          }
 
          BEGIN(SkipCComment);
@@ -8036,17 +8139,17 @@ YY_RULE_SETUP
 case 213:
 YY_RULE_SETUP
 {
-      if (YY_START == SkipVerbatim || YY_START == SkipCond || getLanguageFromFileName(s_yyFileName) == SrcLangExt_Fortran) {
+      if (YY_START == SkipVerbatim || YY_START == SkipCond || getLanguageFromFileName(s_ctx->yyFileName) == SrcLangExt_Fortran) {
          REJECT;
 
       } else {
          QString text = QString::fromUtf8(yytext);
          outputArray(text, text.length());
 
-         s_lastCPPContext = YY_START;
+         s_ctx->lastCPPContext = YY_START;
 
          if (yyleng == 3) {
-            s_lastGuardName.resize(0); // reset guard in case the #define is documented
+            s_ctx->lastGuardName.resize(0); // reset guard in case the #define is documented
          }
 
          BEGIN(SkipCPPComment);
@@ -8058,7 +8161,7 @@ case 214:
 YY_RULE_SETUP
 {
       outputChar('\n');
-      ++s_yyLineNr;
+      ++s_ctx->yyLineNr;
    }
 	YY_BREAK
 case 215:
@@ -8066,7 +8169,7 @@ YY_RULE_SETUP
 {
       // utf-8 code point
       QString text  = QString::fromUtf8(yytext);
-      s_expectGuard = false;
+      s_ctx->expectGuard = false;
 
       for (QChar c : text) {
          outputChar(c);
@@ -8078,7 +8181,7 @@ YY_RULE_SETUP
 {
       // catch all
       QString text  = QString::fromUtf8(yytext);
-      s_expectGuard = false;
+      s_ctx->expectGuard = false;
 
       for (QChar c : text) {
          outputChar(c);
@@ -8093,10 +8196,10 @@ ECHO;
 	case YY_END_OF_BUFFER:
 		{
 		/* Amount of text matched not including the EOB char. */
-		int yy_amount_of_matched_text = (int) (yy_cp - (yytext_ptr)) - 1;
+		int yy_amount_of_matched_text = (int) (yy_cp - yyg->yytext_ptr) - 1;
 
 		/* Undo the effects of YY_DO_BEFORE_ACTION. */
-		*yy_cp = (yy_hold_char);
+		*yy_cp = yyg->yy_hold_char;
 		YY_RESTORE_YY_MORE_OFFSET
 
 		if ( YY_CURRENT_BUFFER_LVALUE->yy_buffer_status == YY_BUFFER_NEW )
@@ -8110,7 +8213,7 @@ ECHO;
 			 * this is the first action (other than possibly a
 			 * back-up) that will match for the new input source.
 			 */
-			(yy_n_chars) = YY_CURRENT_BUFFER_LVALUE->yy_n_chars;
+			yyg->yy_n_chars = YY_CURRENT_BUFFER_LVALUE->yy_n_chars;
 			YY_CURRENT_BUFFER_LVALUE->yy_input_file = yyin;
 			YY_CURRENT_BUFFER_LVALUE->yy_buffer_status = YY_BUFFER_NORMAL;
 			}
@@ -8122,13 +8225,13 @@ ECHO;
 		 * end-of-buffer state).  Contrast this with the test
 		 * in input().
 		 */
-		if ( (yy_c_buf_p) <= &YY_CURRENT_BUFFER_LVALUE->yy_ch_buf[(yy_n_chars)] )
+		if ( yyg->yy_c_buf_p <= &YY_CURRENT_BUFFER_LVALUE->yy_ch_buf[yyg->yy_n_chars] )
 			{ /* This was really a NUL. */
 			yy_state_type yy_next_state;
 
-			(yy_c_buf_p) = (yytext_ptr) + yy_amount_of_matched_text;
+			yyg->yy_c_buf_p = yyg->yytext_ptr + yy_amount_of_matched_text;
 
-			yy_current_state = yy_get_previous_state(  );
+			yy_current_state = yy_get_previous_state( yyscanner );
 
 			/* Okay, we're now positioned to make the NUL
 			 * transition.  We couldn't have
@@ -8139,32 +8242,32 @@ ECHO;
 			 * will run more slowly).
 			 */
 
-			yy_next_state = yy_try_NUL_trans( yy_current_state );
+			yy_next_state = yy_try_NUL_trans( yy_current_state , yyscanner);
 
-			yy_bp = (yytext_ptr) + YY_MORE_ADJ;
+			yy_bp = yyg->yytext_ptr + YY_MORE_ADJ;
 
 			if ( yy_next_state )
 				{
 				/* Consume the NUL. */
-				yy_cp = ++(yy_c_buf_p);
+				yy_cp = ++yyg->yy_c_buf_p;
 				yy_current_state = yy_next_state;
 				goto yy_match;
 				}
 
 			else
 				{
-				yy_cp = (yy_c_buf_p);
+				yy_cp = yyg->yy_c_buf_p;
 				goto yy_find_action;
 				}
 			}
 
-		else switch ( yy_get_next_buffer(  ) )
+		else switch ( yy_get_next_buffer( yyscanner ) )
 			{
 			case EOB_ACT_END_OF_FILE:
 				{
-				(yy_did_buffer_switch_on_eof) = 0;
+				yyg->yy_did_buffer_switch_on_eof = 0;
 
-				if ( yywrap(  ) )
+				if ( yywrap( yyscanner ) )
 					{
 					/* Note: because we've taken care in
 					 * yy_get_next_buffer() to have set up
@@ -8175,7 +8278,7 @@ ECHO;
 					 * YY_NULL, it'll still work - another
 					 * YY_NULL will get returned.
 					 */
-					(yy_c_buf_p) = (yytext_ptr) + YY_MORE_ADJ;
+					yyg->yy_c_buf_p = yyg->yytext_ptr + YY_MORE_ADJ;
 
 					yy_act = YY_STATE_EOF(YY_START);
 					goto do_action;
@@ -8183,30 +8286,30 @@ ECHO;
 
 				else
 					{
-					if ( ! (yy_did_buffer_switch_on_eof) )
+					if ( ! yyg->yy_did_buffer_switch_on_eof )
 						YY_NEW_FILE;
 					}
 				break;
 				}
 
 			case EOB_ACT_CONTINUE_SCAN:
-				(yy_c_buf_p) =
-					(yytext_ptr) + yy_amount_of_matched_text;
+				yyg->yy_c_buf_p =
+					yyg->yytext_ptr + yy_amount_of_matched_text;
 
-				yy_current_state = yy_get_previous_state(  );
+				yy_current_state = yy_get_previous_state( yyscanner );
 
-				yy_cp = (yy_c_buf_p);
-				yy_bp = (yytext_ptr) + YY_MORE_ADJ;
+				yy_cp = yyg->yy_c_buf_p;
+				yy_bp = yyg->yytext_ptr + YY_MORE_ADJ;
 				goto yy_match;
 
 			case EOB_ACT_LAST_MATCH:
-				(yy_c_buf_p) =
-				&YY_CURRENT_BUFFER_LVALUE->yy_ch_buf[(yy_n_chars)];
+				yyg->yy_c_buf_p =
+				&YY_CURRENT_BUFFER_LVALUE->yy_ch_buf[yyg->yy_n_chars];
 
-				yy_current_state = yy_get_previous_state(  );
+				yy_current_state = yy_get_previous_state( yyscanner );
 
-				yy_cp = (yy_c_buf_p);
-				yy_bp = (yytext_ptr) + YY_MORE_ADJ;
+				yy_cp = yyg->yy_c_buf_p;
+				yy_bp = yyg->yytext_ptr + YY_MORE_ADJ;
 				goto yy_find_action;
 			}
 		break;
@@ -8227,20 +8330,21 @@ ECHO;
  *	EOB_ACT_CONTINUE_SCAN - continue scanning from current position
  *	EOB_ACT_END_OF_FILE - end of file
  */
-static int yy_get_next_buffer (void)
+static int yy_get_next_buffer (yyscan_t yyscanner)
 {
-    	char *dest = YY_CURRENT_BUFFER_LVALUE->yy_ch_buf;
-	char *source = (yytext_ptr);
+    struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
+	char *dest = YY_CURRENT_BUFFER_LVALUE->yy_ch_buf;
+	char *source = yyg->yytext_ptr;
 	int number_to_move, i;
 	int ret_val;
 
-	if ( (yy_c_buf_p) > &YY_CURRENT_BUFFER_LVALUE->yy_ch_buf[(yy_n_chars) + 1] )
+	if ( yyg->yy_c_buf_p > &YY_CURRENT_BUFFER_LVALUE->yy_ch_buf[yyg->yy_n_chars + 1] )
 		YY_FATAL_ERROR(
 		"fatal flex scanner internal error--end of buffer missed" );
 
 	if ( YY_CURRENT_BUFFER_LVALUE->yy_fill_buffer == 0 )
 		{ /* Don't try to fill the buffer, so this is an EOF. */
-		if ( (yy_c_buf_p) - (yytext_ptr) - YY_MORE_ADJ == 1 )
+		if ( yyg->yy_c_buf_p - yyg->yytext_ptr - YY_MORE_ADJ == 1 )
 			{
 			/* We matched a single character, the EOB, so
 			 * treat this as a final EOF.
@@ -8260,7 +8364,7 @@ static int yy_get_next_buffer (void)
 	/* Try to read more data. */
 
 	/* First move last chars to start of buffer. */
-	number_to_move = (int) ((yy_c_buf_p) - (yytext_ptr) - 1);
+	number_to_move = (int) (yyg->yy_c_buf_p - yyg->yytext_ptr - 1);
 
 	for ( i = 0; i < number_to_move; ++i )
 		*(dest++) = *(source++);
@@ -8269,7 +8373,7 @@ static int yy_get_next_buffer (void)
 		/* don't do the read, it's not guaranteed to return an EOF,
 		 * just force an EOF
 		 */
-		YY_CURRENT_BUFFER_LVALUE->yy_n_chars = (yy_n_chars) = 0;
+		YY_CURRENT_BUFFER_LVALUE->yy_n_chars = yyg->yy_n_chars = 0;
 
 	else
 		{
@@ -8289,17 +8393,17 @@ static int yy_get_next_buffer (void)
 
 		/* Read in more data. */
 		YY_INPUT( (&YY_CURRENT_BUFFER_LVALUE->yy_ch_buf[number_to_move]),
-			(yy_n_chars), num_to_read );
+			yyg->yy_n_chars, num_to_read );
 
-		YY_CURRENT_BUFFER_LVALUE->yy_n_chars = (yy_n_chars);
+		YY_CURRENT_BUFFER_LVALUE->yy_n_chars = yyg->yy_n_chars;
 		}
 
-	if ( (yy_n_chars) == 0 )
+	if ( yyg->yy_n_chars == 0 )
 		{
 		if ( number_to_move == YY_MORE_ADJ )
 			{
 			ret_val = EOB_ACT_END_OF_FILE;
-			yyrestart( yyin  );
+			yyrestart( yyin  , yyscanner);
 			}
 
 		else
@@ -8313,40 +8417,41 @@ static int yy_get_next_buffer (void)
 	else
 		ret_val = EOB_ACT_CONTINUE_SCAN;
 
-	if (((yy_n_chars) + number_to_move) > YY_CURRENT_BUFFER_LVALUE->yy_buf_size) {
+	if ((yyg->yy_n_chars + number_to_move) > YY_CURRENT_BUFFER_LVALUE->yy_buf_size) {
 		/* Extend the array by 50%, plus the number we really need. */
-		int new_size = (yy_n_chars) + number_to_move + ((yy_n_chars) >> 1);
+		int new_size = yyg->yy_n_chars + number_to_move + (yyg->yy_n_chars >> 1);
 		YY_CURRENT_BUFFER_LVALUE->yy_ch_buf = (char *) yyrealloc(
-			(void *) YY_CURRENT_BUFFER_LVALUE->yy_ch_buf, (yy_size_t) new_size  );
+			(void *) YY_CURRENT_BUFFER_LVALUE->yy_ch_buf, (yy_size_t) new_size , yyscanner );
 		if ( ! YY_CURRENT_BUFFER_LVALUE->yy_ch_buf )
 			YY_FATAL_ERROR( "out of dynamic memory in yy_get_next_buffer()" );
 		/* "- 2" to take care of EOB's */
 		YY_CURRENT_BUFFER_LVALUE->yy_buf_size = (int) (new_size - 2);
 	}
 
-	(yy_n_chars) += number_to_move;
-	YY_CURRENT_BUFFER_LVALUE->yy_ch_buf[(yy_n_chars)] = YY_END_OF_BUFFER_CHAR;
-	YY_CURRENT_BUFFER_LVALUE->yy_ch_buf[(yy_n_chars) + 1] = YY_END_OF_BUFFER_CHAR;
+	yyg->yy_n_chars += number_to_move;
+	YY_CURRENT_BUFFER_LVALUE->yy_ch_buf[yyg->yy_n_chars] = YY_END_OF_BUFFER_CHAR;
+	YY_CURRENT_BUFFER_LVALUE->yy_ch_buf[yyg->yy_n_chars + 1] = YY_END_OF_BUFFER_CHAR;
 
-	(yytext_ptr) = &YY_CURRENT_BUFFER_LVALUE->yy_ch_buf[0];
+	yyg->yytext_ptr = &YY_CURRENT_BUFFER_LVALUE->yy_ch_buf[0];
 
 	return ret_val;
 }
 
 /* yy_get_previous_state - get the state just before the EOB char was reached */
 
-    static yy_state_type yy_get_previous_state (void)
+    static yy_state_type yy_get_previous_state (yyscan_t yyscanner)
 {
 	yy_state_type yy_current_state;
 	char *yy_cp;
-    
-	yy_current_state = (yy_start);
+    struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
+
+	yy_current_state = yyg->yy_start;
 	yy_current_state += YY_AT_BOL();
 
-	(yy_state_ptr) = (yy_state_buf);
-	*(yy_state_ptr)++ = yy_current_state;
+	yyg->yy_state_ptr = yyg->yy_state_buf;
+	*yyg->yy_state_ptr++ = yy_current_state;
 
-	for ( yy_cp = (yytext_ptr) + YY_MORE_ADJ; yy_cp < (yy_c_buf_p); ++yy_cp )
+	for ( yy_cp = yyg->yytext_ptr + YY_MORE_ADJ; yy_cp < yyg->yy_c_buf_p; ++yy_cp )
 		{
 		YY_CHAR yy_c = (*yy_cp ? yy_ec[YY_SC_TO_UI(*yy_cp)] : 86);
 		while ( yy_chk[yy_base[yy_current_state] + yy_c] != yy_current_state )
@@ -8356,7 +8461,7 @@ static int yy_get_next_buffer (void)
 				yy_c = yy_meta[yy_c];
 			}
 		yy_current_state = yy_nxt[yy_base[yy_current_state] + yy_c];
-		*(yy_state_ptr)++ = yy_current_state;
+		*yyg->yy_state_ptr++ = yy_current_state;
 		}
 
 	return yy_current_state;
@@ -8367,10 +8472,10 @@ static int yy_get_next_buffer (void)
  * synopsis
  *	next_state = yy_try_NUL_trans( current_state );
  */
-    static yy_state_type yy_try_NUL_trans  (yy_state_type yy_current_state )
+    static yy_state_type yy_try_NUL_trans  (yy_state_type yy_current_state , yyscan_t yyscanner)
 {
 	int yy_is_jam;
-    
+    struct yyguts_t * yyg = (struct yyguts_t*)yyscanner; /* This var may be unused depending upon options. */
 	YY_CHAR yy_c = 86;
 	while ( yy_chk[yy_base[yy_current_state] + yy_c] != yy_current_state )
 		{
@@ -8381,26 +8486,28 @@ static int yy_get_next_buffer (void)
 	yy_current_state = yy_nxt[yy_base[yy_current_state] + yy_c];
 	yy_is_jam = (yy_current_state == 1443);
 	if ( ! yy_is_jam )
-		*(yy_state_ptr)++ = yy_current_state;
+		*yyg->yy_state_ptr++ = yy_current_state;
 
-		return yy_is_jam ? 0 : yy_current_state;
+	(void)yyg;
+	return yy_is_jam ? 0 : yy_current_state;
 }
 
 #ifndef YY_NO_UNPUT
 
-    static void yyunput (int c, char * yy_bp )
+    static void yyunput (int c, char * yy_bp , yyscan_t yyscanner)
 {
 	char *yy_cp;
-    
-    yy_cp = (yy_c_buf_p);
+    struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
+
+    yy_cp = yyg->yy_c_buf_p;
 
 	/* undo effects of setting up yytext */
-	*yy_cp = (yy_hold_char);
+	*yy_cp = yyg->yy_hold_char;
 
 	if ( yy_cp < YY_CURRENT_BUFFER_LVALUE->yy_ch_buf + 2 )
 		{ /* need to shift things up to make room */
 		/* +2 for EOB chars. */
-		int number_to_move = (yy_n_chars) + 2;
+		int number_to_move = yyg->yy_n_chars + 2;
 		char *dest = &YY_CURRENT_BUFFER_LVALUE->yy_ch_buf[
 					YY_CURRENT_BUFFER_LVALUE->yy_buf_size + 2];
 		char *source =
@@ -8412,7 +8519,7 @@ static int yy_get_next_buffer (void)
 		yy_cp += (int) (dest - source);
 		yy_bp += (int) (dest - source);
 		YY_CURRENT_BUFFER_LVALUE->yy_n_chars =
-			(yy_n_chars) = (int) YY_CURRENT_BUFFER_LVALUE->yy_buf_size;
+			yyg->yy_n_chars = (int) YY_CURRENT_BUFFER_LVALUE->yy_buf_size;
 
 		if ( yy_cp < YY_CURRENT_BUFFER_LVALUE->yy_ch_buf + 2 )
 			YY_FATAL_ERROR( "flex scanner push-back overflow" );
@@ -8420,41 +8527,42 @@ static int yy_get_next_buffer (void)
 
 	*--yy_cp = (char) c;
 
-	(yytext_ptr) = yy_bp;
-	(yy_hold_char) = *yy_cp;
-	(yy_c_buf_p) = yy_cp;
+	yyg->yytext_ptr = yy_bp;
+	yyg->yy_hold_char = *yy_cp;
+	yyg->yy_c_buf_p = yy_cp;
 }
 
 #endif
 
 #ifndef YY_NO_INPUT
 #ifdef __cplusplus
-    static int yyinput (void)
+    static int yyinput (yyscan_t yyscanner)
 #else
-    static int input  (void)
+    static int input  (yyscan_t yyscanner)
 #endif
 
 {
 	int c;
-    
-	*(yy_c_buf_p) = (yy_hold_char);
+    struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
+
+	*yyg->yy_c_buf_p = yyg->yy_hold_char;
 
-	if ( *(yy_c_buf_p) == YY_END_OF_BUFFER_CHAR )
+	if ( *yyg->yy_c_buf_p == YY_END_OF_BUFFER_CHAR )
 		{
 		/* yy_c_buf_p now points to the character we want to return.
 		 * If this occurs *before* the EOB characters, then it's a
 		 * valid NUL; if not, then we've hit the end of the buffer.
 		 */
-		if ( (yy_c_buf_p) < &YY_CURRENT_BUFFER_LVALUE->yy_ch_buf[(yy_n_chars)] )
+		if ( yyg->yy_c_buf_p < &YY_CURRENT_BUFFER_LVALUE->yy_ch_buf[yyg->yy_n_chars] )
 			/* This was really a NUL. */
-			*(yy_c_buf_p) = '\0';
+			*yyg->yy_c_buf_p = '\0';
 
 		else
 			{ /* need more input */
-			int offset = (int) ((yy_c_buf_p) - (yytext_ptr));
-			++(yy_c_buf_p);
+			int offset = (int) (yyg->yy_c_buf_p - yyg->yytext_ptr);
+			++yyg->yy_c_buf_p;
 
-			switch ( yy_get_next_buffer(  ) )
+			switch ( yy_get_next_buffer( yyscanner ) )
 				{
 				case EOB_ACT_LAST_MATCH:
 					/* This happens because yy_g_n_b()
@@ -8468,34 +8576,34 @@ static int yy_get_next_buffer (void)
 					 */
 
 					/* Reset buffer status. */
-					yyrestart( yyin );
+					yyrestart( yyin , yyscanner);
 
 					/*FALLTHROUGH*/
 
 				case EOB_ACT_END_OF_FILE:
 					{
-					if ( yywrap(  ) )
+					if ( yywrap( yyscanner ) )
 						return 0;
 
-					if ( ! (yy_did_buffer_switch_on_eof) )
+					if ( ! yyg->yy_did_buffer_switch_on_eof )
 						YY_NEW_FILE;
 #ifdef __cplusplus
-					return yyinput();
+					return yyinput(yyscanner);
 #else
-					return input();
+					return input(yyscanner);
 #endif
 					}
 
 				case EOB_ACT_CONTINUE_SCAN:
-					(yy_c_buf_p) = (yytext_ptr) + offset;
+					yyg->yy_c_buf_p = yyg->yytext_ptr + offset;
 					break;
 				}
 			}
 		}
 
-	c = *(unsigned char *) (yy_c_buf_p);	/* cast for 8-bit char's */
-	*(yy_c_buf_p) = '\0';	/* preserve yytext */
-	(yy_hold_char) = *++(yy_c_buf_p);
+	c = *(unsigned char *) yyg->yy_c_buf_p;	/* cast for 8-bit char's */
+	*yyg->yy_c_buf_p = '\0';	/* preserve yytext */
+	yyg->yy_hold_char = *++yyg->yy_c_buf_p;
 
 	YY_CURRENT_BUFFER_LVALUE->yy_at_bol = (c == '\n');
 
@@ -8508,60 +8616,63 @@ static int yy_get_next_buffer (void)
  * 
  * @note This function does not reset the start condition to @c INITIAL .
  */
-    void yyrestart  (FILE * input_file )
+    void yyrestart  (FILE * input_file , yyscan_t yyscanner)
 {
-    
+    struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
+
 	if ( ! YY_CURRENT_BUFFER ){
-        yyensure_buffer_stack ();
+        yyensure_buffer_stack (yyscanner);
 		YY_CURRENT_BUFFER_LVALUE =
-            yy_create_buffer( yyin, YY_BUF_SIZE );
+            yy_create_buffer( yyin, YY_BUF_SIZE , yyscanner);
 	}
 
-	yy_init_buffer( YY_CURRENT_BUFFER, input_file );
-	yy_load_buffer_state(  );
+	yy_init_buffer( YY_CURRENT_BUFFER, input_file , yyscanner);
+	yy_load_buffer_state( yyscanner );
 }
 
 /** Switch to a different input buffer.
  * @param new_buffer The new input buffer.
  * 
  */
-    void yy_switch_to_buffer  (YY_BUFFER_STATE  new_buffer )
+    void yy_switch_to_buffer  (YY_BUFFER_STATE  new_buffer , yyscan_t yyscanner)
 {
-    
+    struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
+
 	/* TODO. We should be able to replace this entire function body
 	 * with
 	 *		yypop_buffer_state();
 	 *		yypush_buffer_state(new_buffer);
      */
-	yyensure_buffer_stack ();
+	yyensure_buffer_stack (yyscanner);
 	if ( YY_CURRENT_BUFFER == new_buffer )
 		return;
 
 	if ( YY_CURRENT_BUFFER )
 		{
 		/* Flush out information for old buffer. */
-		*(yy_c_buf_p) = (yy_hold_char);
-		YY_CURRENT_BUFFER_LVALUE->yy_buf_pos = (yy_c_buf_p);
-		YY_CURRENT_BUFFER_LVALUE->yy_n_chars = (yy_n_chars);
+		*yyg->yy_c_buf_p = yyg->yy_hold_char;
+		YY_CURRENT_BUFFER_LVALUE->yy_buf_pos = yyg->yy_c_buf_p;
+		YY_CURRENT_BUFFER_LVALUE->yy_n_chars = yyg->yy_n_chars;
 		}
 
 	YY_CURRENT_BUFFER_LVALUE = new_buffer;
-	yy_load_buffer_state(  );
+	yy_load_buffer_state( yyscanner );
 
 	/* We don't actually know whether we did this switch during
 	 * EOF (yywrap()) processing, but the only time this flag
 	 * is looked at is after yywrap() is called, so it's safe
 	 * to go ahead and always set it.
 	 */
-	(yy_did_buffer_switch_on_eof) = 1;
+	yyg->yy_did_buffer_switch_on_eof = 1;
 }
 
-static void yy_load_buffer_state  (void)
+static void yy_load_buffer_state  (yyscan_t yyscanner)
 {
-    	(yy_n_chars) = YY_CURRENT_BUFFER_LVALUE->yy_n_chars;
-	(yytext_ptr) = (yy_c_buf_p) = YY_CURRENT_BUFFER_LVALUE->yy_buf_pos;
+    struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
+	yyg->yy_n_chars = YY_CURRENT_BUFFER_LVALUE->yy_n_chars;
+	yyg->yytext_ptr = yyg->yy_c_buf_p = YY_CURRENT_BUFFER_LVALUE->yy_buf_pos;
 	yyin = YY_CURRENT_BUFFER_LVALUE->yy_input_file;
-	(yy_hold_char) = *(yy_c_buf_p);
+	yyg->yy_hold_char = *yyg->yy_c_buf_p;
 }
 
 /** Allocate and initialize an input buffer state.
@@ -8570,11 +8681,11 @@ static void yy_load_buffer_state  (void)
  * 
  * @return the allocated buffer state.
  */
-    YY_BUFFER_STATE yy_create_buffer  (FILE * file, int  size )
+    YY_BUFFER_STATE yy_create_buffer  (FILE * file, int  size , yyscan_t yyscanner)
 {
 	YY_BUFFER_STATE b;
     
-	b = (YY_BUFFER_STATE) yyalloc( sizeof( struct yy_buffer_state )  );
+	b = (YY_BUFFER_STATE) yyalloc( sizeof( struct yy_buffer_state ) , yyscanner );
 	if ( ! b )
 		YY_FATAL_ERROR( "out of dynamic memory in yy_create_buffer()" );
 
@@ -8583,13 +8694,13 @@ static void yy_load_buffer_state  (void)
 	/* yy_ch_buf has to be 2 characters longer than the size given because
 	 * we need to put in 2 end-of-buffer characters.
 	 */
-	b->yy_ch_buf = (char *) yyalloc( (yy_size_t) (b->yy_buf_size + 2)  );
+	b->yy_ch_buf = (char *) yyalloc( (yy_size_t) (b->yy_buf_size + 2) , yyscanner );
 	if ( ! b->yy_ch_buf )
 		YY_FATAL_ERROR( "out of dynamic memory in yy_create_buffer()" );
 
 	b->yy_is_our_buffer = 1;
 
-	yy_init_buffer( b, file );
+	yy_init_buffer( b, file , yyscanner);
 
 	return b;
 }
@@ -8598,9 +8709,10 @@ static void yy_load_buffer_state  (void)
  * @param b a buffer created with yy_create_buffer()
  * 
  */
-    void yy_delete_buffer (YY_BUFFER_STATE  b )
+    void yy_delete_buffer (YY_BUFFER_STATE  b , yyscan_t yyscanner)
 {
-    
+    struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
+
 	if ( ! b )
 		return;
 
@@ -8608,21 +8720,22 @@ static void yy_load_buffer_state  (void)
 		YY_CURRENT_BUFFER_LVALUE = (YY_BUFFER_STATE) 0;
 
 	if ( b->yy_is_our_buffer )
-		yyfree( (void *) b->yy_ch_buf  );
+		yyfree( (void *) b->yy_ch_buf , yyscanner );
 
-	yyfree( (void *) b  );
+	yyfree( (void *) b , yyscanner );
 }
 
 /* Initializes or reinitializes a buffer.
  * This function is sometimes called more than once on the same buffer,
  * such as during a yyrestart() or at EOF.
  */
-    static void yy_init_buffer  (YY_BUFFER_STATE  b, FILE * file )
+    static void yy_init_buffer  (YY_BUFFER_STATE  b, FILE * file , yyscan_t yyscanner)
 
 {
 	int oerrno = errno;
-    
-	yy_flush_buffer( b );
+    struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
+
+	yy_flush_buffer( b , yyscanner);
 
 	b->yy_input_file = file;
 	b->yy_fill_buffer = 1;
@@ -8645,9 +8758,10 @@ static void yy_load_buffer_state  (void)
  * @param b the buffer state to be flushed, usually @c YY_CURRENT_BUFFER.
  * 
  */
-    void yy_flush_buffer (YY_BUFFER_STATE  b )
+    void yy_flush_buffer (YY_BUFFER_STATE  b , yyscan_t yyscanner)
 {
-    	if ( ! b )
+    struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
+	if ( ! b )
 		return;
 
 	b->yy_n_chars = 0;
@@ -8665,7 +8779,7 @@ static void yy_load_buffer_state  (void)
 	b->yy_buffer_status = YY_BUFFER_NEW;
 
 	if ( b == YY_CURRENT_BUFFER )
-		yy_load_buffer_state(  );
+		yy_load_buffer_state( yyscanner );
 }
 
 /** Pushes the new state onto the stack. The new state becomes
@@ -8674,95 +8788,98 @@ static void yy_load_buffer_state  (void)
  *  @param new_buffer The new state.
  *  
  */
-void yypush_buffer_state (YY_BUFFER_STATE new_buffer )
+void yypush_buffer_state (YY_BUFFER_STATE new_buffer , yyscan_t yyscanner)
 {
-    	if (new_buffer == nullptr)
+    struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
+	if (new_buffer == nullptr)
 		return;
 
-	yyensure_buffer_stack();
+	yyensure_buffer_stack(yyscanner);
 
 	/* This block is copied from yy_switch_to_buffer. */
 	if ( YY_CURRENT_BUFFER )
 		{
 		/* Flush out information for old buffer. */
-		*(yy_c_buf_p) = (yy_hold_char);
-		YY_CURRENT_BUFFER_LVALUE->yy_buf_pos = (yy_c_buf_p);
-		YY_CURRENT_BUFFER_LVALUE->yy_n_chars = (yy_n_chars);
+		*yyg->yy_c_buf_p = yyg->yy_hold_char;
+		YY_CURRENT_BUFFER_LVALUE->yy_buf_pos = yyg->yy_c_buf_p;
+		YY_CURRENT_BUFFER_LVALUE->yy_n_chars = yyg->yy_n_chars;
 		}
 
 	/* Only push if top exists. Otherwise, replace top. */
 	if (YY_CURRENT_BUFFER)
-		(yy_buffer_stack_top)++;
+		yyg->yy_buffer_stack_top++;
 	YY_CURRENT_BUFFER_LVALUE = new_buffer;
 
 	/* copied from yy_switch_to_buffer. */
-	yy_load_buffer_state(  );
-	(yy_did_buffer_switch_on_eof) = 1;
+	yy_load_buffer_state( yyscanner );
+	yyg->yy_did_buffer_switch_on_eof = 1;
 }
 
 /** Removes and deletes the top of the stack, if present.
  *  The next element becomes the new top.
  *  
  */
-void yypop_buffer_state (void)
+void yypop_buffer_state (yyscan_t yyscanner)
 {
-    	if (!YY_CURRENT_BUFFER)
+    struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
+	if (!YY_CURRENT_BUFFER)
 		return;
 
-	yy_delete_buffer(YY_CURRENT_BUFFER );
+	yy_delete_buffer(YY_CURRENT_BUFFER , yyscanner);
 	YY_CURRENT_BUFFER_LVALUE = nullptr;
-	if ((yy_buffer_stack_top) > 0)
-		--(yy_buffer_stack_top);
+	if (yyg->yy_buffer_stack_top > 0)
+		--yyg->yy_buffer_stack_top;
 
 	if (YY_CURRENT_BUFFER) {
-		yy_load_buffer_state(  );
-		(yy_did_buffer_switch_on_eof) = 1;
+		yy_load_buffer_state( yyscanner );
+		yyg->yy_did_buffer_switch_on_eof = 1;
 	}
 }
 
 /* Allocates the stack if it does not exist.
  *  Guarantees space for at least one push.
  */
-static void yyensure_buffer_stack (void)
+static void yyensure_buffer_stack (yyscan_t yyscanner)
 {
 	yy_size_t num_to_alloc;
-    
-	if (!(yy_buffer_stack)) {
+    struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
+
+	if (!yyg->yy_buffer_stack) {
 
 		/* First allocation is just for 2 elements, since we don't know if this
 		 * scanner will even need a stack. We use 2 instead of 1 to avoid an
 		 * immediate realloc on the next call.
          */
       num_to_alloc = 1; /* After all that talk, this was set to 1 anyways... */
-		(yy_buffer_stack) = (struct yy_buffer_state**)yyalloc
+		yyg->yy_buffer_stack = (struct yy_buffer_state**)yyalloc
 								(num_to_alloc * sizeof(struct yy_buffer_state*)
-								);
-		if ( ! (yy_buffer_stack) )
+								, yyscanner);
+		if ( ! yyg->yy_buffer_stack )
 			YY_FATAL_ERROR( "out of dynamic memory in yyensure_buffer_stack()" );
 
-		memset((yy_buffer_stack), 0, num_to_alloc * sizeof(struct yy_buffer_state*));
+		memset(yyg->yy_buffer_stack, 0, num_to_alloc * sizeof(struct yy_buffer_state*));
 
-		(yy_buffer_stack_max) = num_to_alloc;
-		(yy_buffer_stack_top) = 0;
+		yyg->yy_buffer_stack_max = num_to_alloc;
+		yyg->yy_buffer_stack_top = 0;
 		return;
 	}
 
-	if ((yy_buffer_stack_top) >= ((yy_buffer_stack_max)) - 1){
+	if (yyg->yy_buffer_stack_top >= (yyg->yy_buffer_stack_max) - 1){
 
 		/* Increase the buffer to prepare for a possible push. */
 		yy_size_t grow_size = 8 /* arbitrary grow size */;
 
-		num_to_alloc = (yy_buffer_stack_max) + grow_size;
-		(yy_buffer_stack) = (struct yy_buffer_state**)yyrealloc
-								((yy_buffer_stack),
+		num_to_alloc = yyg->yy_buffer_stack_max + grow_size;
+		yyg->yy_buffer_stack = (struct yy_buffer_state**)yyrealloc
+								(yyg->yy_buffer_stack,
 								num_to_alloc * sizeof(struct yy_buffer_state*)
-								);
-		if ( ! (yy_buffer_stack) )
+								, yyscanner);
+		if ( ! yyg->yy_buffer_stack )
 			YY_FATAL_ERROR( "out of dynamic memory in yyensure_buffer_stack()" );
 
 		/* zero only the new slots.*/
-		memset((yy_buffer_stack) + (yy_buffer_stack_max), 0, grow_size * sizeof(struct yy_buffer_state*));
-		(yy_buffer_stack_max) = num_to_alloc;
+		memset(yyg->yy_buffer_stack + yyg->yy_buffer_stack_max, 0, grow_size * sizeof(struct yy_buffer_state*));
+		yyg->yy_buffer_stack_max = num_to_alloc;
 	}
 }
 
@@ -8772,7 +8889,7 @@ static void yyensure_buffer_stack (void)
  * 
  * @return the newly allocated buffer state object.
  */
-YY_BUFFER_STATE yy_scan_buffer  (char * base, yy_size_t  size )
+YY_BUFFER_STATE yy_scan_buffer  (char * base, yy_size_t  size , yyscan_t yyscanner)
 {
 	YY_BUFFER_STATE b;
     
@@ -8782,7 +8899,7 @@ YY_BUFFER_STATE yy_scan_buffer  (char * base, yy_size_t  size )
 		/* They forgot to leave room for the EOB's. */
 		return nullptr;
 
-	b = (YY_BUFFER_STATE) yyalloc( sizeof( struct yy_buffer_state )  );
+	b = (YY_BUFFER_STATE) yyalloc( sizeof( struct yy_buffer_state ) , yyscanner );
 	if ( ! b )
 		YY_FATAL_ERROR( "out of dynamic memory in yy_scan_buffer()" );
 
@@ -8796,7 +8913,7 @@ YY_BUFFER_STATE yy_scan_buffer  (char * base, yy_size_t  size )
 	b->yy_fill_buffer = 0;
 	b->yy_buffer_status = YY_BUFFER_NEW;
 
-	yy_switch_to_buffer( b  );
+	yy_switch_to_buffer( b  , yyscanner);
 
 	return b;
 }
@@ -8809,10 +8926,10 @@ YY_BUFFER_STATE yy_scan_buffer  (char * base, yy_size_t  size )
  * @note If you want to scan bytes that may contain NUL values, then use
  *       yy_scan_bytes() instead.
  */
-YY_BUFFER_STATE yy_scan_string (const char * yystr )
+YY_BUFFER_STATE yy_scan_string (const char * yystr , yyscan_t yyscanner)
 {
     
-	return yy_scan_bytes( yystr, (int) strlen(yystr) );
+	return yy_scan_bytes( yystr, (int) strlen(yystr) , yyscanner);
 }
 
 /** Setup the input buffer state to scan the given bytes. The next call to yylex() will
@@ -8822,7 +8939,7 @@ YY_BUFFER_STATE yy_scan_string (const char * yystr )
  * 
  * @return the newly allocated buffer state object.
  */
-YY_BUFFER_STATE yy_scan_bytes  (const char * yybytes, int  _yybytes_len )
+YY_BUFFER_STATE yy_scan_bytes  (const char * yybytes, int  _yybytes_len , yyscan_t yyscanner)
 {
 	YY_BUFFER_STATE b;
 	char *buf;
@@ -8831,7 +8948,7 @@ YY_BUFFER_STATE yy_scan_bytes  (const char * yybytes, int  _yybytes_len )
     
 	/* Get memory for full buffer, including space for trailing EOB's. */
 	n = (yy_size_t) (_yybytes_len + 2);
-	buf = (char *) yyalloc( n  );
+	buf = (char *) yyalloc( n , yyscanner );
 	if ( ! buf )
 		YY_FATAL_ERROR( "out of dynamic memory in yy_scan_bytes()" );
 
@@ -8840,7 +8957,7 @@ YY_BUFFER_STATE yy_scan_bytes  (const char * yybytes, int  _yybytes_len )
 
 	buf[_yybytes_len] = buf[_yybytes_len+1] = YY_END_OF_BUFFER_CHAR;
 
-	b = yy_scan_buffer( buf, n );
+	b = yy_scan_buffer( buf, n , yyscanner);
 	if ( ! b )
 		YY_FATAL_ERROR( "bad buffer in yy_scan_bytes()" );
 
@@ -8856,9 +8973,11 @@ YY_BUFFER_STATE yy_scan_bytes  (const char * yybytes, int  _yybytes_len )
 #define YY_EXIT_FAILURE 2
 #endif
 
-static void yynoreturn yy_fatal_error (const char* msg )
+static void yynoreturn yy_fatal_error (const char* msg , yyscan_t yyscanner)
 {
-			fprintf( stderr, "%s\n", msg );
+	struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
+	(void)yyg;
+	fprintf( stderr, "%s\n", msg );
 	exit( YY_EXIT_FAILURE );
 }
 
@@ -8871,111 +8990,242 @@ static void yynoreturn yy_fatal_error (const char* msg )
 		/* Undo effects of setting up yytext. */ \
         int yyless_macro_arg = (n); \
         YY_LESS_LINENO(yyless_macro_arg);\
-		yytext[yyleng] = (yy_hold_char); \
-		(yy_c_buf_p) = yytext + yyless_macro_arg; \
-		(yy_hold_char) = *(yy_c_buf_p); \
-		*(yy_c_buf_p) = '\0'; \
+		yytext[yyleng] = yyg->yy_hold_char; \
+		yyg->yy_c_buf_p = yytext + yyless_macro_arg; \
+		yyg->yy_hold_char = *yyg->yy_c_buf_p; \
+		*yyg->yy_c_buf_p = '\0'; \
 		yyleng = yyless_macro_arg; \
 		} \
 	while ( 0 )
 
 /* Accessor  methods (get/set functions) to struct members. */
 
+/** Get the user-defined data for this scanner.
+ * @param yyscanner The scanner object.
+ */
+YY_EXTRA_TYPE yyget_extra  (yyscan_t yyscanner)
+{
+    struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
+    return yyextra;
+}
+
 /** Get the current line number.
- * 
+ * @param yyscanner The scanner object.
  */
-int yyget_lineno  (void)
+int yyget_lineno  (yyscan_t yyscanner)
 {
+    struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
+
+        if (! YY_CURRENT_BUFFER)
+            return 0;
     
     return yylineno;
 }
 
+/** Get the current column number.
+ * @param yyscanner The scanner object.
+ */
+int yyget_column  (yyscan_t yyscanner)
+{
+    struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
+
+        if (! YY_CURRENT_BUFFER)
+            return 0;
+    
+    return yycolumn;
+}
+
 /** Get the input stream.
- * 
+ * @param yyscanner The scanner object.
  */
-FILE *yyget_in  (void)
+FILE *yyget_in  (yyscan_t yyscanner)
 {
-        return yyin;
+    struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
+    return yyin;
 }
 
 /** Get the output stream.
- * 
+ * @param yyscanner The scanner object.
  */
-FILE *yyget_out  (void)
+FILE *yyget_out  (yyscan_t yyscanner)
 {
-        return yyout;
+    struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
+    return yyout;
 }
 
 /** Get the length of the current token.
- * 
+ * @param yyscanner The scanner object.
  */
-int yyget_leng  (void)
+int yyget_leng  (yyscan_t yyscanner)
 {
-        return yyleng;
+    struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
+    return yyleng;
 }
 
 /** Get the current token.
- * 
+ * @param yyscanner The scanner object.
  */
 
-char *yyget_text  (void)
+char *yyget_text  (yyscan_t yyscanner)
+{
+    struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
+    return yytext;
+}
+
+/** Set the user-defined data. This data is never touched by the scanner.
+ * @param user_defined The data to be associated with this scanner.
+ * @param yyscanner The scanner object.
+ */
+void yyset_extra (YY_EXTRA_TYPE  user_defined , yyscan_t yyscanner)
 {
-        return yytext;
+    struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
+    yyextra = user_defined ;
 }
 
 /** Set the current line number.
  * @param _line_number line number
- * 
+ * @param yyscanner The scanner object.
  */
-void yyset_lineno (int  _line_number )
+void yyset_lineno (int  _line_number , yyscan_t yyscanner)
 {
+    struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
+
+        /* lineno is only valid if an input buffer exists. */
+        if (! YY_CURRENT_BUFFER )
+           YY_FATAL_ERROR( "yyset_lineno called with no buffer" );
     
     yylineno = _line_number;
 }
 
+/** Set the current column.
+ * @param _column_no column number
+ * @param yyscanner The scanner object.
+ */
+void yyset_column (int  _column_no , yyscan_t yyscanner)
+{
+    struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
+
+        /* column is only valid if an input buffer exists. */
+        if (! YY_CURRENT_BUFFER )
+           YY_FATAL_ERROR( "yyset_column called with no buffer" );
+    
+    yycolumn = _column_no;
+}
+
 /** Set the input stream. This does not discard the current
  * input buffer.
  * @param _in_str A readable stream.
- * 
+ * @param yyscanner The scanner object.
  * @see yy_switch_to_buffer
  */
-void yyset_in (FILE *  _in_str )
+void yyset_in (FILE *  _in_str , yyscan_t yyscanner)
+{
+    struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
+    yyin = _in_str ;
+}
+
+void yyset_out (FILE *  _out_str , yyscan_t yyscanner)
 {
-        yyin = _in_str ;
+    struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
+    yyout = _out_str ;
 }
 
-void yyset_out (FILE *  _out_str )
+int yyget_debug  (yyscan_t yyscanner)
 {
-        yyout = _out_str ;
+    struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
+    return yy_flex_debug;
 }
 
-int yyget_debug  (void)
+void yyset_debug (int  _bdebug , yyscan_t yyscanner)
 {
-        return yy_flex_debug;
+    struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
+    yy_flex_debug = _bdebug ;
 }
 
-void yyset_debug (int  _bdebug )
+/* Accessor methods for yylval and yylloc */
+
+/* User-visible API */
+
+/* yylex_init is special because it creates the scanner itself, so it is
+ * the ONLY reentrant function that doesn't take the scanner as the last argument.
+ * That's why we explicitly handle the declaration, instead of using our macros.
+ */
+int yylex_init(yyscan_t* ptr_yy_globals)
 {
-        yy_flex_debug = _bdebug ;
+    if (ptr_yy_globals == nullptr){
+        errno = EINVAL;
+        return 1;
+    }
+
+    *ptr_yy_globals = (yyscan_t) yyalloc ( sizeof( struct yyguts_t ), nullptr );
+
+    if (*ptr_yy_globals == nullptr){
+        errno = ENOMEM;
+        return 1;
+    }
+
+    /* By setting to 0xAA, we expose bugs in yy_init_globals. Leave at 0x00 for releases. */
+    memset(*ptr_yy_globals,0x00,sizeof(struct yyguts_t));
+
+    return yy_init_globals ( *ptr_yy_globals );
 }
 
-static int yy_init_globals (void)
+/* yylex_init_extra has the same functionality as yylex_init, but follows the
+ * convention of taking the scanner as the last argument. Note however, that
+ * this is a *pointer* to a scanner, as it will be allocated by this call (and
+ * is the reason, too, why this function also must handle its own declaration).
+ * The user defined value in the first argument will be available to yyalloc in
+ * the yyextra field.
+ */
+int yylex_init_extra( YY_EXTRA_TYPE yy_user_defined, yyscan_t* ptr_yy_globals )
 {
-        /* Initialization is the same as for the non-reentrant scanner.
+    struct yyguts_t dummy_yyguts;
+
+    yyset_extra (yy_user_defined, &dummy_yyguts);
+
+    if (ptr_yy_globals == nullptr){
+        errno = EINVAL;
+        return 1;
+    }
+
+    *ptr_yy_globals = (yyscan_t) yyalloc ( sizeof( struct yyguts_t ), &dummy_yyguts );
+
+    if (*ptr_yy_globals == nullptr){
+        errno = ENOMEM;
+        return 1;
+    }
+
+    /* By setting to 0xAA, we expose bugs in
+    yy_init_globals. Leave at 0x00 for releases. */
+    memset(*ptr_yy_globals,0x00,sizeof(struct yyguts_t));
+
+    yyset_extra (yy_user_defined, *ptr_yy_globals);
+
+    return yy_init_globals ( *ptr_yy_globals );
+}
+
+static int yy_init_globals (yyscan_t yyscanner)
+{
+    struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
+    /* Initialization is the same as for the non-reentrant scanner.
      * This function is called from yylex_destroy(), so don't allocate here.
      */
 
-    (yy_buffer_stack) = nullptr;
-    (yy_buffer_stack_top) = 0;
-    (yy_buffer_stack_max) = 0;
-    (yy_c_buf_p) = nullptr;
-    (yy_init) = 0;
-    (yy_start) = 0;
+    yyg->yy_buffer_stack = nullptr;
+    yyg->yy_buffer_stack_top = 0;
+    yyg->yy_buffer_stack_max = 0;
+    yyg->yy_c_buf_p = nullptr;
+    yyg->yy_init = 0;
+    yyg->yy_start = 0;
 
-    (yy_state_buf) = 0;
-    (yy_state_ptr) = 0;
-    (yy_full_match) = 0;
-    (yy_lp) = 0;
+    yyg->yy_start_stack_ptr = 0;
+    yyg->yy_start_stack_depth = 0;
+    yyg->yy_start_stack =  nullptr;
+
+    yyg->yy_state_buf = 0;
+    yyg->yy_state_ptr = 0;
+    yyg->yy_full_match = 0;
+    yyg->yy_lp = 0;
 
 /* Defined in main.c */
 #ifdef YY_STDINIT
@@ -8993,27 +9243,35 @@ static int yy_init_globals (void)
 }
 
 /* yylex_destroy is for both reentrant and non-reentrant scanners. */
-int yylex_destroy  (void)
+int yylex_destroy  (yyscan_t yyscanner)
 {
-    
+    struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
+
     /* Pop the buffer stack, destroying each element. */
 	while(YY_CURRENT_BUFFER){
-		yy_delete_buffer( YY_CURRENT_BUFFER  );
+		yy_delete_buffer( YY_CURRENT_BUFFER , yyscanner );
 		YY_CURRENT_BUFFER_LVALUE = nullptr;
-		yypop_buffer_state();
+		yypop_buffer_state(yyscanner);
 	}
 
 	/* Destroy the stack itself. */
-	yyfree((yy_buffer_stack) );
-	(yy_buffer_stack) = nullptr;
+	yyfree(yyg->yy_buffer_stack , yyscanner);
+	yyg->yy_buffer_stack = nullptr;
 
-    yyfree ( (yy_state_buf) );
-    (yy_state_buf)  = nullptr;
+    /* Destroy the start condition stack. */
+        yyfree( yyg->yy_start_stack , yyscanner );
+        yyg->yy_start_stack = nullptr;
+
+    yyfree ( yyg->yy_state_buf , yyscanner);
+    yyg->yy_state_buf  = nullptr;
 
     /* Reset the globals. This is important in a non-reentrant scanner so the next time
      * yylex() is called, initialization will occur. */
-    yy_init_globals( );
+    yy_init_globals( yyscanner);
 
+    /* Destroy the main struct (reentrant only). */
+    yyfree ( yyscanner , yyscanner );
+    yyscanner = nullptr;
     return 0;
 }
 
@@ -9022,9 +9280,11 @@ int yylex_destroy  (void)
  */
 
 #ifndef yytext_ptr
-static void yy_flex_strncpy (char* s1, const char * s2, int n )
+static void yy_flex_strncpy (char* s1, const char * s2, int n , yyscan_t yyscanner)
 {
-		
+	struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
+	(void)yyg;
+
 	int i;
 	for ( i = 0; i < n; ++i )
 		s1[i] = s2[i];
@@ -9032,7 +9292,7 @@ static void yy_flex_strncpy (char* s1, const char * s2, int n )
 #endif
 
 #ifdef YY_NEED_STRLEN
-static int yy_flex_strlen (const char * s )
+static int yy_flex_strlen (const char * s , yyscan_t yyscanner)
 {
 	int n;
 	for ( n = 0; s[n]; ++n )
@@ -9042,14 +9302,18 @@ static int yy_flex_strlen (const char * s )
 }
 #endif
 
-void *yyalloc (yy_size_t  size )
+void *yyalloc (yy_size_t  size , yyscan_t yyscanner)
 {
-			return malloc(size);
+	struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
+	(void)yyg;
+	return malloc(size);
 }
 
-void *yyrealloc  (void * ptr, yy_size_t  size )
+void *yyrealloc  (void * ptr, yy_size_t  size , yyscan_t yyscanner)
 {
-		
+	struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
+	(void)yyg;
+
 	/* The cast to (char *) in the following accommodates both
 	 * implementations that use char* generic pointers, and those
 	 * that use void* generic pointers.  It works with the latter
@@ -9060,9 +9324,11 @@ void *yyrealloc  (void * ptr, yy_size_t  size )
 	return realloc(ptr, size);
 }
 
-void yyfree (void * ptr )
+void yyfree (void * ptr , yyscan_t yyscanner)
 {
-			free( (char *) ptr );	/* see yyrealloc() for (char *) cast */
+	struct yyguts_t * yyg = (struct yyguts_t*)yyscanner;
+	(void)yyg;
+	free( (char *) ptr );	/* see yyrealloc() for (char *) cast */
 }
 
 #define YYTABLES_NAME "yytables"
@@ -9078,7 +9344,7 @@ static int getNextChar(const QString &expr, QString *rest, uint &pos)
       return cc;
 
    } else {
-      int cc = yyinput();
+      int cc = yyinput(s_ctx->yyscanner);
 
       return cc;
    }
@@ -9094,7 +9360,7 @@ static int getCurrentChar(const QString &expr, QString *rest, uint pos)
       return cc;
 
    } else {
-      int cc = yyinput();
+      int cc = yyinput(s_ctx->yyscanner);
 
       returnCharToStream(cc);
       return cc;
@@ -9118,6 +9384,27 @@ static void unputChar(const QString &expr, QString *rest, uint &pos, char c)
    }
 }
 
+static void returnCharToStream(char c)
+{
+   yyscan_t yyscanner = s_ctx->yyscanner;
+   struct yyguts_t *yyg = (struct yyguts_t *)yyscanner;
+
+   unput(c);
+}
+
+static YY_BUFFER_STATE getCurrentBuffer()
+{
+   struct yyguts_t *yyg = (struct yyguts_t *)s_ctx->yyscanner;
+
+   return YY_CURRENT_BUFFER;
+}
+
+static void startNewBuffer()
+{
+   yyscan_t yyscanner = s_ctx->yyscanner;
+   preYY_switch_to_buffer(preYY_create_buffer(nullptr, YY_BUF_SIZE, yyscanner), yyscanner);
+}
+
 void addSearchDir(const QString &dir)
 {
    QFileInfo fi(dir);
@@ -9130,40 +9417,44 @@ void addSearchDir(const QString &dir)
 void initPreprocessor()
 {
    addSearchDir(".");
-   s_expandedDict = QMakeShared<DefineDict>();
+
+   // create the shared define manager before any thread starts preprocessing
+   DefineManager::instance();
 }
 
 void removePreProcessor()
 {
-   s_expandedDict = QSharedPointer<DefineDict>();
    s_pathList.clear();
+   s_includeNameCache.clear();
 
    DefineManager::deleteInstance();
 }
 
 QString preprocessFile(const QString &fileName, const QString &input)
 {
-   printlex(preYY_flex_debug, true, __FILE__, fileName);
+   // all state for this file lives in its own context and scanner, a file which is already
+   // being processed on this thread is resumed when this one is done
+   PreprocessorContext context;
+   PreprocessorContext *prevContext = s_ctx;
+
+   yyscan_t yyscanner;
+   preYYlex_init_extra(&context, &yyscanner);
+   struct yyguts_t *yyg = (struct yyguts_t *)yyscanner;
 
-   s_macroExpansion   = Config::getBool("macro-expansion");
-   s_expandOnlyPredef = Config::getBool("expand-only-predefined");
+   printlex(yy_flex_debug, true, __FILE__, fileName);
 
-   s_skip        = false;
-   s_curlyCount  = 0;
-   s_nospaces    = false;
+   context.yyscanner = yyscanner;
+   s_ctx = &context;
 
-   s_inputPosition  = 0;
-   s_inputString    = input;
-   s_outputString   = "";
+   s_ctx->macroExpansion   = Config::getBool("macro-expansion");
+   s_ctx->expandOnlyPredef = Config::getBool("expand-only-predefined");
 
-   s_includeStack.clear();
-   s_expandedDict->clear();
-   s_condStack.clear();
+   s_ctx->inputString = input;
 
    setFileName(fileName);
 
-   s_inputFileDef = s_yyFileDef;
-   DefineManager::instance().startContext(s_yyFileName);
+   s_ctx->inputFileDef = s_ctx->yyFileDef;
+   DefineManager::instance().startContext(s_ctx->yyFileName);
 
    static bool firstTime = true;
 
@@ -9277,10 +9568,10 @@ QString preprocessFile(const QString &fileName, const QString &input)
                def->nargs        = count;
                def->isPredefined = true;
                def->nonRecursive = nonRecursive;
-               def->fileDef      = s_yyFileDef;
+               def->fileDef      = s_ctx->yyFileDef;
                def->m_fileName   = fileName;
 
-               DefineManager::instance().addDefine(s_yyFileName, def);
+               DefineManager::instance().addDefine(s_ctx->contextDefines, s_ctx->yyFileName, def);
             }
 
          } else if ((posOpen == -1 || posOpen > posEquals)   &&
@@ -9306,33 +9597,22 @@ QString preprocessFile(const QString &fileName, const QString &input)
                def->nargs = -1;
                def->isPredefined = true;
                def->nonRecursive = nonRecursive;
-               def->fileDef      = s_yyFileDef;
+               def->fileDef      = s_ctx->yyFileDef;
                def->m_fileName   = fileName;
-               DefineManager::instance().addDefine(s_yyFileName, def);
+               DefineManager::instance().addDefine(s_ctx->contextDefines, s_ctx->yyFileName, def);
             }
          }
       }
    }
 
-   s_yyLineNr = 1;
-   s_yyColNr  = 1;
-   s_ifcount  = 0;
-
-   s_levelGuard.clear();
-
    BEGIN( Start );
 
-   s_expectGuard = determineSection(fileName) == Entry::HEADER_SEC;
-   s_guardName.resize(0);
-   s_lastGuardName.resize(0);
-   s_guardExpr = "";
-
-   preYYlex();
+   s_ctx->expectGuard = determineSection(fileName) == Entry::HEADER_SEC;
 
-   s_lexInit = true;
+   preYYlex(yyscanner);
 
-   while (! s_condStack.isEmpty()) {
-      QSharedPointer<CondCtx> ctx = s_condStack.pop();
+   while (! s_ctx->condStack.isEmpty()) {
+      QSharedPointer<CondCtx> ctx = s_ctx->condStack.pop();
       QString sectionInfo = " ";
 
       if (ctx->sectionId != " ") {
@@ -9346,16 +9626,12 @@ QString preprocessFile(const QString &fileName, const QString &input)
    // make sure we do not extend a \cond with missing \endcond over multiple files
    forceEndCondSection();
 
-   DefineManager::instance().endContext();
-   printlex(preYY_flex_debug, false, __FILE__, fileName);
+   QString retval = std::move(s_ctx->outputString);
+   s_ctx = prevContext;
 
-   return s_outputString;
-}
+   printlex(yy_flex_debug, false, __FILE__, fileName);
+   preYYlex_destroy(yyscanner);
 
-void preFreeScanner()
-{
-   if (s_lexInit) {
-      preYYlex_destroy();
-   }
+   return retval;
 }
 
@@ -584,7 +584,7 @@ static void visitPostCaption(QTextStream &t, DocVerbatim *s)
    }
 }
 
-static void visitCaption(HtmlDocVisitor *parent, QList<DocNode *> children)
+static void visitCaption(HtmlDocVisitor *parent, DocNodeList children)
 {
    for (const auto &n : children) {
       n->accept(parent);
@@ -1116,7 +1116,7 @@ bool isLastChildNode(T *parent, DocNode *node)
 
 bool isSeparatedParagraph(DocSimpleSect *parent, DocPara *par)
 {
-   QList<DocNode *> nodes = parent->children();
+   DocNodeList nodes = parent->children();
 
    int i = nodes.indexOf(par);
 
@@ -1028,6 +1028,10 @@ void HtmlGenerator::writeFooter(const QString &navPath)
 void HtmlGenerator::endFile()
 {
    endPlainFile();
+
+   if (Doxy_Globals::searchIndexBase != nullptr) {
+      Doxy_Globals::searchIndexBase->endPage(m_lastFile);
+   }
 }
 
 void HtmlGenerator::startProjectNumber()
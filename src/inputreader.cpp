@@ -0,0 +1,118 @@
+/************************************************************************
+*
+* Copyright (c) 2014-2025 Barbara Geller & Ansel Sermersheim
+*
+* Copyright (c) 1997-2014 Dimitri van Heesch
+*
+* DoxyPress is free software. You can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* version 2 as published by the Free Software Foundation.
+*
+* DoxyPress is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+*
+* Documents produced by DoxyPress are derivative works derived from the
+* input used in their production; they are not affected by this license.
+*
+* https://www.gnu.org/licenses/
+*
+*************************************************************************/
+
+#include <inputreader.h>
+
+InputReaderThread::InputReaderThread(InputReader *reader)
+   : m_reader(reader)
+{
+}
+
+void InputReaderThread::run()
+{
+   int index;
+
+   while ((index = m_reader->nextIndex()) != -1) {
+      QString fileContents = m_reader->m_loader(m_reader->m_fileList.at(index));
+      m_reader->store(index, fileContents);
+   }
+}
+
+InputReader::InputReader(const QStringList &fileList, int numThreads, std::function<QString (const QString &)> loader)
+   : m_fileList(fileList), m_loader(std::move(loader)), m_nextIndex(0), m_consumedIndex(0), m_stop(false)
+{
+   // limit how far the worker threads can get ahead of the parser
+   m_maxPending = numThreads * 4;
+
+   for (int i = 0; i < numThreads; ++i) {
+      InputReaderThread *thread = new InputReaderThread(this);
+      thread->start();
+
+      if (thread->isRunning()) {
+         m_workers.append(thread);
+
+      } else {
+         // no more threads available
+         delete thread;
+         break;
+      }
+   }
+}
+
+InputReader::~InputReader()
+{
+   {
+      QMutexLocker locker(&m_mutex);
+
+      m_stop = true;
+      m_spaceAvailable.wakeAll();
+   }
+
+   for (auto thread : m_workers) {
+      thread->wait();
+      delete thread;
+   }
+}
+
+int InputReader::nextIndex()
+{
+   QMutexLocker locker(&m_mutex);
+
+   while (! m_stop && m_nextIndex < m_fileList.count() && m_nextIndex >= m_consumedIndex + m_maxPending) {
+      // wait until the parser has consumed some of the files
+      m_spaceAvailable.wait(&m_mutex);
+   }
+
+   if (m_stop || m_nextIndex >= m_fileList.count()) {
+      return -1;
+   }
+
+   return m_nextIndex++;
+}
+
+void InputReader::store(int index, const QString &contents)
+{
+   QMutexLocker locker(&m_mutex);
+
+   m_results.insert(index, contents);
+   m_resultReady.wakeAll();
+}
+
+QString InputReader::take(int index)
+{
+   if (m_workers.isEmpty()) {
+      // single threaded mode
+      return m_loader(m_fileList.at(index));
+   }
+
+   QMutexLocker locker(&m_mutex);
+
+   while (! m_results.contains(index)) {
+      m_resultReady.wait(&m_mutex);
+   }
+
+   QString retval = m_results.take(index);
+
+   m_consumedIndex = index + 1;
+   m_spaceAvailable.wakeAll();
+
+   return retval;
+}
@@ -0,0 +1,96 @@
+/************************************************************************
+*
+* Copyright (c) 2014-2025 Barbara Geller & Ansel Sermersheim
+*
+* Copyright (c) 1997-2014 Dimitri van Heesch
+*
+* DoxyPress is free software. You can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* version 2 as published by the Free Software Foundation.
+*
+* DoxyPress is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+*
+* Documents produced by DoxyPress are derivative works derived from the
+* input used in their production; they are not affected by this license.
+*
+* https://www.gnu.org/licenses/
+*
+*************************************************************************/
+
+#ifndef INPUTREADER_H
+#define INPUTREADER_H
+
+#include <QList>
+#include <QMap>
+#include <QMutex>
+#include <QString>
+#include <QStringList>
+#include <QThread>
+#include <QWaitCondition>
+
+#include <functional>
+
+class InputReader;
+
+/** Worker thread which reads, filters, and preprocesses input files */
+class InputReaderThread : public QThread
+{
+ public:
+   InputReaderThread(InputReader *reader);
+   void run() override;
+
+ private:
+   InputReader *m_reader;
+};
+
+/** Loads the input files on worker threads while the parsers consume them in the original order
+ *
+ *  The loader passed to the constructor reads a file and runs the input filter and the preprocessor.
+ *  The lex based language parsers are not reentrant and stay on the calling thread. Files are returned
+ *  in the order they were passed to the constructor, the parsers see them in the same order as in a
+ *  single threaded run. The number of threads is set by read-num-threads.
+ *
+ *  The preprocessor shares its include guard and the defines of completed headers between files.
+ *  When several threads are used a header included by more than one file can be expanded in a
+ *  different file than in a single threaded run.
+ */
+class InputReader
+{
+ public:
+   InputReader(const QStringList &fileList, int numThreads, std::function<QString (const QString &)> loader);
+   ~InputReader();
+
+   // returns the loaded contents of the file at the given position in the list, waits until the file is loaded
+   QString take(int index);
+
+   int threadCount() const {
+      return m_workers.count();
+   }
+
+ private:
+   int nextIndex();
+   void store(int index, const QString &contents);
+
+   QStringList m_fileList;
+   std::function<QString (const QString &)> m_loader;
+
+   int m_nextIndex;
+   int m_consumedIndex;
+   int m_maxPending;
+
+   bool m_stop;
+
+   QMap<int, QString>  m_results;
+
+   QMutex         m_mutex;
+   QWaitCondition m_resultReady;
+   QWaitCondition m_spaceAvailable;
+
+   QList<InputReaderThread *> m_workers;
+
+   friend class InputReaderThread;
+};
+
+#endif
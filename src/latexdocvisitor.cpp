@@ -139,7 +139,7 @@ static void visitPostEnd(QTextStream &t, const bool hasCaption, bool inlineImage
    }
 }
 
-static void visitCaption(LatexDocVisitor *parent, QList<DocNode *> children)
+static void visitCaption(LatexDocVisitor *parent, DocNodeList children)
 {
    for (auto n : children) {
       n->accept(parent);
@@ -0,0 +1,209 @@
+/************************************************************************
+*
+* Copyright (c) 2014-2025 Barbara Geller & Ansel Sermersheim
+*
+* Copyright (c) 1997-2014 Dimitri van Heesch
+*
+* DoxyPress is free software. You can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* version 2 as published by the Free Software Foundation.
+*
+* DoxyPress is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+*
+* Documents produced by DoxyPress are derivative works derived from the
+* input used in their production; they are not affected by this license.
+*
+* https://www.gnu.org/licenses/
+*
+*************************************************************************/
+
+#include <lookupcache.h>
+
+QHash<QString, int> LookupCache::m_atoms;
+QReadWriteLock      LookupCache::m_atomLock;
+int                 LookupCache::m_nextAtom = 0;
+
+LookupCache::LookupCache()
+   : m_maxCost(65536), m_hits(0), m_misses(0), m_evictions(0)
+{
+}
+
+size_t LookupCache::KeyHash::operator()(const Key &key) const
+{
+   size_t retval = std::hash<const void *>()(key.scope);
+
+   retval = retval * 31 + std::hash<const void *>()(key.fileScope);
+   retval = retval * 31 + std::hash<int>()(key.name);
+   retval = retval * 31 + std::hash<int>()(key.explicitScope);
+
+   return retval;
+}
+
+int LookupCache::atom(const QString &str)
+{
+   if (str.isEmpty()) {
+      return 0;
+   }
+
+   {
+      QReadLocker locker(&m_atomLock);
+      auto iter = m_atoms.find(str);
+
+      if (iter != m_atoms.end()) {
+         return iter.value();
+      }
+   }
+
+   QWriteLocker locker(&m_atomLock);
+   auto iter = m_atoms.find(str);
+
+   if (iter != m_atoms.end()) {
+      // added by another thread
+      return iter.value();
+   }
+
+   // numbers are not reused after clear(), a key made before the table was cleared does not match a new string
+   int retval = ++m_nextAtom;
+   m_atoms.insert(str, retval);
+
+   return retval;
+}
+
+LookupCache::Key LookupCache::key(QSharedPointer<const Definition> scope, QSharedPointer<const FileDef> fileScope,
+                  const QString &name, const QString &explicitScope)
+{
+   Key retval;
+
+   retval.scope         = scope.data();
+   retval.fileScope     = fileScope.data();
+   retval.name          = atom(name);
+   retval.explicitScope = atom(explicitScope);
+   retval.scopeRef      = scope;
+   retval.fileScopeRef  = fileScope;
+
+   return retval;
+}
+
+LookupCache::Shard &LookupCache::shard(const Key &key)
+{
+   return m_shards[KeyHash()(key) % ShardCount];
+}
+
+void LookupCache::setMaxCost(int maxCost)
+{
+   m_maxCost = maxCost;
+   clear();
+}
+
+bool LookupCache::find(const Key &key, LookupInfo &info)
+{
+   Shard &item = shard(key);
+   QMutexLocker locker(&item.mutex);
+
+   auto iter = item.index.find(key);
+
+   if (iter == item.index.end()) {
+      ++m_misses;
+      return false;
+   }
+
+   const Key &entryKey = iter->second->key;
+
+   if (entryKey.scopeRef.toStrongRef().data() != entryKey.scope ||
+         entryKey.fileScopeRef.toStrongRef().data() != entryKey.fileScope) {
+      // the definition was deleted, key matched a new object at the same address
+      item.cost -= iter->second->cost;
+      item.entries.erase(iter->second);
+      item.index.erase(iter);
+
+      ++m_misses;
+      return false;
+   }
+
+   // move to the front of the list
+   item.entries.splice(item.entries.begin(), item.entries, iter->second);
+
+   info = iter->second->info;
+   ++m_hits;
+
+   return true;
+}
+
+void LookupCache::insert(const Key &key, const LookupInfo &info)
+{
+   // long template specifiers or resolved types count as several entries
+   int cost = 1 + (info.templSpec.size() + info.resolvedType.size()) / 32;
+
+   Shard &item = shard(key);
+   QMutexLocker locker(&item.mutex);
+
+   auto iter = item.index.find(key);
+
+   if (iter != item.index.end()) {
+      item.cost -= iter->second->cost;
+      item.entries.erase(iter->second);
+      item.index.erase(iter);
+   }
+
+   int maxShardCost = qMax(1, m_maxCost / ShardCount);
+
+   if (cost > maxShardCost) {
+      return;
+   }
+
+   while (item.cost + cost > maxShardCost && ! item.entries.empty()) {
+      const Entry &last = item.entries.back();
+
+      item.cost -= last.cost;
+      item.index.erase(last.key);
+      item.entries.pop_back();
+
+      ++m_evictions;
+   }
+
+   item.entries.push_front(Entry{key, info, cost});
+   item.index.insert(std::make_pair(key, item.entries.begin()));
+
+   item.cost += cost;
+}
+
+void LookupCache::clear()
+{
+   for (auto &item : m_shards) {
+      QMutexLocker locker(&item.mutex);
+
+      item.entries.clear();
+      item.index.clear();
+      item.cost = 0;
+   }
+
+   // the interned strings are only referenced by the keys of the entries
+   QWriteLocker locker(&m_atomLock);
+   m_atoms.clear();
+}
+
+int LookupCache::count() const
+{
+   int retval = 0;
+
+   for (const auto &item : m_shards) {
+      QMutexLocker locker(&item.mutex);
+      retval += item.index.size();
+   }
+
+   return retval;
+}
+
+int LookupCache::totalCost() const
+{
+   int retval = 0;
+
+   for (const auto &item : m_shards) {
+      QMutexLocker locker(&item.mutex);
+      retval += item.cost;
+   }
+
+   return retval;
+}
@@ -0,0 +1,156 @@
+/************************************************************************
+*
+* Copyright (c) 2014-2025 Barbara Geller & Ansel Sermersheim
+*
+* Copyright (c) 1997-2014 Dimitri van Heesch
+*
+* DoxyPress is free software. You can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* version 2 as published by the Free Software Foundation.
+*
+* DoxyPress is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+*
+* Documents produced by DoxyPress are derivative works derived from the
+* input used in their production; they are not affected by this license.
+*
+* https://www.gnu.org/licenses/
+*
+*************************************************************************/
+
+#ifndef LOOKUPCACHE_H
+#define LOOKUPCACHE_H
+
+#include <QHash>
+#include <QMutex>
+#include <QReadWriteLock>
+#include <QSharedPointer>
+#include <QString>
+#include <QWeakPointer>
+
+#include <atomic>
+#include <list>
+#include <unordered_map>
+
+class ClassDef;
+class Definition;
+class FileDef;
+class MemberDef;
+
+struct LookupInfo {
+   LookupInfo()
+   { }
+
+   LookupInfo(QSharedPointer<ClassDef> cd, QSharedPointer<MemberDef> td, QString ts, QString rt)
+      : classDef(cd), typeDef(td), templSpec(ts), resolvedType(rt)
+   {}
+
+   QSharedPointer<ClassDef>  classDef;
+   QSharedPointer<MemberDef> typeDef;
+
+   QString templSpec;
+   QString resolvedType;
+};
+
+/** Cache of the classes found by getResolvedClass(), safe to use from several threads
+ *
+ *  Entries are spread over shards which each have their own lock and least recently used list.
+ *  The cost of an entry grows with the length of its strings, the total cost is limited by
+ *  lookup-cache-size.
+ */
+class LookupCache
+{
+ public:
+   struct Key {
+      const Definition *scope;
+      const FileDef    *fileScope;     // only set when the file has using statements
+
+      int name;
+      int explicitScope;
+
+      // the address of a deleted definition can be reused, find() checks these are still alive
+      QWeakPointer<const Definition> scopeRef;
+      QWeakPointer<const FileDef>    fileScopeRef;
+
+      bool operator==(const Key &other) const {
+         return scope == other.scope && fileScope == other.fileScope &&
+                  name == other.name && explicitScope == other.explicitScope;
+      }
+   };
+
+   LookupCache();
+
+   static Key key(QSharedPointer<const Definition> scope, QSharedPointer<const FileDef> fileScope,
+                  const QString &name, const QString &explicitScope);
+
+   void setMaxCost(int maxCost);
+
+   int maxCost() const {
+      return m_maxCost;
+   }
+
+   // returns false if the key is not in the cache
+   bool find(const Key &key, LookupInfo &info);
+   void insert(const Key &key, const LookupInfo &info);
+   void clear();
+
+   int count() const;
+
+   // sum of the cost of all entries, compare with maxCost()
+   int totalCost() const;
+
+   // totals since the cache was created, used for the statistics of each phase
+   qint64 hits() const {
+      return m_hits;
+   }
+
+   qint64 misses() const {
+      return m_misses;
+   }
+
+   qint64 evictions() const {
+      return m_evictions;
+   }
+
+ private:
+   struct KeyHash {
+      size_t operator()(const Key &key) const;
+   };
+
+   struct Entry {
+      Key        key;
+      LookupInfo info;
+      int        cost;
+   };
+
+   struct Shard {
+      mutable QMutex mutex;
+
+      // most recently used entry first
+      std::list<Entry> entries;
+      std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> index;
+
+      int cost = 0;
+   };
+
+   static constexpr int ShardCount = 16;
+
+   // interns a string, equal strings return the same number until the cache is cleared
+   static int atom(const QString &str);
+
+   Shard &shard(const Key &key);
+
+   Shard m_shards[ShardCount];
+   int   m_maxCost;
+
+   std::atomic<qint64> m_hits;
+   std::atomic<qint64> m_misses;
+   std::atomic<qint64> m_evictions;
+
+   static QHash<QString, int> m_atoms;
+   static QReadWriteLock      m_atomLock;
+   static int                 m_nextAtom;
+};
+
+#endif
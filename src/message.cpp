@@ -51,6 +51,7 @@ QHash<QString, Debug::DebugMask> debugMap()
    tempMap.insert("markdown",     Debug::Markdown     );
    tempMap.insert("filteroutput", Debug::FilterOutput );
    tempMap.insert("lex",          Debug::Lex          );
+   tempMap.insert("time",         Debug::Time         );
 
    return tempMap;
 }
@@ -21,6 +21,7 @@
 
 #include <parse_clang.h>
 
+#include <clangunitpool.h>
 #include <commentscan.h>
 #include <config.h>
 #include <doxy_globals.h>
@@ -85,6 +86,10 @@ class ClangParser::Private
 
    QHash<QString, uint> fileMapping;
    DetectedLang detectedLang;
+
+   // translation units parsed ahead of time on worker threads
+   ClangUnitPool *pool = nullptr;
+   ClangUnit     *unit = nullptr;
 };
 
 int ClangParser::Private::getCurrentTokenLine()
@@ -514,8 +519,62 @@ static bool documentKind(CXCursor cursor)
    return false;
 }
 
-// ** entry point
-void ClangParser::start(const QString &fileName, const QString &fileBuffer, QStringList &includeFiles, QSharedPointer<Entry> root)
+// builds the header from the clang-precompiled-header tag once, returns the name of the PCH file
+static QString buildPrecompiledHeader(const std::vector<QString> &cmdArgs)
+{
+   static const QString clangPchHeader = Config::getString("clang-precompiled-header");
+   static const QString outputDir      = Config::getString("output-dir");
+
+   if (clangPchHeader.isEmpty()) {
+      return QString();
+   }
+
+   if (! QFile::exists(clangPchHeader)) {
+      warn_uncond("Precompiled header '%s' does not exist\n", csPrintable(clangPchHeader));
+      return QString();
+   }
+
+   QString pchFile = outputDir + "/doxy_clang.pch";
+
+   std::vector<QString> argList = cmdArgs;
+   argList.push_back("c++-header");
+   argList.push_back(clangPchHeader);
+
+   std::vector<const char *> argv;
+
+   for (auto &item : argList) {
+      argv.push_back(item.constData());
+   }
+
+   CXIndex index = clang_createIndex(false, false);
+   CXTranslationUnit tu = nullptr;
+
+   CXErrorCode errorCode = clang_parseTranslationUnit2(index, nullptr, &argv[0], argv.size(), nullptr, 0,
+                  CXTranslationUnit_Incomplete | CXTranslationUnit_ForSerialization, &tu);
+
+   bool ok = false;
+
+   if (errorCode == CXError_Success) {
+      ok = (clang_saveTranslationUnit(tu, pchFile.toUtf8().constData(), clang_defaultSaveOptions(tu)) == CXSaveError_None);
+   }
+
+   if (tu) {
+      clang_disposeTranslationUnit(tu);
+   }
+
+   clang_disposeIndex(index);
+
+   if (! ok) {
+      warn_uncond("Unable to build precompiled header from '%s', parsing without it\n", csPrintable(clangPchHeader));
+      return QString();
+   }
+
+   msg("Built precompiled header %s\n", csPrintable(clangPchHeader));
+
+   return pchFile;
+}
+
+std::vector<QString> ClangParser::compileArgs(const QString &fileName)
 {
    static QStringList const includePath          = Config::getList("include-path");
    static QStringList const preDefinedMacros     = Config::getList("predefined-macros");
@@ -529,6 +588,8 @@ void ClangParser::start(const QString &fileName, const QString &fileBuffer, QStr
    // static const Qt::CaseSensitivity allowUpperCaseNames_enum = Config::getCase("case-sensitive-fname");
 
    static std::vector<QString> clangCmdArgs;
+   static QString clangPchFile;
+
    std::vector<QString> argList;
 
    static std::unique_ptr<clang::tooling::CompilationDatabase> db_json;
@@ -667,6 +728,7 @@ void ClangParser::start(const QString &fileName, const QString &fileBuffer, QStr
 
          // save for the next pass
          clangCmdArgs = argList;
+         clangPchFile = buildPrecompiledHeader(clangCmdArgs);
 
       } else {
          // just copy the first x args since they do not change
@@ -702,6 +764,12 @@ void ClangParser::start(const QString &fileName, const QString &fileBuffer, QStr
 
    switch (p->detectedLang) {
       case ClangParser::Private::Detected_Cpp:
+         if (useFallBack && ! clangPchFile.isEmpty()) {
+            // insert before the language id
+            argList.insert(argList.end() - 1, "-include-pch");
+            argList.insert(argList.end() - 1, clangPchFile);
+         }
+
          argList.push_back("c++");
          break;
 
@@ -717,80 +785,68 @@ void ClangParser::start(const QString &fileName, const QString &fileBuffer, QStr
    // file name added
    argList.push_back(fileName);
 
-   // exclude PCH files, disable diagnostics
-   p->index    = clang_createIndex(false, false);
+   return argList;
+}
 
+// ** entry point
+void ClangParser::start(const QString &fileName, const QString &fileBuffer, QStringList &includeFiles, QSharedPointer<Entry> root)
+{
    p->fileName = fileName;
    p->curLine  = 1;
    p->curToken = 0;
 
-   // provide the input and their dependencies as files in memory
-   static bool filterSourceFiles = Config::getBool("filter-source-files");
-
-   uint numUnsavedFiles = includeFiles.count() + 1;
-
-   p->numFiles = numUnsavedFiles;
-   p->sources  = new QByteArray[numUnsavedFiles];
-   p->ufs      = new CXUnsavedFile[numUnsavedFiles];
+   ClangUnit *unit = nullptr;
 
-   // load main file
-   if (fileBuffer.isEmpty()) {
-      p->sources[0]   = detab(fileToString(fileName, filterSourceFiles, true)).toUtf8();
-   } else  {
-      p->sources[0]   = fileBuffer.toUtf8();
+   if (p->pool != nullptr && root != nullptr) {
+      // parsed by a worker thread, the tokens belong to the index of that thread
+      unit = p->pool->take(fileName);
+      p->unit = unit;
    }
 
-   p->ufs[0].Filename = strdup(fileName.toUtf8().constData());
-   p->ufs[0].Contents = p->sources[0].constData();
-   p->ufs[0].Length   = p->sources[0].length();
+   if (unit == nullptr) {
+      unit = new ClangUnit;
 
-   //
-   uint i = 1;
-   for (const auto &item : includeFiles) {
-      p->fileMapping.insert(item, i);
+      unit->fileName     = fileName;
+      unit->fileBuffer   = fileBuffer;
+      unit->includeFiles = includeFiles;
+      unit->args         = compileArgs(fileName);
 
-      // load include files
-      p->sources[i]      = detab(fileToString(item, filterSourceFiles, true)).toUtf8();
-      p->ufs[i].Filename = strdup(item.toUtf8().constData());
-      p->ufs[i].Contents = p->sources[i].constData();
-      p->ufs[i].Length   = p->sources[i].length();
+      // exclude PCH files, disable diagnostics
+      p->index = clang_createIndex(false, false);
 
-      i++;
+      // libClang - used to set up the tokens for comments
+      parseClangUnit(p->index, *unit);
    }
 
-   // copy data to a usable vector for clang
-   std::vector<const char *> argv;
-   for (auto &item : argList) {
-      argv.push_back(item.constData());
-   }
+   std::vector<QString> argList = unit->args;
+   CXErrorCode errorCode        = unit->errorCode;
 
-   int argc = argList.size();
+   p->numFiles    = unit->numFiles;
+   p->sources     = unit->sources;
+   p->ufs         = unit->ufs;
+   p->fileMapping = unit->fileMapping;
+   p->tu          = unit->tu;
+   p->tokens      = unit->tokens;
+   p->cursors     = unit->cursors;
+   p->numTokens   = unit->numTokens;
 
-   // passed data - index, 0, command line args, number of args, included files
-   // num of unsaved files, clang flag indicating full preprocessing, translation unit structure
+   QStringList diagnostics = unit->diagnostics;
 
-   // libClang - used to set up the tokens for comments
-   CXErrorCode errorCode = clang_parseTranslationUnit2(p->index, nullptr, &argv[0], argc, p->ufs, numUnsavedFiles,
-                  CXTranslationUnit_DetailedPreprocessingRecord, &(p->tu) );
+   if (p->unit == nullptr) {
+      // resources are now owned by p
+      delete unit;
+   }
 
    if (p->tu) {
       // filter out any includes not found by the clang parser
       determineInputFiles(includeFiles);
 
       // show warnings the compiler found
-      uint diagCnt = clang_getNumDiagnostics(p->tu);
-
-      for (uint index = 0; index != diagCnt; ++index) {
-         CXDiagnostic diag = clang_getDiagnostic(p->tu, index);
-         CXString diagMsg  = clang_formatDiagnostic(diag, clang_defaultDiagnosticDisplayOptions());
-
-         err("%s\n", clang_getCString(diagMsg));
-
-         clang_disposeDiagnostic(diag);
-         clang_disposeString(diagMsg);
+      for (const auto &item : diagnostics) {
+         err("%s\n", csPrintable(item));
       }
 
-      if (diagCnt > 0) {
+      if (! diagnostics.isEmpty()) {
          msg("\n");
       }
    }
@@ -865,21 +921,7 @@ void ClangParser::start(const QString &fileName, const QString &fileBuffer, QStr
          }
       }
 
-      // create a source range for the file
-      QFileInfo fi(fileName);
-      CXFile f = clang_getFile(p->tu, fileName.toUtf8().constData());
-
-      CXSourceLocation fileBegin = clang_getLocationForOffset(p->tu, f, 0);
-      CXSourceLocation fileEnd   = clang_getLocationForOffset(p->tu, f, p->ufs[0].Length);
-      CXSourceRange    fileRange = clang_getRange(fileBegin, fileEnd);
-
-      // generate tokens for the tu
-      clang_tokenize(p->tu, fileRange, &p->tokens, &p->numTokens);
-
-      // generate cursors for each token
-      p->cursors = new CXCursor[p->numTokens];
-      clang_annotateTokens(p->tu, p->tokens, p->numTokens, p->cursors);
-
+      // tokens and cursors were generated by parseClangUnit()
       if (root == nullptr)  {
          // called from writeSouce() in fileDef
          return;
@@ -1271,8 +1313,64 @@ void ClangParser::start(const QString &fileName, const QString &fileBuffer, QStr
    }
 }
 
+void ClangParser::startPool(int numThreads)
+{
+   p->pool = new ClangUnitPool(numThreads);
+
+   if (p->pool->threadCount() == 0) {
+      delete p->pool;
+      p->pool = nullptr;
+   }
+}
+
+bool ClangParser::queueUnit(const QString &fileName, const QString &fileBuffer, const QStringList &includeFiles)
+{
+   if (p->pool == nullptr) {
+      return false;
+   }
+
+   ClangUnit *unit = new ClangUnit;
+
+   unit->fileName     = fileName;
+   unit->fileBuffer   = fileBuffer;
+   unit->includeFiles = includeFiles;
+   unit->args         = compileArgs(fileName);
+
+   p->pool->queue(unit);
+
+   return true;
+}
+
+void ClangParser::stopPool()
+{
+   delete p->pool;
+   p->pool = nullptr;
+}
+
 void ClangParser::finish()
 {
+   if (p->unit != nullptr) {
+      // tokens may have been replaced by switchToFile()
+      p->unit->tokens    = p->tokens;
+      p->unit->cursors   = p->cursors;
+      p->unit->numTokens = p->numTokens;
+
+      // the worker thread which parsed the unit disposes of it
+      p->pool->release(p->unit);
+
+      p->fileMapping.clear();
+      p->unit      = nullptr;
+      p->tokens    = nullptr;
+      p->numTokens = 0;
+      p->cursors   = nullptr;
+      p->ufs       = nullptr;
+      p->sources   = nullptr;
+      p->numFiles  = 0;
+      p->tu        = nullptr;
+
+      return;
+   }
+
    if (p->tu) {
 
       delete[] p->cursors;
@@ -27,6 +27,8 @@
 #include <clang-c/Index.h>
 #include <clang-c/Documentation.h>
 
+#include <vector>
+
 class CodeGenerator;
 class Entry;
 class FileDef;
@@ -47,6 +49,13 @@ class ClangParser
    // clean up, free resources used in parsing
    void finish();
 
+   // parse translation units on worker threads, the entries are still created by start()
+   void startPool(int numThreads);
+   void stopPool();
+
+   // queue a file which will later be passed to start(), returns false when there is no pool
+   bool queueUnit(const QString &fileName, const QString &fileBuffer, const QStringList &includeFiles);
+
    // looks for a symbol which should be found at line, returns a clang unique ref to the symbol
    QString lookup(uint line, const QString &symbol);
 
@@ -73,6 +82,8 @@ class ClangParser
                   uint &column, const QString &text);
 
    void determineInputFiles(QStringList &includeFiles);
+
+   std::vector<QString> compileArgs(const QString &fileName);
 };
 
 #endif
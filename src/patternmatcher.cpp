@@ -0,0 +1,216 @@
+/************************************************************************
+*
+* Copyright (c) 2014-2025 Barbara Geller & Ansel Sermersheim
+*
+* Copyright (c) 1997-2014 Dimitri van Heesch
+*
+* DoxyPress is free software. You can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* version 2 as published by the Free Software Foundation.
+*
+* DoxyPress is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+*
+* Documents produced by DoxyPress are derivative works derived from the
+* input used in their production; they are not affected by this license.
+*
+* https://www.gnu.org/licenses/
+*
+*************************************************************************/
+
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
+
+#include <patternmatcher.h>
+
+#include <config.h>
+
+// returns an empty string if the pattern can not be converted
+static QString wildcardToRegExp(const QString &pattern)
+{
+   static const QString specialChars = "\\.^$|()[]{}+*?/";
+
+   QString retval;
+
+   bool inBracket    = false;
+   bool bracketStart = false;
+
+   for (QChar c : pattern) {
+
+      if (inBracket) {
+         if (bracketStart && c == '!') {
+            retval += '^';
+
+         } else if (c == ']') {
+            retval += ']';
+            inBracket = false;
+
+         } else if (c == '\\') {
+            retval += "\\\\";
+
+         } else {
+            retval += c;
+         }
+
+         bracketStart = false;
+
+      } else if (c == '*') {
+         retval += ".*";
+
+      } else if (c == '?') {
+         retval += '.';
+
+      } else if (c == '[') {
+         retval += '[';
+
+         inBracket    = true;
+         bracketStart = true;
+
+      } else if (specialChars.contains(c)) {
+         retval += '\\';
+         retval += c;
+
+      } else {
+         retval += c;
+      }
+   }
+
+   if (inBracket) {
+      return QString();
+   }
+
+   return retval;
+}
+
+static bool hasWildcard(const QString &pattern)
+{
+   return pattern.contains('*') || pattern.contains('?') || pattern.contains('[');
+}
+
+FilePatternMatcher::FilePatternMatcher(const QStringList &patList)
+   : m_caseSensitive(Config::getCase("case-sensitive-fname")), m_isEmpty(true), m_hasRegExp(false)
+{
+   // For Windows and Mac OS X always do the case insensitive match
+#if defined(Q_OS_WIN) || defined(Q_OS_DARWIN)
+   m_caseSensitive = Qt::CaseInsensitive;
+#endif
+
+   QStringList regExpList;
+
+   for (auto pattern : patList) {
+
+      if (pattern.isEmpty()) {
+         continue;
+      }
+
+      int i = pattern.indexOf('=');
+
+      if (i != -1) {
+         pattern = pattern.left(i);   // strip off the extension
+      }
+
+      m_isEmpty = false;
+
+      if (m_caseSensitive == Qt::CaseInsensitive) {
+         pattern = pattern.toLower();
+      }
+
+      QString rest = pattern.mid(1);
+
+      if (pattern.startsWith("*.") && ! hasWildcard(rest) && ! rest.contains('/')) {
+         // plain extension pattern, stored including the dot
+         m_extensions.insert(rest);
+
+      } else if (! hasWildcard(pattern)) {
+         m_names.insert(pattern);
+
+      } else {
+         QString regExp = wildcardToRegExp(pattern);
+
+         if (regExp.isEmpty()) {
+            m_wildcards.append(QRegularExpression(pattern, QPatternOption::WildcardOption | QPatternOption::ExactMatchOption));
+         } else {
+            regExpList.append("(?:" + regExp + ")");
+         }
+      }
+   }
+
+   if (! regExpList.isEmpty()) {
+      m_regExp    = QRegularExpression("^(?:" + regExpList.join("|") + ")$");
+      m_hasRegExp = true;
+   }
+}
+
+bool FilePatternMatcher::matchName(const QString &name) const
+{
+   if (m_extensions.isEmpty()) {
+      return false;
+   }
+
+   // test each suffix which starts with a dot, "*.h" also matches a file named ".h"
+   for (auto iter = name.constBegin(); iter != name.constEnd(); ++iter) {
+      if (*iter == '.' && m_extensions.contains(QString(iter, name.constEnd()))) {
+         return true;
+      }
+   }
+
+   return false;
+}
+
+bool FilePatternMatcher::matchString(const QString &str) const
+{
+   if (m_names.contains(str)) {
+      return true;
+   }
+
+   if (m_hasRegExp && m_regExp.match(str).hasMatch()) {
+      return true;
+   }
+
+   for (const auto &regExp : m_wildcards) {
+      if (str.contains(regExp)) {
+         return true;
+      }
+   }
+
+   return false;
+}
+
+bool FilePatternMatcher::match(const QFileInfo &fi) const
+{
+   if (m_isEmpty) {
+      return false;
+   }
+
+   QString fn  = fi.fileName();
+   QString fp  = fi.filePath();
+   QString afp = fi.absoluteFilePath();
+
+   if (m_caseSensitive == Qt::CaseInsensitive) {
+      fn  = fn.toLower();
+      fp  = fp.toLower();
+      afp = afp.toLower();
+   }
+
+   // an extension pattern matches the path only when it matches the name
+   return matchName(fn) || matchString(fn) || matchString(fp) || matchString(afp);
+}
+
+QSharedPointer<const FilePatternMatcher> FilePatternMatcher::instance(const QStringList &patList)
+{
+   static QMutex mutex;
+   static QHash<QString, QSharedPointer<const FilePatternMatcher>> matchers;
+
+   QString key = patList.join("\n");
+
+   QMutexLocker lock(&mutex);
+   QSharedPointer<const FilePatternMatcher> &retval = matchers[key];
+
+   if (retval == nullptr) {
+      retval = QMakeShared<FilePatternMatcher>(patList);
+   }
+
+   return retval;
+}
@@ -0,0 +1,70 @@
+/************************************************************************
+*
+* Copyright (c) 2014-2025 Barbara Geller & Ansel Sermersheim
+*
+* Copyright (c) 1997-2014 Dimitri van Heesch
+*
+* DoxyPress is free software. You can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* version 2 as published by the Free Software Foundation.
+*
+* DoxyPress is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+*
+* Documents produced by DoxyPress are derivative works derived from the
+* input used in their production; they are not affected by this license.
+*
+* https://www.gnu.org/licenses/
+*
+*************************************************************************/
+
+#ifndef PATTERNMATCHER_H
+#define PATTERNMATCHER_H
+
+#include <QFileInfo>
+#include <QRegularExpression>
+#include <QSet>
+#include <QSharedPointer>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+/** Matches file names against a list of wildcard patterns
+ *
+ *  The list is compiled once. Patterns of the form "*.ext" are looked up by file extension,
+ *  patterns without wildcards are compared as plain strings, and all other patterns are combined
+ *  into one regular expression. A file matches when its name, path, or absolute path matches.
+ */
+class FilePatternMatcher
+{
+ public:
+   explicit FilePatternMatcher(const QStringList &patList);
+
+   bool isEmpty() const {
+      return m_isEmpty;
+   }
+
+   bool match(const QFileInfo &fi) const;
+
+   // compiled matchers are shared by all callers which use the same pattern list
+   static QSharedPointer<const FilePatternMatcher> instance(const QStringList &patList);
+
+ private:
+   bool matchName(const QString &name) const;
+   bool matchString(const QString &str) const;
+
+   Qt::CaseSensitivity m_caseSensitive;
+   bool m_isEmpty;
+
+   QSet<QString> m_extensions;
+   QSet<QString> m_names;
+
+   QRegularExpression m_regExp;
+   bool m_hasRegExp;
+
+   // patterns which could not be converted, matched one at a time
+   QVector<QRegularExpression> m_wildcards;
+};
+
+#endif
@@ -32,11 +32,13 @@
 #undef UNICODE
 #define _WIN32_DCOM
 #include <windows.h>
+#include <psapi.h>
 
 #else
 
 #include <unistd.h>
 #include <stdlib.h>
+#include <sys/resource.h>
 #include <sys/types.h>
 #include <sys/wait.h>
 #include <errno.h>
@@ -391,6 +393,72 @@ double portable_getSysElapsedTime()
    return g_sysElapsedTime;
 }
 
+double portable_getCpuTime()
+{
+   // user and system time consumed by this process, in seconds
+#ifdef HAVE_WINDOWS_H
+   FILETIME createTime;
+   FILETIME exitTime;
+   FILETIME kernelTime;
+   FILETIME userTime;
+
+   if (! GetProcessTimes(GetCurrentProcess(), &createTime, &exitTime, &kernelTime, &userTime)) {
+      return 0.0;
+   }
+
+   ULARGE_INTEGER kernel;
+   kernel.LowPart  = kernelTime.dwLowDateTime;
+   kernel.HighPart = kernelTime.dwHighDateTime;
+
+   ULARGE_INTEGER user;
+   user.LowPart  = userTime.dwLowDateTime;
+   user.HighPart = userTime.dwHighDateTime;
+
+   // units of 100 nanoseconds
+   return (kernel.QuadPart + user.QuadPart) / 1.0e7;
+
+#else
+   struct rusage usage;
+
+   if (getrusage(RUSAGE_SELF, &usage) != 0) {
+      return 0.0;
+   }
+
+   return usage.ru_utime.tv_sec + usage.ru_stime.tv_sec +
+         (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1.0e6;
+#endif
+}
+
+qint64 portable_getPeakMemory()
+{
+   // peak resident set size of this process, in bytes
+#ifdef HAVE_WINDOWS_H
+   PROCESS_MEMORY_COUNTERS counters;
+
+   if (! GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+      return 0;
+   }
+
+   return counters.PeakWorkingSetSize;
+
+#else
+   struct rusage usage;
+
+   if (getrusage(RUSAGE_SELF, &usage) != 0) {
+      return 0;
+   }
+
+#if defined(__APPLE__)
+   // reported in bytes
+   return usage.ru_maxrss;
+#else
+   // reported in kilobytes
+   return qint64(usage.ru_maxrss) * 1024;
+#endif
+
+#endif
+}
+
 void portable_sleep(int ms)
 {
 #ifdef HAVE_WINDOWS_H
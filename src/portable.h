@@ -51,6 +51,9 @@ void           portable_sysTimerStart();
 void           portable_sysTimerStop();
 double         portable_getSysElapsedTime();
 
+double         portable_getCpuTime();
+qint64         portable_getPeakMemory();
+
 Qt::CaseSensitivity  portable_fileSystemIsCaseSensitive();
 
 #endif
@@ -28,6 +28,5 @@ void initPreprocessor();
 void removePreProcessor();
 void addSearchDir(const QString &dir);
 QString preprocessFile(const QString &fileName, const QString &input);
-void preFreeScanner();
 
 #endif
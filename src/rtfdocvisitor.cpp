@@ -426,7 +426,7 @@ void RTFDocVisitor::visit(DocStyleChange *s)
    }
 }
 
-static void visitCaption(RTFDocVisitor *parent, QList<DocNode *> children)
+static void visitCaption(RTFDocVisitor *parent, DocNodeList children)
 {
    for (auto n : children) {
       n->accept(parent);
@@ -19,44 +19,282 @@
 *
 *************************************************************************/
 
+#include <QDir>
 #include <QFile>
-#include <QRegularExpression>
+#include <QFileInfo>
+#include <QMap>
+#include <QTemporaryFile>
 #include <QTextStream>
 
 #include <ctype.h>
 #include <assert.h>
 
+#include <algorithm>
+#include <numeric>
+#include <queue>
+
 #include <searchindex.h>
 
 #include <config.h>
 #include <doxy_globals.h>
 #include <doxy_build_info.h>
 #include <language.h>
+#include <lodepng.h>
 #include <message.h>
 #include <resourcemgr.h>
+#include <searchreader.h>
 #include <util.h>
 
-IndexWord::IndexWord(const QString &word) : m_word(word)
+// number of postings collected in memory before they are written to a segment file
+static const int SEARCH_RUN_SIZE = 1 << 20;
+
+static QString searchTempName()
+{
+   return QDir::tempPath() + "/doxypress_search_XXXXXX";
+}
+
+static void appendInt32(QByteArray &data, quint32 value)
+{
+   data.append(static_cast<char>(value & 0xff));
+   data.append(static_cast<char>((value >> 8) & 0xff));
+   data.append(static_cast<char>((value >> 16) & 0xff));
+   data.append(static_cast<char>((value >> 24) & 0xff));
+}
+
+static void appendVarInt(QByteArray &data, quint32 value)
 {
+   while (value >= 0x80) {
+      data.append(static_cast<char>((value & 0x7f) | 0x80));
+      value >>= 7;
+   }
+
+   data.append(static_cast<char>(value));
+}
+
+static void appendFile(QFile &to, QFile &from)
+{
+   from.seek(0);
+
+   while (! from.atEnd()) {
+      to.write(from.read(64 * 1024));
+   }
 }
 
-void IndexWord::addUrlIndex(int idx, bool hiPriority)
+static quint32 gzipCrc32(const QByteArray &data)
 {
-   QSharedPointer<URLInfo> ui = m_urls.value(idx);
+   static quint32 table[256];
+   static bool    tableReady = false;
+
+   if (! tableReady) {
+      for (quint32 n = 0; n < 256; ++n) {
+         quint32 c = n;
+
+         for (int k = 0; k < 8; ++k) {
+            c = (c & 1) ? 0xedb88320 ^ (c >> 1) : c >> 1;
+         }
+
+         table[n] = c;
+      }
+
+      tableReady = true;
+   }
+
+   quint32 crc = 0xffffffff;
 
-   if (! ui) {
-      ui = QMakeShared<URLInfo>(idx, 0);
-      m_urls.insert(idx, ui);
+   for (char c : data) {
+      crc = table[(crc ^ static_cast<quint8>(c)) & 0xff] ^ (crc >> 8);
    }
 
-   ui->freq += 2;
+   return crc ^ 0xffffffff;
+}
+
+// LodeZlib_compress writes the zlib format, the deflate stream is wrapped in a gzip header instead
+static QByteArray gzipData(const QByteArray &data)
+{
+   unsigned char *buffer = nullptr;
+   size_t size = 0;
+
+   LodeZlib_DeflateSettings settings;
+   LodeZlib_DeflateSettings_init(&settings);
+
+   if (LodeZlib_compress(&buffer, &size, reinterpret_cast<const unsigned char *>(data.constData()),
+            data.size(), &settings) != 0 || size < 6) {
+      free(buffer);
+      return QByteArray();
+   }
+
+   static const char header[] = { '\x1f', '\x8b', 8, 0, 0, 0, 0, 0, 0, '\xff' };
+
+   QByteArray retval(header, sizeof(header));
+
+   // skip the two byte zlib header and the adler32 checksum at the end
+   retval.append(reinterpret_cast<const char *>(buffer) + 2, size - 6);
+   free(buffer);
+
+   quint32 crc  = gzipCrc32(data);
+   quint32 len  = data.size();
+
+   for (int k = 0; k < 4; ++k) {
+      retval.append(static_cast<char>((crc >> (8 * k)) & 0xff));
+   }
+
+   for (int k = 0; k < 4; ++k) {
+      retval.append(static_cast<char>((len >> (8 * k)) & 0xff));
+   }
+
+   return retval;
+}
+
+// a frequency is two times the number of occurrences, bit 0 is set for high priority words
+static quint32 mergeFreq(quint32 a, quint32 b)
+{
+   return (((a >> 1) + (b >> 1)) << 1) | ((a | b) & 1);
+}
+
+static SearchIndex::PostingList mergePostings(const SearchIndex::PostingList &a, const SearchIndex::PostingList &b)
+{
+   SearchIndex::PostingList retval;
+   retval.reserve(a.size() + b.size());
+
+   auto iterA = a.begin();
+   auto iterB = b.begin();
+
+   while (iterA != a.end() || iterB != b.end()) {
+
+      if (iterB == b.end() || (iterA != a.end() && iterA->first < iterB->first)) {
+         retval.append(*iterA);
+         ++iterA;
+
+      } else if (iterA == a.end() || iterB->first < iterA->first) {
+         retval.append(*iterB);
+         ++iterB;
+
+      } else {
+         // same document in both segments
+         retval.append(qMakePair(iterA->first, mergeFreq(iterA->second, iterB->second)));
+         ++iterA;
+         ++iterB;
+      }
+   }
+
+   return retval;
+}
+
+// segment record: word length, UTF-8 word, number of postings, for each posting the url index
+// minus the previous url index and the frequency, all numbers are stored as varints
+static void appendSegmentRecord(QByteArray &data, const QByteArray &word, const SearchIndex::PostingList &postings)
+{
+   appendVarInt(data, word.size());
+   data.append(word);
+   appendVarInt(data, postings.size());
+
+   quint32 prevUrl = 0;
 
-   if (hiPriority) {
-      ui->freq |= 1;   // mark as high priority document
+   for (const auto &item : postings) {
+      appendVarInt(data, item.first - prevUrl);
+      appendVarInt(data, item.second);
+
+      prevUrl = item.first;
    }
 }
 
-SearchIndex::SearchIndex() : SearchIndex_Base(Internal), m_urlIndex(-1)
+/** Reads the records of one segment file in order
+ */
+class SearchSegmentReader
+{
+ public:
+   SearchSegmentReader(QFile *file)
+      : m_file(file)
+   {
+      m_file->seek(0);
+      next();
+   }
+
+   bool atEnd() const {
+      return m_atEnd;
+   }
+
+   const QByteArray &word() const {
+      return m_word;
+   }
+
+   const SearchIndex::PostingList &postings() const {
+      return m_postings;
+   }
+
+   void next() {
+      bool ok = true;
+      quint32 length = readVarInt(ok);
+
+      if (! ok) {
+         m_atEnd = true;
+         return;
+      }
+
+      m_word.clear();
+
+      for (quint32 i = 0; i < length && ok; ++i) {
+         m_word.append(static_cast<char>(readByte(ok)));
+      }
+
+      quint32 count   = readVarInt(ok);
+      quint32 prevUrl = 0;
+
+      m_postings.clear();
+
+      for (quint32 i = 0; i < count && ok; ++i) {
+         prevUrl     += readVarInt(ok);
+         quint32 freq = readVarInt(ok);
+
+         m_postings.append(qMakePair(prevUrl, freq));
+      }
+
+      if (! ok) {
+         err("Search index segment %s is truncated\n", csPrintable(m_file->fileName()));
+         m_atEnd = true;
+      }
+   }
+
+ private:
+   uchar readByte(bool &ok) {
+      if (m_pos >= m_buffer.size()) {
+         m_buffer = m_file->read(64 * 1024);
+         m_pos    = 0;
+
+         if (m_buffer.isEmpty()) {
+            ok = false;
+            return 0;
+         }
+      }
+
+      return static_cast<uchar>(m_buffer[m_pos++]);
+   }
+
+   quint32 readVarInt(bool &ok) {
+      quint32 retval = 0;
+
+      for (int shift = 0; shift < 32 && ok; shift += 7) {
+         uchar c = readByte(ok);
+         retval |= quint32(c & 0x7f) << shift;
+
+         if ((c & 0x80) == 0) {
+            break;
+         }
+      }
+
+      return retval;
+   }
+
+   QFile *m_file;
+   QByteArray m_buffer;
+   int m_pos    = 0;
+   bool m_atEnd = false;
+
+   QByteArray m_word;
+   SearchIndex::PostingList m_postings;
+};
+
+SearchIndex::SearchIndex() : SearchIndex_Base(Internal), m_urlIndex(-1), m_currentUrl(-1)
 {
 }
 
@@ -165,10 +403,13 @@ void SearchIndex::setCurrentDoc(QSharedPointer<Definition> ctx, const QString &a
       m_url2IdMap.insert(baseUrl, m_urlIndex);
       m_urls.insert(m_urlIndex, QSharedPointer<URL>(new URL(name, url)));
 
+      m_currentUrl = m_urlIndex;
+
    } else {
       m_urls.insert(*pIndex, QSharedPointer<URL>(new URL(name, url)));
-   }
 
+      m_currentUrl = *pIndex;
+   }
 }
 
 static int charsToIndex(const QString &word)
@@ -184,59 +425,209 @@ static int charsToIndex(const QString &word)
    return c1 * 256 + c2;
 }
 
-void SearchIndex::addWord(const QString &word, bool hiPriority, bool recurse)
+// returns the start of the next camel case part, "ValueFromList" for "getValueFromList"
+static QString::const_iterator nextCamelCasePart(QString::const_iterator first, QString::const_iterator last)
+{
+   if (first == last) {
+      return last;
+   }
+
+   for (auto iter = first + 1; iter != last; ++iter) {
+      auto next = iter + 1;
+
+      if (next == last) {
+         break;
+      }
+
+      char32_t c = (*iter).unicode();
+      char32_t n = (*next).unicode();
+
+      if ((c == '_' || c == ':' || (c >= 'a' && c <= 'z')) && n >= 'A' && n <= 'Z') {
+         return next;
+      }
+   }
+
+   return last;
+}
+
+void SearchIndex::addWord(const QString &word, bool hiPriority)
 {
    if (word.isEmpty()) {
       return;
    }
 
-   static QRegularExpression nextPart("[_a-z:][A-Z]");
+   // a document which is set again receives the words, not the last new document
+   int url = m_currentUrl;
+
+   if (url < 0) {
+      return;
+   }
+
+   addPosting(word, url, hiPriority);
 
+   // the word is also found by the part after an ignored prefix and by each camel case part
+   QString::const_iterator iter = word.begin();
+   int prefixIndex = getPrefixIndex(word);
+
+   if (prefixIndex > 0) {
+      iter = iter + prefixIndex;
+      addPosting(QString(iter, word.end()), url, hiPriority);
+   }
+
+   for (iter = nextCamelCasePart(iter, word.end()); iter != word.end(); iter = nextCamelCasePart(iter, word.end())) {
+      addPosting(QString(iter, word.end()), url, hiPriority);
+   }
+}
+
+void SearchIndex::addPosting(const QString &word, int url, bool hiPriority)
+{
    QString wStr = word.toLower();
-   QSharedPointer<IndexWord> w = m_words.value(wStr);
 
-   if (! w) {
-      int idx = charsToIndex(wStr);
+   if (charsToIndex(wStr) < 0) {
+      return;
+   }
 
-      if (idx < 0) {
-         return;
-      }
+   auto iter = m_runWords.find(wStr);
 
-      w = QMakeShared<IndexWord>(wStr);
-      m_words.insert(wStr, w);
+   if (iter == m_runWords.end()) {
+      iter = m_runWords.insert(wStr, m_runWordList.size());
+      m_runWordList.append(wStr);
    }
 
-   w->addUrlIndex(m_urlIndex, hiPriority);
+   m_run.append(Posting{iter.value(), url, hiPriority ? 3 : 2});
 
-   bool found = false;
+   if (m_run.size() >= SEARCH_RUN_SIZE) {
+      flushRun();
+   }
+}
 
-   if (! recurse) {
-      // the first time we check if we can strip the prefix
-      QRegularExpressionMatch match = nextPart.match(word);
+void SearchIndex::flushRun()
+{
+   if (m_run.isEmpty()) {
+      return;
+   }
 
-      if (match.hasMatch()) {
-         addWord(QString(match.capturedStart(), word.end()), hiPriority, true);
-         found = true;
-      }
+   // segments are ordered by the UTF-8 bytes of the words, the same order is used in the index files
+   QVector<QByteArray> words;
+   words.reserve(m_runWordList.size());
+
+   for (const auto &item : m_runWordList) {
+      words.append(item.toUtf8());
+   }
+
+   QVector<int> order(words.size());
+   std::iota(order.begin(), order.end(), 0);
+
+   std::sort(order.begin(), order.end(), [&words] (int a, int b) {
+      return words[a] < words[b];
+   });
+
+   QVector<int> rank(words.size());
+
+   for (int i = 0; i < order.size(); ++i) {
+      rank[order[i]] = i;
    }
 
-   if (! found) {
-      // no prefix stripped
-      QRegularExpressionMatch match = nextPart.match(word);
+   std::sort(m_run.begin(), m_run.end(), [&rank] (const Posting &a, const Posting &b) {
+      if (a.word != b.word) {
+         return rank[a.word] < rank[b.word];
+      }
+
+      return a.url < b.url;
+   });
 
-      if (match.hasMatch()) {
-         auto iter = match.capturedStart();
+   QSharedPointer<QTemporaryFile> file = QMakeShared<QTemporaryFile>(searchTempName());
+
+   if (! file->open()) {
+      err("Unable to create a temporary file for the search index, OS Error #: %d\n", file->error());
+
+   } else {
+      QByteArray buffer;
+      int i = 0;
 
-         if (iter != word.begin()) {
-            addWord(QString(iter + 1, word.end()), hiPriority, true);
+      while (i < m_run.size()) {
+         int word = m_run[i].word;
+         PostingList postings;
+
+         // sum the occurrences of the word in each document
+         for ( ; i < m_run.size() && m_run[i].word == word; ++i) {
+            const Posting &item = m_run[i];
+
+            if (! postings.isEmpty() && postings.last().first == quint32(item.url)) {
+               postings.last().second = mergeFreq(postings.last().second, item.freq);
+            } else {
+               postings.append(qMakePair(quint32(item.url), quint32(item.freq)));
+            }
+         }
+
+         appendSegmentRecord(buffer, words[word], postings);
+
+         if (buffer.size() >= 64 * 1024) {
+            file->write(buffer);
+            buffer.clear();
          }
       }
+
+      file->write(buffer);
+      file->flush();
+
+      m_segments.append(file);
    }
+
+   m_run.clear();
+   m_runWords.clear();
+   m_runWordList.clear();
 }
 
-void SearchIndex::addWord(const QString &word, bool hiPriority)
+void SearchIndex::mergeRuns(MergeFunction func)
 {
-   addWord(word, hiPriority, false);
+   flushRun();
+
+   QVector<QSharedPointer<SearchSegmentReader>> readers;
+
+   auto greater = [] (SearchSegmentReader *a, SearchSegmentReader *b) {
+      return b->word() < a->word();
+   };
+
+   std::priority_queue<SearchSegmentReader *, std::vector<SearchSegmentReader *>, decltype(greater)> queue(greater);
+
+   for (auto file : m_segments) {
+      QSharedPointer<SearchSegmentReader> reader = QMakeShared<SearchSegmentReader>(file.data());
+      readers.append(reader);
+
+      if (! reader->atEnd()) {
+         queue.push(reader.data());
+      }
+   }
+
+   while (! queue.empty()) {
+      SearchSegmentReader *reader = queue.top();
+      queue.pop();
+
+      QByteArray word      = reader->word();
+      PostingList postings = reader->postings();
+
+      reader->next();
+
+      if (! reader->atEnd()) {
+         queue.push(reader);
+      }
+
+      // same word in other segments
+      while (! queue.empty() && queue.top()->word() == word) {
+         reader = queue.top();
+         queue.pop();
+
+         postings = mergePostings(postings, reader->postings());
+         reader->next();
+
+         if (! reader->atEnd()) {
+            queue.push(reader);
+         }
+      }
+
+      func(word, postings);
+   }
 }
 
 static void writeInt(QFile &f, int index)
@@ -269,78 +660,202 @@ void SearchIndex::write(const QString &fileName)
 {
    static const int numIndexEntries = 256 * 256;
 
-   QMap<QString, int> wordStatOffsets;
-   QMap<QString, int> urlOffsets;
-   QMap<int, int> wordOffsets;
+   QHash<long, int> urlOffsets;
+   QMap<int, qint64> wordOffsets;
 
    QFile f(fileName);
 
-   if (f.open(QIODevice::WriteOnly)) {
-      // write header
-      f.putChar('D');
-      f.putChar('O');
-      f.putChar('X');
-      f.putChar('S');
+   if (! f.open(QIODevice::WriteOnly)) {
+      err("Unable to open file %s for writing, OS Error #: %d\n", csPrintable(fileName), f.error());
+      return;
+   }
 
-      f.seek((numIndexEntries * 4) + 4);
+   // write header
+   f.putChar('D');
+   f.putChar('O');
+   f.putChar('X');
+   f.putChar('S');
 
-      // write urls
-      for (auto item : m_urls) {
+   f.seek((numIndexEntries * 4) + 4);
 
-         // save the offset of this url
-         urlOffsets.insert(item->name, f.pos());
+   // write urls
+   QList<long> urlKeys = m_urls.keys();
+   std::sort(urlKeys.begin(), urlKeys.end());
 
-         writeString(f, item->name);
-         writeString(f, item->url);
-      }
+   for (long key : urlKeys) {
+      QSharedPointer<URL> item = m_urls.value(key);
+
+      // save the offset of this url
+      urlOffsets.insert(key, f.pos());
+
+      writeString(f, item->name);
+      writeString(f, item->url);
+   }
+
+   // word statistics are written while the segments are merged, the word lists follow the statistics
+   QTemporaryFile wordFile(searchTempName());
+
+   if (! wordFile.open()) {
+      err("Unable to create a temporary file for the search index, OS Error #: %d\n", wordFile.error());
+      return;
+   }
 
-      // write word statistics
-      for (auto item1 : m_words) {
+   int lastIndex = -1;
 
-         // save the offset of this stats entry
-         wordStatOffsets.insert(item1->word(), f.pos() );
+   mergeRuns([&] (const QByteArray &word, const PostingList &postings) {
+      int statOffset = f.pos();
 
-         int numUrls = item1->urls().count();
-         writeInt(f, numUrls);
+      writeInt(f, postings.size());
 
-         for (auto item2 : item1->urls() ) {
-            writeInt(f, urlOffsets.value(m_urls.value(item2->urlIdx)->name));
-            writeInt(f, item2->freq);
+      for (const auto &item : postings) {
+         writeInt(f, urlOffsets.value(item.first));
+         writeInt(f, item.second);
+      }
+
+      int currentIndex = charsToIndex(QString::fromUtf8(word));
+
+      if (lastIndex != currentIndex) {
+
+         if (lastIndex != -1) {
+            wordFile.putChar(0);
          }
+
+         lastIndex = currentIndex;
+         wordOffsets.insert(currentIndex, wordFile.pos());
       }
 
-      int lastIndex = -1;
+      wordFile.write(word);
+      wordFile.putChar(0);
+      writeInt(wordFile, statOffset);
+   });
 
-      for (auto item : m_words) {
-         int currentIndex = charsToIndex(item->word());
+   wordFile.putChar(0);
 
-         if (lastIndex != currentIndex) {
+   qint64 wordBase = f.pos();
+   appendFile(f, wordFile);
 
-            if (lastIndex != -1) {
-               f.putChar(0);
-            }
+   // write index
+   f.seek(4);
+
+   for (int i = 0; i < numIndexEntries; i++) {
+      auto iter = wordOffsets.find(i);
+      writeInt(f, iter == wordOffsets.end() ? 0 : wordBase + iter.value());
+   }
+}
+
+void SearchIndex::writeMapped(const QString &fileName)
+{
+   // urls are kept in memory, words and postings are streamed to temporary files
+   QByteArray urlTable;
+   QByteArray strings;
+
+   QList<long> urlKeys = m_urls.keys();
+   std::sort(urlKeys.begin(), urlKeys.end());
+
+   // postings refer to the position of the url in the url table
+   QHash<long, quint32> urlPosition;
+
+   for (long key : urlKeys) {
+      QSharedPointer<URL> item = m_urls.value(key);
 
-            lastIndex = currentIndex;
-            wordOffsets.insert(currentIndex, f.pos());
+      urlPosition.insert(key, urlPosition.size());
+
+      appendInt32(urlTable, strings.size());
+      strings.append(item->name.toUtf8());
+      strings.append('\0');
+
+      appendInt32(urlTable, strings.size());
+      strings.append(item->url.toUtf8());
+      strings.append('\0');
+   }
+
+   QTemporaryFile wordTableFile(searchTempName());
+   QTemporaryFile wordStringFile(searchTempName());
+   QTemporaryFile postingsFile(searchTempName());
+
+   if (! wordTableFile.open() || ! wordStringFile.open() || ! postingsFile.open()) {
+      err("Unable to create a temporary file for the search index\n");
+      return;
+   }
+
+   quint32 wordCount      = 0;
+   quint32 wordStringSize = 0;
+   quint32 postingsSize   = 0;
+
+   // the words arrive ordered by their UTF-8 bytes, as required by the reader
+   mergeRuns([&] (const QByteArray &word, const PostingList &postings) {
+      QByteArray record;
+      QByteArray postingData;
+
+      quint32 count        = 0;
+      quint32 totalFreq    = 0;
+      quint32 prevPosition = 0;
+
+      for (const auto &item : postings) {
+         auto iter = urlPosition.find(item.first);
+
+         if (iter == urlPosition.end()) {
+            continue;
          }
 
-         writeString(f, item->word());
-         writeInt(f, wordStatOffsets[item->word()]);
+         appendVarInt(postingData, iter.value() - prevPosition);
+         appendVarInt(postingData, item.second);
+
+         prevPosition = iter.value();
+         totalFreq   += item.second >> 1;
+         ++count;
       }
 
-      f.putChar(0);
+      appendInt32(record, strings.size() + wordStringSize);
+      appendInt32(record, postingsSize);
+      appendInt32(record, count);
+      appendInt32(record, totalFreq);
 
-      // write index
-      f.seek(4);
+      wordTableFile.write(record);
 
-      for (int i = 0; i < numIndexEntries; i++) {
-         writeInt(f, wordOffsets.value(i));
-      }
+      wordStringFile.write(word);
+      wordStringFile.putChar(0);
+
+      postingsFile.write(postingData);
+
+      wordStringSize += word.size() + 1;
+      postingsSize   += postingData.size();
+      ++wordCount;
+   });
+
+   quint32 wordTableOffset = SEARCH_INDEX_HEADER;
+   quint32 urlTableOffset  = wordTableOffset + wordCount * 16;
+   quint32 stringsOffset   = urlTableOffset + urlTable.size();
+   quint32 postingsOffset  = stringsOffset + strings.size() + wordStringSize;
+
+   QByteArray header(SEARCH_INDEX_MAGIC, 4);
+
+   appendInt32(header, SEARCH_INDEX_VERSION);
+   appendInt32(header, wordCount);
+   appendInt32(header, urlKeys.size());
+   appendInt32(header, wordTableOffset);
+   appendInt32(header, urlTableOffset);
+   appendInt32(header, stringsOffset);
+   appendInt32(header, postingsOffset);
+
+   QFile f(fileName);
+
+   if (! f.open(QIODevice::WriteOnly)) {
+      err("Unable to open file %s for writing, OS Error #: %d\n", csPrintable(fileName), f.error());
+      return;
    }
+
+   f.write(header);
+   appendFile(f, wordTableFile);
+   f.write(urlTable);
+   f.write(strings);
+   appendFile(f, wordStringFile);
+   appendFile(f, postingsFile);
 }
 
 // the following part is for writing an external search index
 struct SearchDocEntry {
+   QString key;
    QString type;
    QString name;
    QString args;
@@ -351,8 +866,31 @@ struct SearchDocEntry {
    QString normalText;
 };
 
-SearchIndex_External::SearchIndex_External() : SearchIndex_Base(External)
+// size of the blocks written to the data file, each block is a separate gzip member when compressed
+static const int SEARCH_STREAM_BLOCK = 1024 * 1024;
+
+QString searchDataFileName()
+{
+   QString retval = Config::getString("search-data-file");
+
+   if (retval.isEmpty()) {
+      retval = "searchdata.xml";
+   }
+
+   if (! QDir::isAbsolutePath(retval)) {
+      QString outputDirectory = Config::getString("output-dir");
+      retval.prepend(outputDirectory + "/");
+   }
+
+   return retval;
+}
+
+SearchIndex_External::SearchIndex_External()
+   : SearchIndex_Base(External), m_fileName(searchDataFileName())
 {
+   m_streaming = Config::getBool("search-data-streaming");
+   m_compress  = Config::getBool("search-compress-data");
+   m_shardSize = qint64(Config::getInt("search-data-shard-size")) * 1024 * 1024;
 }
 
 SearchIndex_External::~SearchIndex_External()
@@ -458,11 +996,19 @@ void SearchIndex_External::setCurrentDoc(QSharedPointer<Definition> ctx, const Q
 
    QString key = extId + ";" + url;
 
-   m_current = m_docEntries.find(key);
+   if (m_writtenKeys.contains(key)) {
+      // page of the document was finished and its record written, a second record with the
+      // same url would replace the first one, text added after the page is not indexed
+      m_current = QSharedPointer<SearchDocEntry>();
+      return;
+   }
+
+   QSharedPointer<SearchDocEntry> current = m_docEntries.find(key);
 
-   if (! m_current) {
+   if (! current) {
       QSharedPointer<SearchDocEntry> e(new SearchDocEntry);
 
+      e->key  = key;
       e->type = isSourceFile ? "source" : definitionToName(ctx);
       e->name = ctx->qualifiedName();
 
@@ -473,14 +1019,24 @@ void SearchIndex_External::setCurrentDoc(QSharedPointer<Definition> ctx, const Q
       e->extId = extId;
       e->url  = url;
 
-      m_current = e;
+      current = e;
       m_docEntries.insert(key, e);
+
+      if (m_streaming) {
+         m_pageDocs[baseName + Doxy_Globals::htmlFileExtension].append(key);
+      }
    }
+
+   m_current = current;
 }
 
 void SearchIndex_External::addWord(const QString &word, bool hiPriority)
 {
-   if (word.isEmpty() || ! isId(word[0]) || m_current == nullptr) {
+   if (word.isEmpty() || ! isId(word[0])) {
+      return;
+   }
+
+   if (m_current == nullptr) {
       return;
    }
 
@@ -493,38 +1049,159 @@ void SearchIndex_External::addWord(const QString &word, bool hiPriority)
    *pText += word;
 }
 
-void SearchIndex_External::write(const QString &fileName)
+static QString searchDocRecord(const SearchDocEntry &doc)
 {
-   QFile f(fileName);
+   QString retval;
+   QTextStream t(&retval);
+
+   t << "  <doc>" << endl;
+   t << "    <field name=\"type\">"     << doc.type << "</field>" << endl;
+   t << "    <field name=\"name\">"     << convertToXML(doc.name) << "</field>" << endl;
 
-   if (f.open(QIODevice::WriteOnly)) {
-      QTextStream t(&f);
-      t << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>" << endl;
-      t << "<add>" << endl;
+   if (! doc.args.isEmpty()) {
+      t << "    <field name=\"args\">"     << convertToXML(doc.args) << "</field>" << endl;
+   }
+   if (!doc.extId.isEmpty()) {
+      t << "    <field name=\"tag\">"      << convertToXML(doc.extId)  << "</field>" << endl;
+   }
+   t << "    <field name=\"url\">"      << convertToXML(doc.url)  << "</field>" << endl;
+   t << "    <field name=\"keywords\">" << convertToXML(doc.importantText)  << "</field>" << endl;
+   t << "    <field name=\"text\">"     << convertToXML(doc.normalText)     << "</field>" << endl;
+   t << "  </doc>" << endl;
 
-      for (auto doc : m_docEntries) {
+   t.flush();
 
-         t << "  <doc>" << endl;
-         t << "    <field name=\"type\">"     << doc->type << "</field>" << endl;
-         t << "    <field name=\"name\">"     << convertToXML(doc->name) << "</field>" << endl;
+   return retval;
+}
 
-         if (! doc->args.isEmpty()) {
-            t << "    <field name=\"args\">"     << convertToXML(doc->args) << "</field>" << endl;
-         }
-         if (!doc->extId.isEmpty()) {
-            t << "    <field name=\"tag\">"      << convertToXML(doc->extId)  << "</field>" << endl;
+void SearchIndex_External::endPage(const QString &fileName)
+{
+   if (! m_streaming) {
+      return;
+   }
+
+   // documents on this page are complete, text found later is not indexed
+   const QStringList keys = m_pageDocs.take(fileName);
+
+   for (const auto &key : keys) {
+      QSharedPointer<SearchDocEntry> doc = m_docEntries.find(key);
+
+      if (doc == nullptr) {
+         continue;
+      }
+
+      if (m_current == doc) {
+         m_current = QSharedPointer<SearchDocEntry>();
+      }
+
+      writeRecord(searchDocRecord(*doc));
+
+      m_docEntries.remove(key);
+      m_writtenKeys.insert(key);
+   }
+}
+
+void SearchIndex_External::writeRecord(const QString &text)
+{
+   if (! m_shardOpen) {
+      m_shardOpen = true;
+      m_buffer.append("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<add>\n");
+   }
+
+   m_buffer.append(text.toUtf8());
+
+   if (m_shardSize > 0 && m_shardBytes + m_buffer.size() >= m_shardSize) {
+      closeShard();
+
+   } else if (m_buffer.size() >= SEARCH_STREAM_BLOCK) {
+      flushBuffer();
+
+   }
+}
+
+void SearchIndex_External::flushBuffer()
+{
+   if (m_buffer.isEmpty()) {
+      return;
+   }
+
+   if (! m_file.isOpen()) {
+      QString fileName = m_fileName;
+
+      if (m_shardSize > 0) {
+         // searchdata.xml is written as searchdata_0.xml, searchdata_1.xml, ...
+         QFileInfo fi(m_fileName);
+         fileName = fi.path() + "/" + fi.completeBaseName() + "_" + QString::number(m_shardIndex);
+
+         if (! fi.suffix().isEmpty()) {
+            fileName += "." + fi.suffix();
          }
-         t << "    <field name=\"url\">"      << convertToXML(doc->url)  << "</field>" << endl;
-         t << "    <field name=\"keywords\">" << convertToXML(doc->importantText)  << "</field>" << endl;
-         t << "    <field name=\"text\">"     << convertToXML(doc->normalText)     << "</field>" << endl;
-         t << "  </doc>" << endl;
       }
-      t << "</add>" << endl;
 
+      if (m_compress) {
+         fileName += ".gz";
+      }
+
+      m_file.setFileName(fileName);
+
+      if (! m_file.open(QIODevice::WriteOnly)) {
+         err("Unable to open file %s for writing, OS Error #: %d\n", csPrintable(fileName), m_file.error());
+         m_buffer.clear();
+
+         return;
+      }
+   }
+
+   if (m_compress) {
+      // gzip allows several members in one file, each block is compressed separately
+      m_file.write(gzipData(m_buffer));
    } else {
-      err("Unable to open file %s for writing, OS Error #: %d\n", csPrintable(fileName), f.error());
+      m_file.write(m_buffer);
+   }
+
+   m_shardBytes += m_buffer.size();
+   m_buffer.clear();
+}
 
+void SearchIndex_External::closeShard()
+{
+   if (! m_shardOpen) {
+      return;
    }
+
+   m_buffer.append("</add>\n");
+   flushBuffer();
+
+   m_file.close();
+
+   m_shardOpen  = false;
+   m_shardBytes = 0;
+   ++m_shardIndex;
+}
+
+void SearchIndex_External::write(const QString &fileName)
+{
+   if (m_shardIndex == 0 && ! m_shardOpen) {
+      // nothing was streamed yet
+      m_fileName = fileName;
+   }
+
+   m_current = QSharedPointer<SearchDocEntry>();
+
+   // documents whose page was never finished
+   for (auto doc : m_docEntries) {
+      writeRecord(searchDocRecord(*doc));
+   }
+
+   m_docEntries.clear();
+   m_pageDocs.clear();
+
+   if (m_shardIndex == 0 && ! m_shardOpen) {
+      // no documents, write an empty data file
+      writeRecord(QString());
+   }
+
+   closeShard();
 }
 
 // the following part is for the javascript based search engine
@@ -715,6 +1392,142 @@ class SearchIndexCategoryMapping
    QString categoryLabel[NUM_SEARCH_INDICES];
 };
 
+// data files larger than this are also split into one file for each two character prefix
+static const qint64 SEARCH_SHARD_SIZE = 64 * 1024;
+
+struct SearchDataEntry {
+   QString id;
+   QString text;
+};
+
+struct SearchDataReport {
+   int     fileCount   = 0;
+   int     shardCount  = 0;
+   qint64  totalSize   = 0;
+   qint64  largestSize = 0;
+   QString largestFile;
+};
+
+// returns the number of bytes written
+static qint64 writeSearchDataFile(const QString &fileName, const QVector<SearchDataEntry> &entries, SearchDataReport &report)
+{
+   static const bool compressData = Config::getBool("search-compress-data");
+
+   // format
+   // searchData[] = array of items
+   // searchData[x][0] = id
+   // searchData[x][1] = [ name + child1 + child2 + .. ]
+   // searchData[x][1][0] = name as shown
+   // searchData[x][1][y+1] = info for child y
+   // searchData[x][1][y+1][0] = url
+   // searchData[x][1][y+1][1] = 1 => target="_parent"
+   // searchData[x][1][y+1][2] = scope
+
+   QString text = "var searchData=\n[\n";
+   bool firstEntry = true;
+
+   for (const auto &entry : entries) {
+      if (! firstEntry) {
+         text += ",\n";
+      }
+
+      firstEntry = false;
+      text += entry.text;
+   }
+
+   if (! firstEntry) {
+      text += "\n";
+   }
+
+   text += "];\n";
+
+   QByteArray data = text.toUtf8();
+   QFile f(fileName);
+
+   if (! f.open(QIODevice::WriteOnly)) {
+      err("Unable to open file %s for writing, OS Error #: %d\n", csPrintable(fileName), f.error());
+      return 0;
+   }
+
+   f.write(data);
+
+   if (compressData) {
+      QByteArray gzData = gzipData(data);
+      QFile gzFile(fileName + ".gz");
+
+      if (gzData.isEmpty() || ! gzFile.open(QIODevice::WriteOnly)) {
+         err("Unable to write compressed file %s.gz\n", csPrintable(fileName));
+
+      } else {
+         gzFile.write(gzData);
+
+      }
+   }
+
+   ++report.fileCount;
+   report.totalSize += data.size();
+
+   if (data.size() > report.largestSize) {
+      report.largestSize = data.size();
+      report.largestFile = fileName;
+   }
+
+   return data.size();
+}
+
+static void writeSearchResultsPage(const QString &fileName, const QString &baseName, const QString &shardMap)
+{
+   QFile outFile(fileName);
+
+   if (! outFile.open(QIODevice::WriteOnly)) {
+      err("Unable to open file %s for writing, OS Error #: %d\n", csPrintable(fileName), outFile.error());
+      return;
+   }
+
+   QTextStream t(&outFile);
+
+   t << "<!DOCTYPE html PUBLIC \"-//W3C//DTD XHTML 1.0 Transitional//EN\""
+     " \"http://www.w3.org/TR/xhtml1/DTD/xhtml1-transitional.dtd\">" << endl;
+   t << "<html><head><title></title>" << endl;
+   t << "<meta http-equiv=\"Content-Type\" content=\"text/xhtml;charset=UTF-8\"/>" << endl;
+   t << "<meta name=\"generator\" content=\"DoxyPress " << versionString << "\"/>" << endl;
+   t << "<link rel=\"stylesheet\" type=\"text/css\" href=\"search.css\"/>" << endl;
+   t << "<script type=\"text/javascript\" src=\"search.js\"></script>" << endl;
+   t << "<script type=\"text/javascript\"><!--" << endl;
+
+   if (shardMap.isEmpty()) {
+      t << "loadSearchData(\"" << baseName << "\", null);" << endl;
+   } else {
+      t << "loadSearchData(\"" << baseName << "\", {" << shardMap << "});" << endl;
+   }
+
+   t << "--></script>" << endl;
+   t << "</head>" << endl;
+   t << "<body class=\"SRPage\">" << endl;
+   t << "<div id=\"SRIndex\">" << endl;
+   t << "<div class=\"SRStatus\" id=\"Loading\">" << theTranslator->trLoading() << "</div>" << endl;
+   t << "<div id=\"SRResults\"></div>" << endl; // here the results will be inserted
+   t << "<script type=\"text/javascript\"><!--" << endl;
+   t << "createResults();" << endl; // this function will insert the results
+   t << "--></script>" << endl;
+
+   t << "<div class=\"SRStatus\" id=\"Searching\">"
+     << theTranslator->trSearching() << "</div>" << endl;
+
+   t << "<div class=\"SRStatus\" id=\"NoMatches\">"
+     << theTranslator->trNoMatches() << "</div>" << endl;
+
+   t << "<script type=\"text/javascript\"><!--" << endl;
+   t << "document.getElementById(\"Loading\").style.display=\"none\";" << endl;
+   t << "document.getElementById(\"NoMatches\").style.display=\"none\";" << endl;
+   t << "var searchResults = new SearchResults(\"searchResults\");" << endl;
+   t << "searchResults.Search();" << endl;
+   t << "--></script>" << endl;
+   t << "</div>" << endl; // SRIndex
+   t << "</body>" << endl;
+   t << "</html>" << endl;
+}
+
 void writeJavascriptSearchIndex()
 {
    const bool generateHtml = Config::getBool("generate-html");
@@ -856,6 +1669,7 @@ void writeJavascriptSearchIndex()
 
    // write index files
    QString searchDirName = Config::getString("html-output") + "/search";
+   SearchDataReport report;
 
    for (int i = 0; i < NUM_SEARCH_INDICES; i++) {
       // for each index
@@ -865,293 +1679,260 @@ void writeJavascriptSearchIndex()
          // for each letter
          QString baseName = QString("%1_%2").formatArg(g_searchIndexName[i]).formatArg(p);
 
-         QString fileName     = searchDirName + "/" + baseName + ".html";
-         QString dataFileName = searchDirName + "/" + baseName + ".js";
+         QVector<SearchDataEntry> entries;
 
-         QFile outFile(fileName);
-         QFile dataOutFile(dataFileName);
-
-         if (outFile.open(QIODevice::WriteOnly) && dataOutFile.open(QIODevice::WriteOnly)) {
-            {
-               QTextStream t(&outFile);
-
-               t << "<!DOCTYPE html PUBLIC \"-//W3C//DTD XHTML 1.0 Transitional//EN\""
-                 " \"http://www.w3.org/TR/xhtml1/DTD/xhtml1-transitional.dtd\">" << endl;
-               t << "<html><head><title></title>" << endl;
-               t << "<meta http-equiv=\"Content-Type\" content=\"text/xhtml;charset=UTF-8\"/>" << endl;
-               t << "<meta name=\"generator\" content=\"DoxyPress " << versionString << "\"/>" << endl;
-               t << "<link rel=\"stylesheet\" type=\"text/css\" href=\"search.css\"/>" << endl;
-               t << "<script type=\"text/javascript\" src=\"" << baseName << ".js\"></script>" << endl;
-               t << "<script type=\"text/javascript\" src=\"search.js\"></script>" << endl;
-               t << "</head>" << endl;
-               t << "<body class=\"SRPage\">" << endl;
-               t << "<div id=\"SRIndex\">" << endl;
-               t << "<div class=\"SRStatus\" id=\"Loading\">" << theTranslator->trLoading() << "</div>" << endl;
-               t << "<div id=\"SRResults\"></div>" << endl; // here the results will be inserted
-               t << "<script type=\"text/javascript\"><!--" << endl;
-               t << "createResults();" << endl; // this function will insert the results
-               t << "--></script>" << endl;
-
-               t << "<div class=\"SRStatus\" id=\"Searching\">"
-                 << theTranslator->trSearching() << "</div>" << endl;
-
-               t << "<div class=\"SRStatus\" id=\"NoMatches\">"
-                 << theTranslator->trNoMatches() << "</div>" << endl;
-
-               t << "<script type=\"text/javascript\"><!--" << endl;
-               t << "document.getElementById(\"Loading\").style.display=\"none\";" << endl;
-               t << "document.getElementById(\"NoMatches\").style.display=\"none\";" << endl;
-               t << "var searchResults = new SearchResults(\"searchResults\");" << endl;
-               t << "searchResults.Search();" << endl;
-               t << "--></script>" << endl;
-               t << "</div>" << endl; // SRIndex
-               t << "</body>" << endl;
-               t << "</html>" << endl;
-            }
+         for (auto dl : *sl) {
+            QSharedPointer<Definition> def = dl->first();
+
+            QString entryText;
+            QTextStream ti(&entryText);
+
+            QString dispName = def->localName();
+
+            if (def->definitionType() == Definition::TypeGroup) {
+               dispName = def.dynamicCast<GroupDef>()->groupTitle();
 
-            QTextStream ti(&dataOutFile);
+            } else if (def->definitionType() == Definition::TypePage) {
+               dispName = def.dynamicCast<PageDef>()->title();
 
-            ti << "var searchData=" << endl;
-            // format
-            // searchData[] = array of items
-            // searchData[x][0] = id
-            // searchData[x][1] = [ name + child1 + child2 + .. ]
-            // searchData[x][1][0] = name as shown
-            // searchData[x][1][y+1] = info for child y
-            // searchData[x][1][y+1][0] = url
-            // searchData[x][1][y+1][1] = 1 => target="_parent"
-            // searchData[x][1][y+1][2] = scope
+            }
 
-            ti << "[" << endl;
+            QString id = searchId(dispName);
 
-            bool firstEntry = true;
-            int itemCount   = 0;
+            ti << "  ['" << id << "',['"
+               << convertToXML(dispName) << "',[";
 
-            for (auto dl : *sl) {
-               QSharedPointer<Definition> def = dl->first();
+            if (dl->count() == 1) {
+               // item with a unique name
+               QSharedPointer<MemberDef> md;
 
-               if (! firstEntry) {
-                  ti << "," << endl;
+               bool isMemberDef = def->definitionType() == Definition::TypeMember;
+               if (isMemberDef) {
+                  md = def.dynamicCast<MemberDef>();
                }
-               firstEntry = false;
 
-               QString dispName = def->localName();
+               QString anchor = def->anchor();
 
-               if (def->definitionType() == Definition::TypeGroup) {
-                  dispName = def.dynamicCast<GroupDef>()->groupTitle();
+               ti << "'" << externalRef("../", def->getReference(), true)
+                  << addHtmlExtensionIfMissing(def->getOutputFileBase());
 
-               } else if (def->definitionType() == Definition::TypePage) {
-                  dispName = def.dynamicCast<PageDef>()->title();
+               if (! anchor.isEmpty()) {
+                  ti << "#" << anchor;
+               }
+               ti << "',";
 
+               static bool extLinksInWindow = Config::getBool("external-links-in-window");
+               if (! extLinksInWindow || def->getReference().isEmpty()) {
+                  ti << "1,";
+               } else {
+                  ti << "0,";
                }
 
-               ti << "  ['" << searchId(dispName) << "',['"
-                  << convertToXML(dispName) << "',[";
+               if (def->getOuterScope() != Doxy_Globals::globalScope) {
+                  ti << "'" << convertToXML(def->getOuterScope()->name()) << "'";
 
-               if (dl->count() == 1) {
-                  // item with a unique name
-                  QSharedPointer<MemberDef> md;
+               } else if (md) {
+                  QSharedPointer<FileDef> fd = md->getBodyDef();
 
-                  bool isMemberDef = def->definitionType() == Definition::TypeMember;
-                  if (isMemberDef) {
-                     md = def.dynamicCast<MemberDef>();
+                  if (fd == nullptr) {
+                     fd = md->getFileDef();
+                  }
+                  if (fd) {
+                     ti << "'" << convertToXML(fd->localName()) << "'";
                   }
 
-                  QString anchor = def->anchor();
+               } else {
+                  ti << "''";
+               }
 
-                  ti << "'" << externalRef("../", def->getReference(), true)
-                     << addHtmlExtensionIfMissing(def->getOutputFileBase());
+               ti << "]]";
 
-                  if (! anchor.isEmpty()) {
-                     ti << "#" << anchor;
-                  }
-                  ti << "',";
+            } else {
+               // multiple items with the same name
+               bool overloadedFunction = false;
+               int childCount = 0;
 
-                  static bool extLinksInWindow = Config::getBool("external-links-in-window");
-                  if (! extLinksInWindow || def->getReference().isEmpty()) {
-                     ti << "1,";
-                  } else {
-                     ti << "0,";
-                  }
+               QSharedPointer<Definition> next;
+               QSharedPointer<Definition> prevScope;
 
-                  if (def->getOuterScope() != Doxy_Globals::globalScope) {
-                     ti << "'" << convertToXML(def->getOuterScope()->name()) << "'";
+               auto nextIter = dl->begin();
 
-                  } else if (md) {
-                     QSharedPointer<FileDef> fd = md->getBodyDef();
+               for (auto item : *dl)  {
+                  QSharedPointer<Definition> scope = item->getOuterScope();
 
-                     if (fd == nullptr) {
-                        fd = md->getFileDef();
-                     }
-                     if (fd) {
-                        ti << "'" << convertToXML(fd->localName()) << "'";
-                     }
+                  if (nextIter != dl->end()) {
+                     ++nextIter;
+                  }
+
+                  if (nextIter == dl->end()) {
+                     next = QSharedPointer<Definition>();
 
                   } else {
-                     ti << "''";
+                     next = *nextIter;
+
                   }
 
-                  ti << "]]";
+                  QSharedPointer<Definition> nextScope;
+                  QSharedPointer<MemberDef>  md;
 
-               } else {
-                  // multiple items with the same name
-                  bool overloadedFunction = false;
-                  int childCount = 0;
+                  bool isMemberDef = item->definitionType() == Definition::TypeMember;
 
-                  QSharedPointer<Definition> next;
-                  QSharedPointer<Definition> prevScope;
-
-                  auto nextIter = dl->begin();
+                  if (isMemberDef) {
+                     md = item.dynamicCast<MemberDef>();
+                  }
 
-                  for (auto item : *dl)  {
-                     QSharedPointer<Definition> scope = item->getOuterScope();
+                  if (next) {
+                     nextScope = next->getOuterScope();
+                  }
 
-                     if (nextIter != dl->end()) {
-                        ++nextIter;
-                     }
+                  QString anchor = item->anchor();
 
-                     if (nextIter == dl->end()) {
-                        next = QSharedPointer<Definition>();
+                  if (childCount > 0) {
+                     ti << "],[";
+                  }
 
-                     } else {
-                        next = *nextIter;
+                  ti << "'" << externalRef("../", item->getReference(), true)
+                     << addHtmlExtensionIfMissing(item->getOutputFileBase());
 
-                     }
+                  if (! anchor.isEmpty()) {
+                     ti << "#" << anchor;
+                  }
+                  ti << "',";
 
-                     QSharedPointer<Definition> nextScope;
-                     QSharedPointer<MemberDef>  md;
+                  static bool extLinksInWindow = Config::getBool("external-links-in-window");
+                  if (! extLinksInWindow || item->getReference().isEmpty()) {
+                     ti << "1,";
+                  } else {
+                     ti << "0,";
+                  }
 
-                     bool isMemberDef = item->definitionType() == Definition::TypeMember;
+                  bool found = false;
+                  overloadedFunction = ((prevScope != nullptr && scope == prevScope) || (scope && scope == nextScope))
+                                          && md && (md->isFunction() || md->isSlot());
 
-                     if (isMemberDef) {
-                        md = item.dynamicCast<MemberDef>();
-                     }
+                  QString prefix;
 
-                     if (next) {
-                        nextScope = next->getOuterScope();
-                     }
+                  if (md) {
+                     prefix = convertToXML(md->localName());
+                  }
 
-                     QString anchor = item->anchor();
+                  if (overloadedFunction) {
+                     // overloaded member function
 
-                     if (childCount > 0) {
-                        ti << "],[";
-                     }
+                     // show argument list to disambiguate overloaded functions
+                     prefix += convertToXML(md->argsString());
 
-                     ti << "'" << externalRef("../", item->getReference(), true)
-                        << addHtmlExtensionIfMissing(item->getOutputFileBase());
 
-                     if (! anchor.isEmpty()) {
-                        ti << "#" << anchor;
-                     }
-                     ti << "',";
+                  } else if (md) {
+                     // unique member function
 
-                     static bool extLinksInWindow = Config::getBool("external-links-in-window");
-                     if (! extLinksInWindow || item->getReference().isEmpty()) {
-                        ti << "1,";
-                     } else {
-                        ti << "0,";
-                     }
+                     // only to show it is a function
+                     prefix += "()";
+                  }
 
-                     bool found = false;
-                     overloadedFunction = ((prevScope != nullptr && scope == prevScope) || (scope && scope == nextScope))
-                                             && md && (md->isFunction() || md->isSlot());
+                  QString name;
+                  if (item->definitionType() == Definition::TypeClass) {
 
-                     QString prefix;
+                     name  = convertToXML(item.dynamicCast<ClassDef>()->displayName());
+                     found = true;
 
-                     if (md) {
-                        prefix = convertToXML(md->localName());
-                     }
+                  } else if (item->definitionType() == Definition::TypeNamespace) {
 
-                     if (overloadedFunction) {
-                        // overloaded member function
+                     name  = convertToXML(item.dynamicCast<NamespaceDef>()->displayName());
+                     found = true;
 
-                        // show argument list to disambiguate overloaded functions
-                        prefix += convertToXML(md->argsString());
+                  } else if (scope == nullptr || scope == Doxy_Globals::globalScope) {
+                     // in global scope
 
+                     if (md) {
+                        QSharedPointer<FileDef> fd = md->getBodyDef();
 
-                     } else if (md) {
-                        // unique member function
+                        if (fd == nullptr) {
+                           fd = md->getFileDef();
+                        }
 
-                        // only to show it is a function
-                        prefix += "()";
+                        if (fd) {
+                           if (! prefix.isEmpty()) {
+                              prefix += ":&#160;";
+                           }
+                           name = prefix + convertToXML(fd->localName());
+                           found = true;
+                        }
                      }
 
-                     QString name;
-                     if (item->definitionType() == Definition::TypeClass) {
+                  } else if (md && (md->getClassDef() || md->getNamespaceDef())) {
+                     // member in class or namespace scope
 
-                        name  = convertToXML(item.dynamicCast<ClassDef>()->displayName());
-                        found = true;
+                     SrcLangExt lang = md->getLanguage();
+                     name = convertToXML(item->getOuterScope()->qualifiedName())
+                            + getLanguageSpecificSeparator(lang) + prefix;
 
-                     } else if (item->definitionType() == Definition::TypeNamespace) {
+                     found = true;
 
-                        name  = convertToXML(item.dynamicCast<NamespaceDef>()->displayName());
-                        found = true;
+                  } else if (scope) {
+                     // some thing else? -> show scope
 
-                     } else if (scope == nullptr || scope == Doxy_Globals::globalScope) {
-                        // in global scope
+                     name = prefix + convertToXML(scope->name());
+                     found = true;
+                  }
 
-                        if (md) {
-                           QSharedPointer<FileDef> fd = md->getBodyDef();
+                  if (! found) {
+                     // fallback
+                     name = prefix + "(" + theTranslator->trGlobalNamespace() + ")";
+                  }
 
-                           if (fd == nullptr) {
-                              fd = md->getFileDef();
-                           }
+                  ti << "'" << name << "'";
 
-                           if (fd) {
-                              if (! prefix.isEmpty()) {
-                                 prefix += ":&#160;";
-                              }
-                              name = prefix + convertToXML(fd->localName());
-                              found = true;
-                           }
-                        }
-
-                     } else if (md && (md->getClassDef() || md->getNamespaceDef())) {
-                        // member in class or namespace scope
+                  prevScope = scope;
+                  ++childCount;
 
-                        SrcLangExt lang = md->getLanguage();
-                        name = convertToXML(item->getOuterScope()->qualifiedName())
-                               + getLanguageSpecificSeparator(lang) + prefix;
+               }
 
-                        found = true;
+               ti << "]]";
+            }
 
-                     } else if (scope) {
-                        // some thing else? -> show scope
+            ti << "]";
+            ti.flush();
 
-                        name = prefix + convertToXML(scope->name());
-                        found = true;
-                     }
+            entries.append(SearchDataEntry{id, entryText});
+         }
 
-                     if (! found) {
-                        // fallback
-                        name = prefix + "(" + theTranslator->trGlobalNamespace() + ")";
-                     }
+         QString dataFileName = searchDirName + "/" + baseName + ".js";
+         qint64 dataSize = writeSearchDataFile(dataFileName, entries, report);
 
-                     ti << "'" << name << "'";
+         QString shardMap;
 
-                     prevScope = scope;
-                     ++childCount;
+         if (dataSize > SEARCH_SHARD_SIZE) {
+            // large pages are split on the first two characters of the id, the results page
+            // only loads the part which can match the search term
+            QMap<QString, QVector<SearchDataEntry>> shards;
 
-                  }
+            for (const auto &entry : entries) {
+               QString prefix = entry.id.left(2);
 
-                  ti << "]]";
+               if (prefix.length() == 2 && prefix[0].unicode() < 0x80 && prefix[1].unicode() < 0x80) {
+                  shards[prefix].append(entry);
                }
-
-               ti << "]";
-               itemCount++;
             }
 
-            if (! firstEntry) {
-               ti << endl;
-            }
+            int k = 0;
+
+            for (auto iter = shards.begin(); iter != shards.end(); ++iter) {
+               writeSearchDataFile(searchDirName + "/" + baseName + "_" + QString::number(k) + ".js", iter.value(), report);
 
-            ti << "];" << endl;
+               if (! shardMap.isEmpty()) {
+                  shardMap += ",";
+               }
 
-         } else {
-            err("Unable to open file %s for writing, OS Error #: %d\n", csPrintable(fileName), outFile.error());
+               shardMap += "\"" + iter.key() + "\":" + QString::number(k);
+               ++k;
+            }
 
+            report.shardCount += k;
          }
 
+         writeSearchResultsPage(searchDirName + "/" + baseName + ".html", baseName, shardMap);
+
          ++p;
       }
    }
@@ -1273,6 +2054,10 @@ void writeJavascriptSearchIndex()
    }
 
    Doxy_Globals::indexList.addStyleSheetFile("search/search.js");
+
+   msg("Search index: %d data files (%d prefix files), %lld KB in total, largest file %s (%lld KB)\n",
+         report.fileCount, report.shardCount, report.totalSize / 1024,
+         csPrintable(QFileInfo(report.largestFile).fileName()), report.largestSize / 1024);
 }
 
 void initSearchIndexer()
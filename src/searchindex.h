@@ -24,12 +24,20 @@
 
 #include <stringmap.h>
 
+#include <QByteArray>
+#include <QFile>
 #include <QHash>
 #include <QList>
+#include <QPair>
+#include <QSet>
+#include <QStringList>
 #include <QVector>
 
+#include <functional>
+
 class Definition;
 class MemberDef;
+class QTemporaryFile;
 
 struct SearchDocEntry;
 
@@ -43,12 +51,6 @@ struct URL {
    QString url;
 };
 
-struct URLInfo {
-   URLInfo(int idx, int f) : urlIdx(idx), freq(f) {}
-   int urlIdx;
-   int freq;
-};
-
 class SearchDefinitionList : public QList<QSharedPointer<Definition>>
 {
    public:
@@ -63,25 +65,6 @@ class SearchDefinitionList : public QList<QSharedPointer<Definition>>
       QChar m_letter;
 };
 
-class IndexWord
-{
- public:
-   IndexWord(const QString &word);
-   void addUrlIndex(int, bool);
-
-   const QHash<long, QSharedPointer<URLInfo>> &urls() const {
-      return m_urls;
-   }
-
-   QString word() const {
-      return m_word;
-   }
-
- private:
-   QString m_word;
-   QHash<long, QSharedPointer<URLInfo>> m_urls;
-};
-
 class SearchIndex_Base
 {
  public:
@@ -95,6 +78,10 @@ class SearchIndex_Base
    virtual void addWord(const QString &word, bool hiPriority) = 0;
    virtual void write(const QString &file) = 0;
 
+   // called when the html page fileName was written completely
+   virtual void endPage(const QString &) {
+   }
+
    Kind kind() const {
       return m_kind;
    }
@@ -106,6 +93,9 @@ class SearchIndex_Base
 class SearchIndex : public SearchIndex_Base
 {
  public:
+   // url index and frequency of each document containing a word, ordered by url index
+   using PostingList = QVector<QPair<quint32, quint32>>;
+
    SearchIndex();
    ~SearchIndex();
 
@@ -113,15 +103,37 @@ class SearchIndex : public SearchIndex_Base
    void addWord(const QString &word, bool hiPriority) override;
    void write(const QString &file) override;
 
+   // writes the versioned layout read by SearchIndexReader, see searchreader.h
+   void writeMapped(const QString &file);
+
  private:
-   void addWord(const QString &word, bool hiPrio, bool recurse);
+   // one occurrence of a word, occurrences in the same document are summed when the run is flushed
+   struct Posting {
+      int word;
+      int url;
+      int freq;         // 2 for each occurrence, bit 0 is set for high priority words
+   };
+
+   using MergeFunction = std::function<void (const QByteArray &, const PostingList &)>;
 
-   QMap<QString, QSharedPointer<IndexWord>> m_words;
+   void addPosting(const QString &word, int url, bool hiPriority);
+
+   // postings are collected in a run of limited size, a full run is written to a sorted
+   // segment file and the segments are merged when the index is written
+   void flushRun();
+   void mergeRuns(MergeFunction func);
+
+   QHash<QString, int> m_runWords;
+   QVector<QString>    m_runWordList;
+   QVector<Posting>    m_run;
+
+   QVector<QSharedPointer<QTemporaryFile>> m_segments;
 
    QHash<QString,int> m_url2IdMap;
    QHash<long, QSharedPointer<URL>> m_urls;
 
    int m_urlIndex;
+   int m_currentUrl;
 };
 
 class SearchIndex_External : public SearchIndex_Base
@@ -133,13 +145,37 @@ class SearchIndex_External : public SearchIndex_Base
    void setCurrentDoc(QSharedPointer<Definition> ctx, const QString &anchor, bool isSourceFile) override;
    void addWord(const QString &word, bool hiPriority) override;
    void write(const QString &file) override;
+   void endPage(const QString &fileName) override;
 
  private:
+   void writeRecord(const QString &text);
+   void flushBuffer();
+   void closeShard();
+
    StringMap<QSharedPointer<SearchDocEntry>> m_docEntries;
+
    QSharedPointer<SearchDocEntry> m_current;
 
+   // with search-data-streaming the documents of a page are written when the page is finished,
+   // m_pageDocs holds the keys of the documents of each page which was not finished yet
+   bool m_streaming;
+   QHash<QString, QStringList> m_pageDocs;
+   QSet<QString> m_writtenKeys;
+
+   QString    m_fileName;
+   QFile      m_file;
+   QByteArray m_buffer;
+
+   bool   m_compress;
+   bool   m_shardOpen  = false;
+   int    m_shardIndex = 0;
+   qint64 m_shardSize;
+   qint64 m_shardBytes = 0;
 };
 
+// name of the data file for an external search engine, relative names are placed in output-dir
+QString searchDataFileName();
+
 void writeJavascriptSearchIndex();
 
 #endif
@@ -0,0 +1,305 @@
+/************************************************************************
+*
+* Copyright (c) 2014-2025 Barbara Geller & Ansel Sermersheim
+*
+* Copyright (c) 1997-2014 Dimitri van Heesch
+*
+* DoxyPress is free software. You can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* version 2 as published by the Free Software Foundation.
+*
+* DoxyPress is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+*
+* Documents produced by DoxyPress are derivative works derived from the
+* input used in their production; they are not affected by this license.
+*
+* https://www.gnu.org/licenses/
+*
+*************************************************************************/
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QStringList>
+
+#include <searchreader.h>
+
+#include <message.h>
+
+#include <algorithm>
+#include <math.h>
+#include <string.h>
+
+SearchIndexReader::SearchIndexReader()
+{
+}
+
+SearchIndexReader::~SearchIndexReader()
+{
+   close();
+}
+
+bool SearchIndexReader::open(const QString &fileName)
+{
+   close();
+
+   m_file.setFileName(fileName);
+
+   if (! m_file.open(QIODevice::ReadOnly)) {
+      err("Unable to open search index %s, OS Error #: %d\n", csPrintable(fileName), m_file.error());
+      return false;
+   }
+
+   m_size = m_file.size();
+   m_data = m_file.map(0, m_size);
+
+   if (m_data == nullptr) {
+      m_buffer = m_file.readAll();
+      m_data   = reinterpret_cast<const uchar *>(m_buffer.constData());
+   }
+
+   if (m_size < SEARCH_INDEX_HEADER || memcmp(m_data, SEARCH_INDEX_MAGIC, 4) != 0) {
+      err("File %s is not a DoxyPress search index\n", csPrintable(fileName));
+      close();
+      return false;
+   }
+
+   if (read32(4) != SEARCH_INDEX_VERSION) {
+      err("Search index %s has version %d, version %d is required\n", csPrintable(fileName),
+            read32(4), SEARCH_INDEX_VERSION);
+      close();
+      return false;
+   }
+
+   m_wordCount = read32(8);
+   m_urlCount  = read32(12);
+   m_wordTable = read32(16);
+   m_urlTable  = read32(20);
+   m_strings   = read32(24);
+   m_postings  = read32(28);
+
+   // the string pool ends where the postings start, its last string has to be terminated
+   if (m_wordTable + qint64(m_wordCount) * 16 > m_size || m_urlTable + qint64(m_urlCount) * 8 > m_size ||
+         m_strings > m_postings || m_postings > m_size || (m_postings > m_strings && m_data[m_postings - 1] != '\0')) {
+      err("Search index %s is damaged\n", csPrintable(fileName));
+      close();
+      return false;
+   }
+
+   // words are compared with strcmp(), check every offset in the word table once
+   for (quint32 index = 0; index < m_wordCount; ++index) {
+      qint64 record = m_wordTable + qint64(index) * 16;
+
+      if (read32(record) >= m_postings - m_strings || read32(record + 4) > m_size - m_postings) {
+         err("Search index %s is damaged\n", csPrintable(fileName));
+         close();
+         return false;
+      }
+   }
+
+   return true;
+}
+
+void SearchIndexReader::close()
+{
+   if (m_file.isOpen()) {
+      if (m_buffer.isEmpty() && m_data != nullptr) {
+         m_file.unmap(const_cast<uchar *>(m_data));
+      }
+
+      m_file.close();
+   }
+
+   m_buffer.clear();
+
+   m_data = nullptr;
+   m_size = 0;
+
+   m_wordCount = 0;
+   m_urlCount  = 0;
+
+   m_wordTable = 0;
+   m_urlTable  = 0;
+   m_strings   = 0;
+   m_postings  = 0;
+}
+
+quint32 SearchIndexReader::read32(qint64 offset) const
+{
+   const uchar *p = m_data + offset;
+   return quint32(p[0]) | (quint32(p[1]) << 8) | (quint32(p[2]) << 16) | (quint32(p[3]) << 24);
+}
+
+QString SearchIndexReader::readString(quint32 offset) const
+{
+   if (offset >= m_postings - m_strings) {
+      return QString();
+   }
+
+   const char *str = reinterpret_cast<const char *>(m_data + m_strings + offset);
+   return QString::fromUtf8(str, strnlen(str, m_postings - m_strings - offset));
+}
+
+const char *SearchIndexReader::wordAt(int index) const
+{
+   // offsets of the word table were checked by open()
+   return reinterpret_cast<const char *>(m_data + m_strings + read32(m_wordTable + qint64(index) * 16));
+}
+
+int SearchIndexReader::lowerBound(const QByteArray &word) const
+{
+   int first = 0;
+   int count = m_wordCount;
+
+   while (count > 0) {
+      int step = count / 2;
+      int mid  = first + step;
+
+      if (strcmp(wordAt(mid), word.constData()) < 0) {
+         first  = mid + 1;
+         count -= step + 1;
+
+      } else {
+         count = step;
+      }
+   }
+
+   return first;
+}
+
+static quint32 readVarInt(const uchar *&p, const uchar *end)
+{
+   quint32 retval = 0;
+   int shift      = 0;
+
+   while (p < end && shift < 32) {
+      uchar c = *p++;
+      retval |= quint32(c & 0x7f) << shift;
+
+      if ((c & 0x80) == 0) {
+         break;
+      }
+
+      shift += 7;
+   }
+
+   return retval;
+}
+
+QVector<SearchIndexReader::Result> SearchIndexReader::query(const QString &text, int maxResults) const
+{
+   QVector<Result> retval;
+
+   if (m_data == nullptr) {
+      return retval;
+   }
+
+   struct DocScore {
+      double  score        = 0;
+      int     matchedWords = 0;
+      int     lastWord     = -1;
+   };
+
+   QHash<quint32, DocScore> docs;
+   const uchar *end = m_data + m_size;
+
+   QStringList words = text.toLower().split(' ');
+
+   for (int i = 0; i < words.size(); ++i) {
+      QByteArray word = words[i].toUtf8();
+
+      if (word.isEmpty()) {
+         continue;
+      }
+
+      // every word in the index starting with the search word matches, exact matches count double
+      for (quint32 index = lowerBound(word); index < m_wordCount; ++index) {
+         const char *indexWord = wordAt(index);
+
+         if (strncmp(indexWord, word.constData(), word.size()) != 0) {
+            break;
+         }
+
+         double multiplier = (indexWord[word.size()] == '\0') ? 2.0 : 1.0;
+
+         qint64 record  = m_wordTable + qint64(index) * 16;
+         quint32 count  = read32(record + 8);
+
+         // words which occur in fewer documents are more significant
+         double weight  = multiplier * log(1.0 + double(m_urlCount) / qMax<quint32>(count, 1));
+
+         const uchar *p = m_data + m_postings + read32(record + 4);
+         quint32 urlIndex = 0;
+
+         for (quint32 k = 0; k < count && p < end; ++k) {
+            urlIndex    += readVarInt(p, end);
+            quint32 freq = readVarInt(p, end);
+
+            DocScore &doc = docs[urlIndex];
+            doc.score += weight * (freq >> 1) * ((freq & 1) ? 2 : 1);
+
+            if (doc.lastWord != i) {
+               doc.lastWord = i;
+               ++doc.matchedWords;
+            }
+         }
+      }
+   }
+
+   for (auto iter = docs.begin(); iter != docs.end(); ++iter) {
+      if (iter.key() >= m_urlCount) {
+         continue;
+      }
+
+      qint64 record = m_urlTable + qint64(iter.key()) * 8;
+      retval.append(Result{readString(read32(record)), readString(read32(record + 4)),
+            iter.value().score, iter.value().matchedWords});
+   }
+
+   std::sort(retval.begin(), retval.end(), [](const Result &a, const Result &b) {
+      if (a.matchedWords != b.matchedWords) {
+         return a.matchedWords > b.matchedWords;
+      }
+
+      return a.score > b.score;
+   });
+
+   if (maxResults > 0 && retval.size() > maxResults) {
+      retval.resize(maxResults);
+   }
+
+   return retval;
+}
+
+bool searchQuery(const QString &fileName, const QString &text)
+{
+   SearchIndexReader reader;
+
+   QElapsedTimer timer;
+   timer.start();
+
+   if (! reader.open(fileName)) {
+      return false;
+   }
+
+   qint64 openTime = timer.nsecsElapsed();
+   timer.restart();
+
+   QVector<SearchIndexReader::Result> results = reader.query(text);
+   qint64 queryTime = timer.nsecsElapsed();
+
+   printf("Search index %s: %d words, %d documents, %lld KB, opened in %.3f ms\n", csPrintable(fileName),
+         reader.wordCount(), reader.urlCount(), reader.size() / 1024, openTime / 1000000.0);
+
+   printf("Query \"%s\": %d results in %.3f ms\n\n", csPrintable(text), results.size(), queryTime / 1000000.0);
+
+   int k = 1;
+
+   for (const auto &item : results) {
+      printf("%3d. %8.2f  %s  %s\n", k, item.score, csPrintable(item.name), csPrintable(item.url));
+      ++k;
+   }
+
+   return true;
+}
@@ -0,0 +1,103 @@
+/************************************************************************
+*
+* Copyright (c) 2014-2025 Barbara Geller & Ansel Sermersheim
+*
+* Copyright (c) 1997-2014 Dimitri van Heesch
+*
+* DoxyPress is free software. You can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* version 2 as published by the Free Software Foundation.
+*
+* DoxyPress is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+*
+* Documents produced by DoxyPress are derivative works derived from the
+* input used in their production; they are not affected by this license.
+*
+* https://www.gnu.org/licenses/
+*
+*************************************************************************/
+
+#ifndef SEARCHREADER_H
+#define SEARCHREADER_H
+
+#include <QByteArray>
+#include <QFile>
+#include <QString>
+#include <QVector>
+
+// layout of search.dxs, all values are 4 byte little endian unless noted otherwise
+//   header:       magic "DXSI", version, word count, url count,
+//                 offsets of the word table, url table, string pool and postings
+//   word table:   for each word sorted by its UTF-8 bytes: string offset, postings offset,
+//                 number of postings, sum of the frequencies
+//   url table:    for each document: string offset of the name, string offset of the url
+//   string pool:  zero terminated UTF-8 strings
+//   postings:     for each document containing the word, ordered by url index, two varints:
+//                 url index minus the previous url index, frequency * 2 + 1 when high priority
+
+constexpr const char   *SEARCH_INDEX_MAGIC   = "DXSI";
+constexpr const quint32 SEARCH_INDEX_VERSION = 1;
+constexpr const int     SEARCH_INDEX_HEADER  = 32;
+
+/** Answers queries directly from a search.dxs file which is mapped into memory
+ */
+class SearchIndexReader
+{
+ public:
+   struct Result {
+      QString name;
+      QString url;
+
+      double score;
+      int    matchedWords;
+   };
+
+   SearchIndexReader();
+   ~SearchIndexReader();
+
+   bool open(const QString &fileName);
+   void close();
+
+   // documents matching the most words are listed first, ties are ordered by score
+   QVector<Result> query(const QString &text, int maxResults = 20) const;
+
+   int wordCount() const {
+      return m_wordCount;
+   }
+
+   int urlCount() const {
+      return m_urlCount;
+   }
+
+   qint64 size() const {
+      return m_size;
+   }
+
+ private:
+   quint32 read32(qint64 offset) const;
+   QString readString(quint32 offset) const;
+   const char *wordAt(int index) const;
+
+   int lowerBound(const QByteArray &word) const;
+
+   QFile       m_file;
+   QByteArray  m_buffer;            // used when the file can not be mapped
+
+   const uchar *m_data = nullptr;
+   qint64       m_size = 0;
+
+   quint32 m_wordCount = 0;
+   quint32 m_urlCount  = 0;
+
+   quint32 m_wordTable = 0;
+   quint32 m_urlTable  = 0;
+   quint32 m_strings   = 0;
+   quint32 m_postings  = 0;
+};
+
+// runs one query for --search-query and displays the ranked results and the time it took
+bool searchQuery(const QString &fileName, const QString &text);
+
+#endif
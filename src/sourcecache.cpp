@@ -0,0 +1,147 @@
+/************************************************************************
+*
+* Copyright (c) 2014-2025 Barbara Geller & Ansel Sermersheim
+*
+* Copyright (c) 1997-2014 Dimitri van Heesch
+*
+* DoxyPress is free software. You can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* version 2 as published by the Free Software Foundation.
+*
+* DoxyPress is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+*
+* Documents produced by DoxyPress are derivative works derived from the
+* input used in their production; they are not affected by this license.
+*
+* https://www.gnu.org/licenses/
+*
+*************************************************************************/
+
+#include <QFile>
+#include <QMutexLocker>
+
+#include <sourcecache.h>
+
+#include <config.h>
+#include <filtercache.h>
+#include <message.h>
+#include <util.h>
+
+// maximum size of the cached files in KB
+static const int maxCacheCost = 64 * 1024;
+
+SourceFile::SourceFile(const QByteArray &buffer)
+   : m_buffer(buffer)
+{
+   // contents end at the first zero byte
+   int len = m_buffer.indexOf('\0');
+
+   if (len == -1) {
+      len = m_buffer.size();
+   }
+
+   const char *data = m_buffer.constData();
+
+   if (len > 0) {
+      m_lineOffsets.append(0);
+   }
+
+   for (int i = 0; i < len - 1; ++i) {
+      if (data[i] == '\n') {
+         m_lineOffsets.append(i + 1);
+      }
+   }
+
+   m_lineOffsets.append(len);
+}
+
+QString SourceFile::lines(int firstLine, int lastLine) const
+{
+   if (firstLine < 1) {
+      firstLine = 1;
+   }
+
+   if (lastLine > lineCount()) {
+      lastLine = lineCount();
+   }
+
+   if (firstLine > lastLine) {
+      return QString();
+   }
+
+   const int start = m_lineOffsets[firstLine - 1];
+   const int end   = m_lineOffsets[lastLine];
+
+   return QString::fromUtf8(m_buffer.constData() + start, end - start);
+}
+
+SourceCache::SourceCache()
+   : m_cache(maxCacheCost)
+{
+}
+
+SourceCache &SourceCache::instance()
+{
+   static SourceCache cache;
+   return cache;
+}
+
+QSharedPointer<const SourceFile> SourceCache::file(const QString &fileName)
+{
+   {
+      QMutexLocker lock(&m_mutex);
+      QSharedPointer<const SourceFile> *item = m_cache.object(fileName);
+
+      if (item != nullptr) {
+         return *item;
+      }
+   }
+
+   // read without holding the lock so other threads are not blocked by a slow filter
+   QByteArray buffer;
+
+   if (! readFile(fileName, buffer)) {
+      return QSharedPointer<const SourceFile>();
+   }
+
+   QSharedPointer<const SourceFile> retval = QMakeShared<SourceFile>(buffer);
+
+   QMutexLocker lock(&m_mutex);
+   m_cache.insert(fileName, new QSharedPointer<const SourceFile>(retval), retval->size() / 1024 + 1);
+
+   return retval;
+}
+
+void SourceCache::clear()
+{
+   QMutexLocker lock(&m_mutex);
+   m_cache.clear();
+}
+
+bool SourceCache::readFile(const QString &fileName, QByteArray &buffer)
+{
+   static const bool filterSourceFiles = Config::getBool("filter-source-files");
+
+   QString filter = getFileFilter(fileName, true);
+
+   if (filterSourceFiles && ! filter.isEmpty()) {
+      if (! FilterCache::instance().filter(filter, fileName, buffer)) {
+         return false;
+      }
+
+   } else {
+      QFile f(fileName);
+
+      if (! f.open(QIODevice::ReadOnly)) {
+         err("Unable to open file %s for reading, OS Error #: %d\n", csPrintable(fileName), f.error());
+         return false;
+      }
+
+      buffer = f.readAll();
+      f.close();
+   }
+
+   return true;
+}
@@ -0,0 +1,80 @@
+/************************************************************************
+*
+* Copyright (c) 2014-2025 Barbara Geller & Ansel Sermersheim
+*
+* Copyright (c) 1997-2014 Dimitri van Heesch
+*
+* DoxyPress is free software. You can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* version 2 as published by the Free Software Foundation.
+*
+* DoxyPress is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+*
+* Documents produced by DoxyPress are derivative works derived from the
+* input used in their production; they are not affected by this license.
+*
+* https://www.gnu.org/licenses/
+*
+*************************************************************************/
+
+#ifndef SOURCECACHE_H
+#define SOURCECACHE_H
+
+#include <QByteArray>
+#include <QCache>
+#include <QMutex>
+#include <QSharedPointer>
+#include <QString>
+#include <QVector>
+
+/** Contents of a source file with the offset of each line */
+class SourceFile
+{
+ public:
+   SourceFile(const QByteArray &buffer);
+
+   int lineCount() const {
+      return m_lineOffsets.size() - 1;
+   }
+
+   // returns lines firstLine to lastLine, both inclusive and starting at 1
+   QString lines(int firstLine, int lastLine) const;
+
+   int size() const {
+      return m_buffer.size();
+   }
+
+ private:
+   QByteArray   m_buffer;
+
+   // start of each line followed by the end of the contents
+   QVector<int> m_lineOffsets;
+};
+
+/** Shared cache of source files which are read for code fragments
+ *
+ *  Each file is read, and passed through the source filter when filter-source-files is set,
+ *  once while it stays in the cache. The cache is bounded by the total size of the stored files.
+ */
+class SourceCache
+{
+ public:
+   static SourceCache &instance();
+
+   // returns a null pointer if the file could not be read
+   QSharedPointer<const SourceFile> file(const QString &fileName);
+
+   void clear();
+
+ private:
+   SourceCache();
+
+   static bool readFile(const QString &fileName, QByteArray &buffer);
+
+   QCache<QString, QSharedPointer<const SourceFile>> m_cache;
+   QMutex m_mutex;
+};
+
+#endif
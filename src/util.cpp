@@ -28,10 +28,12 @@
 #include <doxy_globals.h>
 #include <entry.h>
 #include <example.h>
+#include <filtercache.h>
 #include <htmlentity.h>
 #include <image.h>
 #include <language.h>
 #include <message.h>
+#include <patternmatcher.h>
 #include <portable.h>
 #include <textdocvisitor.h>
 
@@ -40,7 +42,7 @@
 #include <QCryptographicHash>
 #include <QDateTime>
 #include <QHash>
-#include <QProcess>
+#include <QMutex>
 #include <QRegularExpression>
 #include <QStringView>
 #include <QTextCodec>
@@ -66,6 +68,7 @@ static QHash<QString, QSharedPointer<const Definition>>  s_visitedNamespaces;
 static QSet<QString> s_aliasesProcessed;
 
 static QCache<QPair<const FileNameDict *, QString>, FindFileCacheElem> s_findFileDefCache;
+static QMutex s_findFileDefMutex;      // findFileDef() is called by the preprocessor and warn() on several threads
 
 // forward declaration
 static QSharedPointer<ClassDef> getResolvedClassRec(QSharedPointer<const Definition> scope,
@@ -1402,39 +1405,36 @@ static QSharedPointer<ClassDef> getResolvedClassRec(QSharedPointer<const Definit
 
    // it is often the case that the same name is searched in the same scope
    // use a cache to collect previous results
-   // key is the concatenated scope, the name to search for and the explicit scope prefix
+   // key is the scope, the name to search for and the explicit scope prefix
 
-   QString key = scope->name( ) + "+" + name + "+" + explicitScopePart;
-
-   // if a file scope is given and contains using statements we should also use the file part
+   // if a file scope is given and contains using statements we should also use the file
    // in the key (as a class name can be in two different namespaces and a using statement in
    // a file can select one of them)
 
-   if (hasUsingStatements) {
-      key += "+" + fileScope->name();
-   }
+   LookupCache::Key key = LookupCache::key(scope, hasUsingStatements ? fileScope : QSharedPointer<const FileDef>(),
+                  name, explicitScopePart);
 
-   LookupInfo *pval = Doxy_Globals::lookupCache.object(key);
+   LookupInfo cachedInfo;
 
-   if (pval) {
+   if (Doxy_Globals::lookupCache.find(key, cachedInfo)) {
 
       if (pTemplSpec) {
-         *pTemplSpec = pval->templSpec;
+         *pTemplSpec = cachedInfo.templSpec;
       }
 
       if (pTypeDef) {
-         *pTypeDef = pval->typeDef;
+         *pTypeDef = cachedInfo.typeDef;
       }
 
       if (pResolvedType) {
-         *pResolvedType = pval->resolvedType;
+         *pResolvedType = cachedInfo.resolvedType;
       }
 
-      return pval->classDef;
+      return cachedInfo.classDef;
 
    } else {
       // not found, add a null object to avoid endless recursion
-      Doxy_Globals::lookupCache.insert(key, new LookupInfo);
+      Doxy_Globals::lookupCache.insert(key, LookupInfo());
 
    }
 
@@ -1467,21 +1467,8 @@ static QSharedPointer<ClassDef> getResolvedClassRec(QSharedPointer<const Definit
       *pResolvedType = bestResolvedType;
    }
 
-   pval = Doxy_Globals::lookupCache.object(key);
-
-   if (pval) {
-      // updates existing cache entry
-
-      pval->classDef     = bestMatch;
-      pval->typeDef      = bestTypedef;
-      pval->templSpec    = bestTemplSpec;
-      pval->resolvedType = bestResolvedType;
-
-   } else {
-      // not likely to get to this code, only way is if the cache expired an entry
-      Doxy_Globals::lookupCache.insert(key, new LookupInfo(bestMatch, bestTypedef, bestTemplSpec,
-                  bestResolvedType));
-   }
+   // replaces the null object
+   Doxy_Globals::lookupCache.insert(key, LookupInfo(bestMatch, bestTypedef, bestTemplSpec, bestResolvedType));
 
    return bestMatch;
 }
@@ -2273,40 +2260,53 @@ QString filterCRLF(const QString &buffer)
    return retval;
 }
 
-static QString getFilterFromList(const QString &name, const QStringList &filterList, bool &found)
-{
-   found = false;
+struct FilterPattern {
+   QRegularExpression regExp;
+   QString filterName;
+};
 
-   // compare the file name to the filter pattern list
-   for (auto filterStr : filterList) {
-      QString fs = filterStr;
+// compile the patterns of a filter list once
+static QVector<FilterPattern> compileFilterList(const QStringList &filterList)
+{
+   QVector<FilterPattern> retval;
 
+   for (const auto &fs : filterList) {
       int i_equals = fs.indexOf('=');
 
       if (i_equals != -1) {
          QString filterPattern = fs.left(i_equals);
-
-         QRegularExpression regExp;
+         FilterPattern item;
 
          if (portable_fileSystemIsCaseSensitive()  == Qt::CaseInsensitive) {
-            regExp = QRegularExpression(filterPattern, QPatternOption::CaseInsensitiveOption | QPatternOption::WildcardOption);
+            item.regExp = QRegularExpression(filterPattern, QPatternOption::CaseInsensitiveOption | QPatternOption::WildcardOption);
          } else {
-            regExp = QRegularExpression(filterPattern, QPatternOption::WildcardOption);
+            item.regExp = QRegularExpression(filterPattern, QPatternOption::WildcardOption);
          }
 
-         if (name.contains(regExp)) {
+         item.filterName = fs.mid(i_equals + 1);
 
-            // found a match
-            QString filterName = fs.mid(i_equals + 1);
+         if (item.filterName.indexOf(' ') != -1) {
+            // add quotes if the name has spaces
+            item.filterName = "\"" + item.filterName + "\"";
+         }
 
-            if (filterName.indexOf(' ') != -1) {
-               // add quotes if the name has spaces
-               filterName = "\"" + filterName + "\"";
-            }
+         retval.append(item);
+      }
+   }
 
-            found = true;
-            return filterName;
-         }
+   return retval;
+}
+
+static QString getFilterFromList(const QString &name, const QVector<FilterPattern> &filterList, bool &found)
+{
+   found = false;
+
+   // compare the file name to the filter pattern list
+   for (const auto &item : filterList) {
+      if (name.contains(item.regExp)) {
+         // found a match
+         found = true;
+         return item.filterName;
       }
    }
 
@@ -2324,9 +2324,9 @@ QString getFileFilter(const QString &name, bool isSourceCode)
       return QString();
    }
 
-   static const QStringList filterSrcList = Config::getList("filter-source-patterns");
-   static const QStringList filterList    = Config::getList("filter-patterns");
-   static const QString filterProgram     = Config::getString("filter-program");
+   static const QVector<FilterPattern> filterSrcList = compileFilterList(Config::getList("filter-source-patterns"));
+   static const QVector<FilterPattern> filterList    = compileFilterList(Config::getList("filter-patterns"));
+   static const QString filterProgram                = Config::getString("filter-program");
 
    QString filterName;
    bool found = false;
@@ -2360,7 +2360,8 @@ QString transcodeToQString(const QByteArray &input)
 {
    static const QString inputEncoding = Config::getString("input-encoding");
 
-   QTextCodec *tmp = QTextCodec::codecForName(inputEncoding.constData());
+   // look up the codec once, input files may be read on several threads
+   static QTextCodec *const tmp = QTextCodec::codecForName(inputEncoding.constData());
 
    if (! tmp) {
       err("Unsupported character encoding: '%s'\n", csPrintable(inputEncoding));
@@ -4498,6 +4499,7 @@ QSharedPointer<FileDef> findFileDef(const FileNameDict *fnDict, const QString &n
    // set up the key
    QPair<const FileNameDict *, QString> key(fnDict, name);
 
+   QMutexLocker lock(&s_findFileDefMutex);
    FindFileCacheElem *cachedResult = s_findFileDefCache[key];
 
    if (cachedResult) {
@@ -7780,24 +7782,10 @@ bool readInputFile(const QString &fileName, QString &fileContents, bool filter,
       }
 
    } else {
-      // filter the file
-      QString cmd = filterName + " \"" + fileName + "\"";
-
-      QProcess filterProcess;
-      filterProcess.start(cmd);
-      filterProcess.waitForFinished(-1);
-
-      if (filterProcess.exitStatus() != QProcess::NormalExit) {
-         err("Unable to execute command:  %s\n", csPrintable(cmd) );
+      // filter the file, output is reused when the same contents were already filtered
+      if (! FilterCache::instance().filter(filterName, fileName, buffer)) {
          return false;
       }
-
-      buffer = filterProcess.readAllStandardOutput();
-
-      QByteArray errorMsg = filterProcess.readAllStandardError();
-       if (! errorMsg.isEmpty()) {
-         err("Possible filter problem: %s\n", errorMsg.constData());
-      }
    }
 
    uchar tmp0 = 0;
@@ -7815,7 +7803,8 @@ bool readInputFile(const QString &fileName, QString &fileContents, bool filter,
 
    if ((tmp0 == 0xFF && tmp1 == 0xFE) || (tmp0 == 0xFE && tmp1 == 0xFF)) {
       // UCS-2 encoded file
-      fileContents = QTextCodec::codecForMib(1015)->toUnicode(buffer);
+      static QTextCodec *const ucs2Codec = QTextCodec::codecForMib(1015);
+      fileContents = ucs2Codec->toUnicode(buffer);
 
    } else if (tmp0 == 0xEF && tmp1 == 0xBB && tmp2 == 0xBF) {
       // UTF-8 encoded file, remove UTF-8 BOM, no translation needed
@@ -7865,53 +7854,7 @@ QString filterTitle(const QString &title)
 
 bool patternMatch(const QFileInfo &fi, const QStringList &patList)
 {
-   static Qt::CaseSensitivity ignoreCase = Config::getCase("case-sensitive-fname");
-
-   // For Windows and Mac OS X always do the case insensitive match
-#if defined(Q_OS_WIN) || defined(Q_OS_DARWIN)
-   ignoreCase = Qt::CaseInsensitive;
-#endif
-
-   bool found = false;
-
-   QString fn  = fi.fileName();
-   QString fp  = fi.filePath();
-   QString afp = fi.absoluteFilePath();
-
-   QRegularExpression regExp;
-
-   for (auto pattern : patList) {
-
-      if (! pattern.isEmpty()) {
-         int i = pattern.indexOf('=');
-
-         if (i != -1) {
-            pattern = pattern.left(i);   // strip off the extension
-         }
-
-         if (ignoreCase == Qt::CaseInsensitive) {
-            regExp = QRegularExpression(pattern, QPatternOption::CaseInsensitiveOption | QPatternOption::WildcardOption |
-                  QPatternOption::ExactMatchOption);
-
-         } else  {
-            regExp = QRegularExpression(pattern, QPatternOption::WildcardOption | QPatternOption::ExactMatchOption);
-
-         }
-
-         // input-patterns
-         // possible issue if the pattern has something other than a wildcard for the name
-         // found = re.indexIn(fn) != -1 || re.indexIn(fp) != -1 || re.indexIn(afp) != -1;
-
-         found = fn.contains(regExp) || fp.contains(regExp) || afp.contains(regExp);
-
-         if (found) {
-            break;
-         }
-      }
-
-   }
-
-   return found;
+   return FilePatternMatcher::instance(patList)->match(fi);
 }
 
 QString externalLinkTarget()
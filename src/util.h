@@ -247,6 +247,8 @@ bool    namespaceHasVisibleChild(QSharedPointer<NamespaceDef> nd, bool includeCl
 QString parseCommentAsText(QSharedPointer<const Definition> scope, QSharedPointer<const MemberDef> member,
                   const QString &doc, const QString &fileName, int lineNr);
 
+// may be called from the InputReader worker threads, only uses read-only configuration,
+// codecs looked up once, the FilterCache, and err()
 QString readInputFile(const QString &fileName);
 bool    readInputFile(const QString &fileName, QString &fileContents, bool filter = true, bool isSourceCode = false);
 
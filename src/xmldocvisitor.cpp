@@ -36,7 +36,7 @@
 #include <util.h>
 #include <xmlgen.h>
 
-static void visitCaption(XmlDocVisitor *parent, QList<DocNode *> children)
+static void visitCaption(XmlDocVisitor *parent, DocNodeList children)
 {
    for (const auto &n : children) {
       n->accept(parent);
@@ -44,7 +44,7 @@ static void visitCaption(XmlDocVisitor *parent, QList<DocNode *> children)
 }
 
 static void visitPreStart(QTextStream &t, const QString &cmd, const bool doCaption, XmlDocVisitor *parent,
-                  QList<DocNode *> children, const QString &name, bool writeType, DocImage::Type type,
+                  DocNodeList children, const QString &name, bool writeType, DocImage::Type type,
                   const QString &width, const QString &height, bool inlineImage = false)
 {
    t << "<" << cmd;
@@ -1767,7 +1767,7 @@ static void generateXMLForClass(QSharedPointer<ClassDef> cd, QTextStream &t_inde
    writeXMLDocBlock(t, cd->docFile(), cd->docLine(), cd, QSharedPointer<MemberDef>(), cd->documentation());
    t << "    </detaileddescription>" << endl;
 
-   DotClassGraph inheritanceGraph(cd, DotNode::Inheritance);
+   DotClassGraph inheritanceGraph(cd, DotNode::Inheritance, true);
 
    if (!inheritanceGraph.isTrivial()) {
       t << "    <inheritancegraph>" << endl;
@@ -1775,7 +1775,7 @@ static void generateXMLForClass(QSharedPointer<ClassDef> cd, QTextStream &t_inde
       t << "    </inheritancegraph>" << endl;
    }
 
-   DotClassGraph collaborationGraph(cd, DotNode::Collaboration);
+   DotClassGraph collaborationGraph(cd, DotNode::Collaboration, true);
    if (! collaborationGraph.isTrivial()) {
       t << "    <collaborationgraph>" << endl;
       collaborationGraph.writeXML(t);
@@ -2005,14 +2005,14 @@ static void generateXMLForFile(QSharedPointer<FileDef> fd, QTextStream &t_index)
       }
    }
 
-   DotInclDepGraph incDepGraph(fd, false);
+   DotInclDepGraph incDepGraph(fd, false, true);
    if (! incDepGraph.isTrivial()) {
       t << "    <incdepgraph>" << endl;
       incDepGraph.writeXML(t);
       t << "    </incdepgraph>" << endl;
    }
 
-   DotInclDepGraph invIncDepGraph(fd, true);
+   DotInclDepGraph invIncDepGraph(fd, true, true);
    if (! invIncDepGraph.isTrivial()) {
       t << "    <invincdepgraph>" << endl;
       invIncDepGraph.writeXML(t);